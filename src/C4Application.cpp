@@ -429,6 +429,14 @@ void C4Application::Execute()
 		break;
 	case C4AS_Game:
 	{
+		// Benchmark: run all frames uncapped and without graphics, then quit
+		if (Game.Benchmark && Game.IsRunning)
+		{
+			Game.Benchmark->Run();
+			Game.Benchmark.reset();
+			Quit();
+			break;
+		}
 		uint32_t iThisGameTick = timeGetTime();
 		// Game (do additional timing check)
 		if (Game.IsRunning && iRecursionCount <= 1) if (Game.GameGo || !iExtraGameTickDelay || (iThisGameTick > iLastGameTick + iExtraGameTickDelay))
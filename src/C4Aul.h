@@ -215,6 +215,13 @@ enum C4AulBCCType
 	AB_CONDN,            // conditional jump (negated, pops stack)
 	AB_FOREACH_NEXT,     // foreach: next element in array
 	AB_FOREACH_MAP_NEXT, // foreach: next key-value pair in map
+
+	// superinstructions; only created by C4AulScript::FuseInstructions, which leaves the fused
+	// successor chunks in place so that jumps into the middle of a sequence stay valid
+	AB_VARN_V_CONDN,     // AB_VARN_V, AB_CONDN
+	AB_VARN_V_INT_CMP,   // AB_VARN_V, AB_INT, comparison operator
+	AB_LOCALN_V_INT_CMP, // AB_LOCALN_V, AB_INT, comparison operator
+
 	AB_RETURN,           // return statement
 	AB_ERR,              // parse error at this position
 	AB_EOFN,             // end of function
@@ -238,10 +245,22 @@ struct C4ScriptOpDef
 };
 extern C4ScriptOpDef C4ScriptOpMap[];
 
+// operand types an operator chunk has seen so far; used by C4AulExec to pick
+// an inline fast path for monomorphic sites
+enum class C4AulTypeFeedback : std::uint8_t
+{
+	None,    // not executed yet
+	Int,     // int operands only
+	Bool,    // bool operands only
+	Object,  // object operands only
+	Generic, // mixed operand types; always use the generic conversion path from then on
+};
+
 // byte code chunk
 struct C4AulBCC
 {
 	C4AulBCCType bccType; // chunk type
+	C4AulTypeFeedback Feedback{C4AulTypeFeedback::None};
 	std::intptr_t bccX;
 	const char *SPos;
 };
@@ -267,6 +286,7 @@ struct C4AulScriptContext : public C4AulContext
 	C4ValueList NumVars;
 	C4AulBCC *CPos;
 	time_t tTime; // initialized only by profiler if active
+	std::uint64_t iFrameProfilerStart; // 0 if the frame profiler was not active when the context was pushed
 
 	size_t ParCnt() const { return Vars - Pars; }
 	void dump(StdStrBuf Dump = "");
@@ -345,7 +365,7 @@ public:
 
 	C4AulScriptFunc(C4AulScript *pOwner, const char *pName, bool bAtEnd = true) : C4AulFunc(pOwner, pName, bAtEnd),
 		idImage(C4ID_None), iImagePhase(0), Condition(nullptr), ControlMethod(C4AUL_ControlMethod_All), OwnerOverloaded(nullptr),
-		bReturnRef(false), tProfileTime(0)
+		bReturnRef(false), tProfileTime(0), FastPathHits(0), FastPathMisses(0)
 	{
 		for (int i = 0; i < C4AUL_MAX_Par; i++) ParType[i] = C4V_Any;
 	}
@@ -363,6 +383,7 @@ public:
 	StdStrBuf GetFullName(); // get a fully classified name (C4ID::Name) for debug output
 
 	time_t tProfileTime; // internally set by profiler
+	std::uint32_t FastPathHits, FastPathMisses; // operator chunks executed with/without type feedback fast path; only counted while profiling
 
 	bool HasStrictNil() const noexcept;
 
@@ -410,6 +431,7 @@ private:
 	{
 		C4AulScriptFunc *pFunc;
 		time_t tProfileTime;
+		std::uint32_t FastPathHits, FastPathMisses;
 
 		bool operator<(const Entry &e2) const { return tProfileTime < e2.tProfileTime; }
 	};
@@ -418,7 +440,7 @@ private:
 	std::vector<Entry> Times;
 
 public:
-	void CollectEntry(C4AulScriptFunc *pFunc, time_t tProfileTime);
+	void CollectEntry(C4AulScriptFunc *pFunc, time_t tProfileTime, std::uint32_t fastPathHits = 0, std::uint32_t fastPathMisses = 0);
 	void Show();
 
 	static void Abort();
@@ -479,6 +501,7 @@ protected:
 	void AppendTo(C4AulScript &Scr, bool bHighPrio); // append to given script
 	void UnLink(); // reset to unlinked state
 	virtual void AfterLink(); // called after linking is completed; presearch common funcs here & search same-named funcs
+	void FuseInstructions(); // replace common byte code sequences by superinstructions
 	virtual bool ReloadScript(const char *szPath); // reload given script
 
 	C4AulScript *FindFirstNonStrictScript(); // find first script that is not #strict
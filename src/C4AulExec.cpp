@@ -23,6 +23,7 @@
 #include <C4Object.h>
 #include <C4Config.h>
 #include <C4Game.h>
+#include <C4Profiler.h>
 #include <C4ValueHash.h>
 #include <C4Wrappers.h>
 
@@ -133,14 +134,15 @@ private:
 			throw C4AulExecError(pCurCtx->Obj, "context stack overflow!");
 		*++pCurCtx = rContext;
 		// Trace?
-		if (iTraceStart >= 0)
+		if (iTraceStart >= 0) [[unlikely]]
 		{
 			StdStrBuf Buf("T");
 			Buf.AppendChars('>', ContextStackSize() - iTraceStart);
 			pCurCtx->dump(std::move(Buf));
 		}
 		// Profiler: Safe time to measure difference afterwards
-		if (fProfiling) pCurCtx->tTime = timeGetTime();
+		if (fProfiling) [[unlikely]] pCurCtx->tTime = timeGetTime();
+		pCurCtx->iFrameProfilerStart = C4Profiler::IsEnabled() ? C4Profiler::Now() : 0;
 	}
 
 	void PopContext()
@@ -148,14 +150,16 @@ private:
 		if (pCurCtx < Contexts)
 			throw C4AulExecError(pCurCtx->Obj, "context stack underflow!");
 		// Profiler adding up times
-		if (fProfiling)
+		if (fProfiling) [[unlikely]]
 		{
 			time_t dt = timeGetTime() - pCurCtx->tTime;
 			if (dt && pCurCtx->Func)
 				pCurCtx->Func->tProfileTime += dt;
 		}
+		if (pCurCtx->iFrameProfilerStart && C4Profiler::IsEnabled()) [[unlikely]]
+			C4Profiler::Record("Script", pCurCtx->Func ? pCurCtx->Func->Name : nullptr, pCurCtx->iFrameProfilerStart, C4Profiler::Now());
 		// Trace done?
-		if (iTraceStart >= 0)
+		if (iTraceStart >= 0) [[unlikely]]
 		{
 			if (ContextStackSize() <= iTraceStart)
 			{
@@ -311,6 +315,52 @@ private:
 	}
 
 	C4AulBCC *Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4Object *pObj = nullptr, C4Def *pDef = nullptr, bool globalContext = false);
+
+	// Checks the operands of an operator chunk against the type its site has seen so far.
+	// Returns true if all operands are of the monomorphic type, in which case the caller may skip CheckOpPars.
+	// The first mismatch turns the site generic for good: a generic site does the same checks every operator
+	// did before type feedback, so it loses nothing, whereas switching it back would need a per-chunk counter
+	// and would let polymorphic sites flap between both paths.
+	bool TypeFeedback(C4AulBCC *pCPos, C4AulTypeFeedback expected, int operandCount = 2)
+	{
+		if (pCPos->Feedback != C4AulTypeFeedback::Generic)
+		{
+			C4V_Type type;
+			switch (expected)
+			{
+			case C4AulTypeFeedback::Int: type = C4V_Int; break;
+			case C4AulTypeFeedback::Bool: type = C4V_Bool; break;
+			case C4AulTypeFeedback::Object: type = C4V_C4Object; break;
+			default: assert(false); return false;
+			}
+
+			if (pCurVal->_getType() == type && (operandCount < 2 || pCurVal[-1]._getType() == type))
+			{
+				// only dirty the byte code on the first execution
+				if (pCPos->Feedback != expected) pCPos->Feedback = expected;
+				if (fProfiling) [[unlikely]] ++pCurCtx->Func->FastPathHits;
+				return true;
+			}
+			pCPos->Feedback = C4AulTypeFeedback::Generic;
+		}
+		if (fProfiling) [[unlikely]] ++pCurCtx->Func->FastPathMisses;
+		return false;
+	}
+
+	// comparison operator of a superinstruction on operands that are known to be ints
+	static bool CompareInt(C4AulBCCType op, C4ValueInt left, C4ValueInt right)
+	{
+		switch (op)
+		{
+		case AB_LessThan:         return left <  right;
+		case AB_LessThanEqual:    return left <= right;
+		case AB_GreaterThan:      return left >  right;
+		case AB_GreaterThanEqual: return left >= right;
+		default:
+			assert(false);
+			return false;
+		}
+	}
 };
 
 C4AulExec AulExec;
@@ -399,10 +449,49 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			case AB_VARN_R:
 				PushValueRef(pCurCtx->Vars[pCPos->bccX]);
 				break;
+
+			case AB_VARN_V_CONDN:
+				// AB_VARN_V and AB_CONDN without touching the value stack
+				CheckOverflow(1);
+				fJump = true;
+				pCPos += !pCurCtx->Vars[pCPos->bccX] ? 1 + pCPos[1].bccX : 2;
+				break;
+
+			case AB_VARN_V_INT_CMP:
+			{
+				const C4Value &var = pCurCtx->Vars[pCPos->bccX].GetRefVal();
+				if (var.GetType() == C4V_Int)
+				{
+					CheckOverflow(2);
+					(++pCurVal)->SetBool(CompareInt(pCPos[2].bccType, var._getInt(), static_cast<C4ValueInt>(pCPos[1].bccX)));
+					pCPos += 3;
+					fJump = true;
+					break;
+				}
+				// type miss: execute the original chunks one by one
+			}
+				[[fallthrough]];
 			case AB_VARN_V:
 				PushValue(pCurCtx->Vars[pCPos->bccX]);
 				break;
 
+			case AB_LOCALN_V_INT_CMP:
+				// fast path only for the common case that the object still has the script's def
+				if (pCurCtx->Obj && pCurCtx->Func->Owner->Def == pCurCtx->Obj->Def)
+				{
+					const C4Value &local = pCurCtx->Obj->LocalNamed.GetItem(pCPos->bccX)->GetRefVal();
+					if (local.GetType() == C4V_Int)
+					{
+						CheckOverflow(2);
+						(++pCurVal)->SetBool(CompareInt(pCPos[2].bccType, local._getInt(), static_cast<C4ValueInt>(pCPos[1].bccX)));
+						pCPos += 3;
+						fJump = true;
+						break;
+					}
+				}
+				// miss: execute the original chunks one by one
+				[[fallthrough]];
+
 			case AB_LOCALN_R: case AB_LOCALN_V:
 				if (!pCurCtx->Obj)
 					throw C4AulExecError(pCurCtx->Obj, "can't access local variables in a definition call!");
@@ -450,11 +539,11 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				pCurVal->SetInt(~pCurVal->_getInt());
 				break;
 			case AB_Not: // !
-				CheckOpPar(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Bool, 1)) CheckOpPar(pCPos->bccX);
 				pCurVal->SetBool(!pCurVal->_getRaw());
 				break;
 			case AB_Neg: // -
-				CheckOpPar<C4V_Any, false>(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Int, 1)) CheckOpPar<C4V_Any, false>(pCPos->bccX);
 				pCurVal->SetInt(-pCurVal->_getInt());
 				break;
 			// postfix (whithout second statement)
@@ -479,7 +568,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			// postfix
 			case AB_Pow: // **
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Int)) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(Pow(pPar1->_getInt(), pPar2->_getInt()));
 				PopValue();
@@ -487,7 +576,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_Div: // /
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Int)) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				if (pPar2->_getInt())
 					pPar1->SetInt(pPar1->_getInt() / pPar2->_getInt());
@@ -498,7 +587,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_Mul: // *
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Int)) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() * pPar2->_getInt());
 				PopValue();
@@ -506,7 +595,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_Mod: // %
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Int)) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				if (pPar2->_getInt())
 					pPar1->SetInt(pPar1->_getInt() % pPar2->_getInt());
@@ -517,7 +606,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_Sub: // -
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Int)) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() - pPar2->_getInt());
 				PopValue();
@@ -525,7 +614,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_Sum: // +
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Int)) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() + pPar2->_getInt());
 				PopValue();
@@ -533,7 +622,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_LeftShift: // <<
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Int)) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() << pPar2->_getInt());
 				PopValue();
@@ -541,7 +630,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_RightShift: // >>
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Int)) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() >> pPar2->_getInt());
 				PopValue();
@@ -549,7 +638,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_LessThan: // <
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Int)) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() < pPar2->_getInt());
 				PopValue();
@@ -557,7 +646,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_LessThanEqual: // <=
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Int)) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() <= pPar2->_getInt());
 				PopValue();
@@ -565,7 +654,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_GreaterThan: // >
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Int)) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() > pPar2->_getInt());
 				PopValue();
@@ -573,7 +662,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_GreaterThanEqual: // >=
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Int)) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() >= pPar2->_getInt());
 				PopValue();
@@ -646,7 +735,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_EqualIdent: // old ==
 			{
-				CheckOpPars(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Object)) CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->Equals(*pPar2, C4AulScriptStrict::NONSTRICT));
 				PopValue();
@@ -654,7 +743,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_Equal: // new ==
 			{
-				CheckOpPars(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Object)) CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->Equals(*pPar2, pCurCtx->Func->pOrgScript->Strict));
 				PopValue();
@@ -662,7 +751,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_NotEqualIdent: // old !=
 			{
-				CheckOpPars(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Object)) CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(!pPar1->Equals(*pPar2, C4AulScriptStrict::NONSTRICT));
 				PopValue();
@@ -670,7 +759,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_NotEqual: // new !=
 			{
-				CheckOpPars(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Object)) CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(!pPar1->Equals(*pPar2, pCurCtx->Func->pOrgScript->Strict));
 				PopValue();
@@ -696,7 +785,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_BitAnd: // &
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Int)) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() & pPar2->_getInt());
 				PopValue();
@@ -704,7 +793,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_BitXOr: // ^
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Int)) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() ^ pPar2->_getInt());
 				PopValue();
@@ -712,7 +801,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_BitOr: // |
 			{
-				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Int)) CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() | pPar2->_getInt());
 				PopValue();
@@ -720,7 +809,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_And: // &&
 			{
-				CheckOpPars(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Bool)) CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getRaw() && pPar2->_getRaw());
 				PopValue();
@@ -728,7 +817,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 			case AB_Or: // ||
 			{
-				CheckOpPars(pCPos->bccX);
+				if (!TypeFeedback(pCPos, C4AulTypeFeedback::Bool)) CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getRaw() || pPar2->_getRaw());
 				PopValue();
@@ -1564,14 +1653,16 @@ void C4AulProfiler::Abort()
 	AulExec.AbortProfiling();
 }
 
-void C4AulProfiler::CollectEntry(C4AulScriptFunc *pFunc, time_t tProfileTime)
+void C4AulProfiler::CollectEntry(C4AulScriptFunc *pFunc, time_t tProfileTime, std::uint32_t fastPathHits, std::uint32_t fastPathMisses)
 {
 	// zero entries are not collected to have a cleaner list
-	if (!tProfileTime) return;
+	if (!tProfileTime && !fastPathHits && !fastPathMisses) return;
 	// add entry to list
 	Entry e;
 	e.pFunc = pFunc;
 	e.tProfileTime = tProfileTime;
+	e.FastPathHits = fastPathHits;
+	e.FastPathMisses = fastPathMisses;
 	Times.push_back(e);
 }
 
@@ -1586,7 +1677,12 @@ void C4AulProfiler::Show()
 	for (EntryList::iterator i = Times.begin(); i != Times.end(); ++i)
 	{
 		Entry &e = (*i);
-		LogF("%05dms\t%s", static_cast<int>(e.tProfileTime), e.pFunc ? (e.pFunc->GetFullName().getData()) : "Direct exec");
+		const std::uint64_t operatorCount{static_cast<std::uint64_t>(e.FastPathHits) + e.FastPathMisses};
+		if (operatorCount)
+			LogF("%05dms\t%s\t(operator fast path: %u/%llu, %d%%)", static_cast<int>(e.tProfileTime), e.pFunc ? (e.pFunc->GetFullName().getData()) : "Direct exec",
+				e.FastPathHits, static_cast<unsigned long long>(operatorCount), static_cast<int>(100 * e.FastPathHits / operatorCount));
+		else
+			LogF("%05dms\t%s", static_cast<int>(e.tProfileTime), e.pFunc ? (e.pFunc->GetFullName().getData()) : "Direct exec");
 	}
 	Log("==============================");
 	// done!
@@ -1697,7 +1793,10 @@ void C4AulScript::ResetProfilerTimes()
 	C4AulScriptFunc *pSFunc;
 	for (C4AulFunc *pFn = Func0; pFn; pFn = pFn->Next)
 		if (pSFunc = pFn->SFunc())
+		{
 			pSFunc->tProfileTime = 0;
+			pSFunc->FastPathHits = pSFunc->FastPathMisses = 0;
+		}
 	// reset sub-scripts
 	for (C4AulScript *pScript = Child0; pScript; pScript = pScript->Next)
 		pScript->ResetProfilerTimes();
@@ -1709,7 +1808,7 @@ void C4AulScript::CollectProfilerTimes(class C4AulProfiler &rProfiler)
 	C4AulScriptFunc *pSFunc;
 	for (C4AulFunc *pFn = Func0; pFn; pFn = pFn->Next)
 		if (pSFunc = pFn->SFunc())
-			rProfiler.CollectEntry(pSFunc, pSFunc->tProfileTime);
+			rProfiler.CollectEntry(pSFunc, pSFunc->tProfileTime, pSFunc->FastPathHits, pSFunc->FastPathMisses);
 	// collect sub-scripts
 	for (C4AulScript *pScript = Child0; pScript; pScript = pScript->Next)
 		pScript->CollectProfilerTimes(rProfiler);
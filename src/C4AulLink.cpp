@@ -242,10 +242,50 @@ void C4AulScript::AfterLink()
 				}
 			}
 		}
+	// byte code is final now
+	FuseInstructions();
 	// call for childs
 	for (C4AulScript *s = Child0; s; s = s->Next) s->AfterLink();
 }
 
+namespace
+{
+	bool IsIntComparison(C4AulBCCType type) noexcept
+	{
+		return type == AB_LessThan || type == AB_LessThanEqual || type == AB_GreaterThan || type == AB_GreaterThanEqual;
+	}
+}
+
+void C4AulScript::FuseInstructions()
+{
+	if (!Code) return;
+	// only the first chunk of a sequence is replaced; the others stay as they are,
+	// so jumps into the sequence and the fallback paths in C4AulExec still execute them
+	for (int i = 0; i + 1 < CodeSize; ++i)
+	{
+		C4AulBCC &bcc = Code[i];
+		const C4AulBCCType next = Code[i + 1].bccType;
+		const bool isIntComparison = next == AB_INT && i + 2 < CodeSize && IsIntComparison(Code[i + 2].bccType);
+		switch (bcc.bccType)
+		{
+		case AB_VARN_V:
+			if (isIntComparison)
+				bcc.bccType = AB_VARN_V_INT_CMP;
+			else if (next == AB_CONDN)
+				bcc.bccType = AB_VARN_V_CONDN;
+			break;
+
+		case AB_LOCALN_V:
+			if (isIntComparison)
+				bcc.bccType = AB_LOCALN_V_INT_CMP;
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
 bool C4AulScript::ReloadScript(const char *szPath)
 {
 	// call for childs
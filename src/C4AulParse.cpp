@@ -903,6 +903,9 @@ static const char *GetTTName(C4AulBCCType e)
 	case AB_CONDN:            return "AB_CONDN";            // conditional jump (negated, pops stack)
 	case AB_FOREACH_NEXT:     return "AB_FOREACH_NEXT";     // foreach: next element
 	case AB_FOREACH_MAP_NEXT: return "AB_FOREACH_MAP_NEXT"; // foreach: next element
+	case AB_VARN_V_CONDN:     return "AB_VARN_V_CONDN";     // superinstruction: named var, conditional jump
+	case AB_VARN_V_INT_CMP:   return "AB_VARN_V_INT_CMP";   // superinstruction: named var, constant int, comparison
+	case AB_LOCALN_V_INT_CMP: return "AB_LOCALN_V_INT_CMP"; // superinstruction: named local, constant int, comparison
 	case AB_RETURN:           return "AB_RETURN";           // return statement
 	case AB_ERR:              return "AB_ERR";              // parse error at this position
 	case AB_EOFN:             return "AB_EOFN";             // end of function
@@ -929,6 +932,7 @@ void C4AulScript::AddBCC(C4AulBCCType eType, std::intptr_t X, const char *SPos)
 	}
 	// store chunk
 	CPos->bccType = eType;
+	CPos->Feedback = C4AulTypeFeedback::None;
 	CPos->bccX = X;
 	CPos->SPos = SPos;
 	CPos++; CodeSize++;
@@ -0,0 +1,137 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Headless simulation benchmark (/benchmark:frames) */
+
+#include <C4Include.h>
+#include <C4Benchmark.h>
+
+#include <C4FindObject.h>
+#include <C4Game.h>
+#include <C4Log.h>
+#include <C4Random.h>
+#include <C4SyncHash.h>
+
+#include <cstring>
+
+void C4Benchmark::Run()
+{
+	LogF("Benchmark: Running %d frames (%s)", static_cast<int>(iFrames), Game.Control.isReplay() ? "record playback" : "no record");
+	TimeRelight();
+	TimeFindObject();
+	const int32_t iStartFrame = Game.FrameCounter;
+	const Clock::time_point Start = Clock::now();
+	while (Game.FrameCounter - iStartFrame < iFrames && Game.IsRunning && !Game.GameOver)
+	{
+		const int32_t iFrame = Game.FrameCounter;
+		Game.Execute();
+		// no progress: control not available (e.g. end of record) or game halted
+		if (Game.FrameCounter == iFrame) break;
+	}
+	Report(Game.FrameCounter - iStartFrame, Clock::now() - Start);
+}
+
+void C4Benchmark::TimeRelight()
+{
+	// the light pass over the whole landscape done after loading it; doesn't change anything
+	constexpr int32_t iRuns = 10;
+	const Clock::time_point Start = Clock::now();
+	for (int32_t i = 0; i < iRuns; ++i)
+		if (!Game.Landscape.RelightAll())
+		{
+			Log("Benchmark: Landscape lighting not available");
+			return;
+		}
+	LogF("Benchmark: Lighting the %dx%d landscape took %.2f ms (average of %d runs)", static_cast<int>(Game.Landscape.Width), static_cast<int>(Game.Landscape.Height),
+		std::chrono::duration<double, std::milli>(Clock::now() - Start).count() / iRuns, static_cast<int>(iRuns));
+}
+
+void C4Benchmark::TimeFindObject()
+{
+	// typical per-frame searches of rule and AI scripts over the current objects; doesn't change anything
+	// the positions come from a fixed sequence instead of the game random, so runs on the same record are comparable
+	std::vector<C4ID> IDs;
+	for (std::size_t i = 0; const C4Def *pDef = Game.Defs.GetDef(i); ++i) IDs.push_back(pDef->id);
+	if (IDs.empty() || Game.Landscape.Width <= 0 || Game.Landscape.Height <= 0) return;
+	constexpr int32_t iRuns = 1000;
+	uint32_t iSeed = 1;
+	const auto Next = [&iSeed](int32_t iRange) { iSeed = iSeed * 1103515245 + 12345; return static_cast<int32_t>((iSeed >> 16) % iRange); };
+	int32_t iFound = 0;
+	const Clock::time_point Start = Clock::now();
+	for (int32_t i = 0; i < iRuns; ++i)
+	{
+		const C4ID id = IDs[i % IDs.size()];
+		const int32_t x = Next(Game.Landscape.Width), y = Next(Game.Landscape.Height);
+		// FindObjects(Find_ID(id), Find_Distance(150, x, y))
+		{
+			C4FindObject *pConds[] = { new C4FindObjectID(id), new C4FindObjectDistance(x, y, 150) };
+			C4FindObjectAnd FindObject(2, pConds, false);
+			C4Value Result = C4VArray(FindObject.FindMany(Game.Objects, Game.Objects.Sectors));
+			iFound += Result.getArray()->GetSize();
+		}
+		// FindObject2(Find_Category(C4D_Vehicle), Find_InRect(x - 100, y - 100, 200, 200))
+		{
+			C4FindObject *pConds[] = { new C4FindObjectCategory(C4D_Vehicle), new C4FindObjectInRect(C4Rect(x - 100, y - 100, 200, 200)) };
+			C4FindObjectAnd FindObject(2, pConds, false);
+			if (FindObject.Find(Game.Objects, Game.Objects.Sectors)) ++iFound;
+		}
+		// ObjectCount2(Find_ID(id), Find_InRect(x - 300, y - 300, 600, 600))
+		{
+			C4FindObject *pConds[] = { new C4FindObjectID(id), new C4FindObjectInRect(C4Rect(x - 300, y - 300, 600, 600)) };
+			C4FindObjectAnd FindObject(2, pConds, false);
+			iFound += FindObject.Count(Game.Objects, Game.Objects.Sectors);
+		}
+		// ObjectCount2(Find_ID(id)) over the whole map
+		iFound += C4FindObjectID(id).Count(Game.Objects, Game.Objects.Sectors);
+	}
+	LogF("Benchmark: %d FindObject queries took %.2f ms (%d objects of %d found)", static_cast<int>(4 * iRuns),
+		std::chrono::duration<double, std::milli>(Clock::now() - Start).count(), static_cast<int>(iFound), static_cast<int>(Game.Objects.ObjectCount()));
+}
+
+void C4Benchmark::AddTime(const char *szName, Clock::duration Time)
+{
+	// few sections only, so a linear search is fine
+	auto it = Sections.begin();
+	while (it != Sections.end() && it->szName != szName && std::strcmp(it->szName, szName)) ++it;
+	if (it == Sections.end()) it = Sections.insert(it, {szName});
+	it->Time += Time;
+	it->iCount++;
+}
+
+void C4Benchmark::Report(int32_t iFramesDone, Clock::duration TotalTime)
+{
+	using Milliseconds = std::chrono::duration<double, std::milli>;
+	const double dTotal = Milliseconds(TotalTime).count();
+	LogF("Benchmark: %d frames in %.1f ms (%.1f FPS)", static_cast<int>(iFramesDone), dTotal, dTotal > 0 ? iFramesDone * 1000.0 / dTotal : 0.0);
+	for (const Section &rSection : Sections)
+	{
+		const double dTime = Milliseconds(rSection.Time).count();
+		LogF("Benchmark:   %-20s %10.1f ms %8.3f ms/frame %5.1f%%", rSection.szName, dTime, iFramesDone ? dTime / iFramesDone : 0.0, dTotal > 0 ? dTime * 100 / dTotal : 0.0);
+	}
+	LogF("Benchmark: Frame %d, Landscape %08x Objects %08x PXS %08x MassMover %08x", static_cast<int>(Game.FrameCounter),
+		Game.Landscape.GetPixHash(), Game.Objects.GetSyncHash(), Game.PXS.GetSyncHash(), Game.MassMover.GetSyncHash());
+	LogF("Benchmark: State checksum %08x", GetStateChecksum());
+}
+
+uint32_t C4Benchmark::GetStateChecksum()
+{
+	uint32_t iHash = SyncHash(static_cast<uint32_t>(Game.FrameCounter));
+	iHash = SyncHashAdd(iHash, RandomCount);
+	iHash = SyncHashAdd(iHash, Game.Landscape.GetPixHash());
+	iHash = SyncHashAdd(iHash, Game.Objects.GetSyncHash());
+	iHash = SyncHashAdd(iHash, Game.PXS.GetSyncHash());
+	iHash = SyncHashAdd(iHash, Game.MassMover.GetSyncHash());
+	return iHash;
+}
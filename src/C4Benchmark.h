@@ -0,0 +1,78 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Headless simulation benchmark (/benchmark:frames) */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Runs a loaded game (usually a record playback) for a number of frames without
+// any frame-rate cap and reports per-subsystem timings and a final state checksum.
+// Before that, it times the landscape lighting and a fixed mix of FindObject queries.
+class C4Benchmark
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	explicit C4Benchmark(int32_t iFrames) : iFrames(iFrames) {}
+
+private:
+	struct Section
+	{
+		const char *szName;
+		Clock::duration Time{};
+		int32_t iCount{0};
+	};
+
+	int32_t iFrames;
+	std::vector<Section> Sections;
+
+public:
+	void Run(); // blocks until all frames are done, the game is over or the record ended
+	void AddTime(const char *szName, Clock::duration Time);
+
+private:
+	static void TimeRelight();
+	static void TimeFindObject();
+	void Report(int32_t iFramesDone, Clock::duration TotalTime);
+	static uint32_t GetStateChecksum();
+};
+
+// Times the enclosing scope as a benchmark section, if a benchmark is running
+class C4BenchmarkSection
+{
+public:
+	C4BenchmarkSection(C4Benchmark *pBenchmark, const char *szName)
+		: pBenchmark(pBenchmark), szName(szName)
+	{
+		if (pBenchmark) Start = C4Benchmark::Clock::now();
+	}
+
+	~C4BenchmarkSection()
+	{
+		if (pBenchmark) pBenchmark->AddTime(szName, C4Benchmark::Clock::now() - Start);
+	}
+
+	C4BenchmarkSection(const C4BenchmarkSection &) = delete;
+	C4BenchmarkSection &operator=(const C4BenchmarkSection &) = delete;
+
+private:
+	C4Benchmark *pBenchmark;
+	const char *szName;
+	C4Benchmark::Clock::time_point Start;
+};
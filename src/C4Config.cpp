@@ -99,6 +99,9 @@ void C4ConfigGeneral::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(UseWhiteIngameChat,   "UseWhiteIngameChat",   false, false, true));
 	pComp->Value(mkNamingAdapt(UseWhiteLobbyChat,    "UseWhiteLobbyChat",    false, false, true));
 	pComp->Value(mkNamingAdapt(ShowLogTimestamps,    "ShowLogTimestamps",    false, false, true));
+	pComp->Value(mkNamingAdapt(DefLoadThreads,       "DefLoadThreads",       0));
+	pComp->Value(mkNamingAdapt(MapRenderThreads,     "MapRenderThreads",     0));
+	pComp->Value(mkNamingAdapt(ReplayStateMemory,    "ReplayStateMemory",    256));
 
 #ifdef __APPLE__
 	pComp->Value(mkNamingAdapt(Preloading,           "Preloading",           false));
@@ -214,11 +217,14 @@ void C4ConfigNetwork::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(PortUDP,       "PortUDP",       C4NetStdPortUDP,       false, true));
 	pComp->Value(mkNamingAdapt(PortDiscovery, "PortDiscovery", C4NetStdPortDiscovery, false, true));
 	pComp->Value(mkNamingAdapt(PortRefServer, "PortRefServer", C4NetStdPortRefServer, false, true));
+	pComp->Value(mkNamingAdapt(UDPSegmentationOffload, "UDPSegmentationOffload", false, false, true));
 
 	pComp->Value(mkNamingAdapt(ControlMode,        "ControlMode",        0,              false, true));
 	pComp->Value(mkNamingAdapt(LocalName,          "LocalName",          "Unknown",      false, true));
 	pComp->Value(mkNamingAdapt(Nick,               "Nick",               "",             false, true));
 	pComp->Value(mkNamingAdapt(MaxLoadFileSize,    "MaxLoadFileSize", 100 * 1024 * 1024, false, true));
+	pComp->Value(mkNamingAdapt(MaxResCacheSize,    "MaxResCacheSize", 512 * 1024 * 1024, false, true));
+	pComp->Value(mkNamingAdapt(AsyncDynamic,       "AsyncDynamic",    true,              false, true));
 
 	pComp->Value(mkNamingAdapt(MasterServerSignUp,        "MasterServerSignUp",     true,   false, true));
 	pComp->Value(mkNamingAdapt(MasterReferencePeriod,     "MasterReferencePeriod",  120,    false, true));
@@ -84,6 +84,9 @@ public:
 	bool UseWhiteLobbyChat;
 	bool ShowLogTimestamps;
 	bool Preloading;
+	int32_t DefLoadThreads; // worker threads reading definitions ahead; 0 loads them serially
+	int32_t MapRenderThreads; // threads rendering dynamic maps (Landscape.txt) and zooming maps to the landscape in row bands; 0 or 1 works serially
+	int32_t ReplayStateMemory; // MB of save states a replay keeps to seek back to once /seek was used; 0 disables them
 
 public:
 	static int GetLanguageSequence(const char *strSource, char *strTarget);
@@ -188,10 +191,13 @@ public:
 	bool LeagueServerSignUp;
 	bool UseAlternateServer;
 	int32_t PortTCP, PortUDP, PortDiscovery, PortRefServer;
+	bool UDPSegmentationOffload; // let the kernel split fragmented UDP packets (Linux only)
 	int32_t ControlMode;
 	ValidatedStdStrBuf<C4InVal::VAL_NameNoEmpty> LocalName;
 	ValidatedStdStrBuf<C4InVal::VAL_NameAllowEmpty> Nick;
 	int32_t MaxLoadFileSize;
+	int32_t MaxResCacheSize; // size limit of the network resource cache in bytes; 0 disables the cache
+	bool AsyncDynamic; // pack runtime join data on a background thread instead of holding the game
 	char LastPassword[CFG_MaxString + 1];
 	char ServerAddress[CFG_MaxString + 1];
 	char AlternateServerAddress[CFG_MaxString + 1];
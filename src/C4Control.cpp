@@ -437,6 +437,10 @@ void C4ControlSyncCheck::Set()
 	ObjectCount = Game.Objects.ObjectCount();
 	ObjectEnumerationIndex = Game.ObjectEnumerationIndex;
 	SectShapeSum = Game.Objects.Sectors.getShapeSum();
+	LandscapeHash = Game.Landscape.GetPixHash();
+	ObjectHash = Game.Objects.GetSyncHash();
+	PXSHash = Game.PXS.GetSyncHash();
+	MassMoverHash = Game.MassMover.GetSyncHash();
 }
 
 int32_t C4ControlSyncCheck::GetAllCrewPosX()
@@ -471,7 +475,11 @@ void C4ControlSyncCheck::Execute() const
 		|| MassMoverIndex         != pSyncCheck->MassMoverIndex
 		|| ObjectCount            != pSyncCheck->ObjectCount
 		|| ObjectEnumerationIndex != pSyncCheck->ObjectEnumerationIndex
-		|| SectShapeSum           != pSyncCheck->SectShapeSum)
+		|| SectShapeSum           != pSyncCheck->SectShapeSum
+		|| LandscapeHash          != pSyncCheck->LandscapeHash
+		|| ObjectHash             != pSyncCheck->ObjectHash
+		|| PXSHash                != pSyncCheck->PXSHash
+		|| MassMoverHash          != pSyncCheck->MassMoverHash)
 	{
 		const char *szThis = "Client", *szOther = Game.Control.isReplay() ? "Rec " : "Host";
 		if (iByClient != Game.Control.ClientID())
@@ -482,6 +490,13 @@ void C4ControlSyncCheck::Execute() const
 		LogFatal("Network: Synchronization loss!");
 		LogFatal(FormatString("Network: %s Frm %i Ctrl %i Rnc %i Rn3 %i Cpx %i PXS %i MMi %i Obc %i Oei %i Sct %i", szThis,            Frame,           ControlTick,           RandomCount,           Random3,           AllCrewPosX,           PXSCount,           MassMoverIndex,           ObjectCount,           ObjectEnumerationIndex,           SectShapeSum).getData());
 		LogFatal(FormatString("Network: %s Frm %i Ctrl %i Rnc %i Rn3 %i Cpx %i PXS %i MMi %i Obc %i Oei %i Sct %i", szOther, SyncCheck.Frame, SyncCheck.ControlTick, SyncCheck.RandomCount, SyncCheck.Random3, SyncCheck.AllCrewPosX, SyncCheck.PXSCount, SyncCheck.MassMoverIndex, SyncCheck.ObjectCount, SyncCheck.ObjectEnumerationIndex, SyncCheck.SectShapeSum).getData());
+		LogFatal(FormatString("Network: %s state hashes Landscape %08x Objects %08x PXS %08x MassMover %08x", szThis,  LandscapeHash,           ObjectHash,           PXSHash,           MassMoverHash).getData());
+		LogFatal(FormatString("Network: %s state hashes Landscape %08x Objects %08x PXS %08x MassMover %08x", szOther, SyncCheck.LandscapeHash, SyncCheck.ObjectHash, SyncCheck.PXSHash, SyncCheck.MassMoverHash).getData());
+		// name the diverged subsystems
+		if (LandscapeHash != SyncCheck.LandscapeHash) LogFatal("Network: Landscape out of sync!");
+		if (ObjectHash    != SyncCheck.ObjectHash)    LogFatal("Network: Objects out of sync!");
+		if (PXSHash       != SyncCheck.PXSHash)       LogFatal("Network: PXS out of sync!");
+		if (MassMoverHash != SyncCheck.MassMoverHash) LogFatal("Network: Mass movers out of sync!");
 		StartSoundEffect("SyncError");
 #ifndef NDEBUG
 		// Debug safe
@@ -513,6 +528,10 @@ void C4ControlSyncCheck::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(ObjectCount),            "ObjectCount",             0));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(ObjectEnumerationIndex), "ObjectEnumerationIndex",  0));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(SectShapeSum),           "SectShapeSum",            0));
+	pComp->Value(mkNamingAdapt(LandscapeHash,                          "LandscapeHash",           0u));
+	pComp->Value(mkNamingAdapt(ObjectHash,                             "ObjectHash",              0u));
+	pComp->Value(mkNamingAdapt(PXSHash,                                "PXSHash",                 0u));
+	pComp->Value(mkNamingAdapt(MassMoverHash,                          "MassMoverHash",           0u));
 	C4ControlPacket::CompileFunc(pComp);
 }
 
@@ -208,6 +208,10 @@ protected:
 	int32_t ObjectCount;
 	int32_t ObjectEnumerationIndex;
 	int32_t SectShapeSum;
+	uint32_t LandscapeHash;
+	uint32_t ObjectHash;
+	uint32_t PXSHash;
+	uint32_t MassMoverHash;
 
 public:
 	void Set();
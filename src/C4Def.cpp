@@ -26,12 +26,19 @@
 #include <C4Log.h>
 #include <C4Components.h>
 #include <C4Config.h>
+#include <C4Thread.h>
 #include <C4ValueList.h>
 #include <C4Wrappers.h>
 #include <C4Object.h>
 #include "C4Network2Res.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
 
 // Default Action Procedures
 
@@ -205,8 +212,8 @@ void C4DefCore::Default()
 
 bool C4DefCore::Load(C4Group &hGroup)
 {
-	StdStrBuf Source;
-	if (hGroup.LoadEntryString(C4CFN_DefCore, Source))
+	C4GroupMappedStrBuf Source;
+	if (hGroup.LoadEntryStringMapped(C4CFN_DefCore, Source))
 	{
 		StdStrBuf Name = hGroup.GetFullName() + FormatString("%cDefCore.txt", DirectorySeparator);
 		if (!Compile(Source.getData(), Name.getData()))
@@ -744,8 +751,8 @@ bool C4Def::Load(C4Group &hGroup,
 bool C4Def::LoadActMap(C4Group &hGroup)
 {
 	// New format
-	StdStrBuf Data;
-	if (hGroup.LoadEntryString(C4CFN_DefActMap, Data))
+	C4GroupMappedStrBuf Data;
+	if (hGroup.LoadEntryStringMapped(C4CFN_DefActMap, Data))
 	{
 		// Get action count (hacky), create buffer
 		int actnum;
@@ -898,15 +905,100 @@ C4DefList::~C4DefList()
 	Clear();
 }
 
+// Opens definition groups on worker threads and reads their entries into memory,
+// so the main thread doesn't have to wait for the file while loading them.
+class C4DefPreloader
+{
+public:
+	C4DefPreloader(int32_t iThreadCount) : ReadAhead(2 * iThreadCount)
+	{
+		for (int32_t i = 0; i < iThreadCount; ++i)
+			Threads.emplace_back([this] { Execute(); });
+	}
+
+	~C4DefPreloader()
+	{
+		{
+			const std::lock_guard<std::mutex> lock{Mutex};
+			Stopping = true;
+		}
+		Wake.notify_all();
+		for (auto &thread : Threads) thread.join();
+	}
+
+	C4DefPreloader(const C4DefPreloader &) = delete;
+	C4DefPreloader &operator=(const C4DefPreloader &) = delete;
+
+protected:
+	std::mutex Mutex;
+	std::condition_variable Wake;
+	std::deque<std::packaged_task<std::unique_ptr<C4Group>()>> Tasks;
+	bool Stopping{false};
+	std::vector<std::thread> Threads;
+
+public:
+	// Preloaded groups stay open and in memory until they are loaded, so each group only reads this far ahead
+	const size_t ReadAhead;
+
+	// The group is null if it could not be opened independently
+	std::future<std::unique_ptr<C4Group>> Add(std::string Path)
+	{
+		std::packaged_task<std::unique_ptr<C4Group>()> Task{[Path{std::move(Path)}]
+		{
+			auto pGroup = std::make_unique<C4Group>();
+			if (!pGroup->Open(Path.c_str()) || !pGroup->Preload()) pGroup.reset();
+			return pGroup;
+		}};
+		auto Result = Task.get_future();
+		{
+			const std::lock_guard<std::mutex> lock{Mutex};
+			Tasks.emplace_back(std::move(Task));
+		}
+		Wake.notify_one();
+		return Result;
+	}
+
+protected:
+	void Execute()
+	{
+		C4Thread::SetCurrentThreadName("DefPreloader");
+		for (;;)
+		{
+			std::packaged_task<std::unique_ptr<C4Group>()> Task;
+			{
+				std::unique_lock<std::mutex> lock{Mutex};
+				Wake.wait(lock, [this] { return Stopping || !Tasks.empty(); });
+				if (Stopping) return;
+				Task = std::move(Tasks.front());
+				Tasks.pop_front();
+			}
+			Task();
+		}
+	}
+};
+
 int32_t C4DefList::Load(C4Group &hGroup, uint32_t dwLoadWhat,
 	const char *szLanguage,
 	C4SoundSystem *pSoundSystem,
 	bool fOverload,
 	bool fSearchMessage, int32_t iMinProgress, int32_t iMaxProgress, bool fLoadSysGroups)
+{
+	// Definitions can be read ahead if they don't have to be unpacked in order
+	std::unique_ptr<C4DefPreloader> pPreloader;
+	if (Config.General.DefLoadThreads > 0 && hGroup.IsRandomAccess())
+		pPreloader = std::make_unique<C4DefPreloader>(Config.General.DefLoadThreads);
+	return LoadGroup(hGroup, dwLoadWhat, szLanguage, pSoundSystem, fOverload, fSearchMessage, iMinProgress, iMaxProgress, fLoadSysGroups, pPreloader.get());
+}
+
+int32_t C4DefList::LoadGroup(C4Group &hGroup, uint32_t dwLoadWhat,
+	const char *szLanguage,
+	C4SoundSystem *pSoundSystem,
+	bool fOverload,
+	bool fSearchMessage, int32_t iMinProgress, int32_t iMaxProgress, bool fLoadSysGroups,
+	C4DefPreloader *pPreloader)
 {
 	int32_t iResult = 0;
 	char szEntryname[_MAX_FNAME + 1];
-	C4Group hChild;
 	bool fPrimaryDef = false;
 	bool fThisSearchMessage = false;
 
@@ -935,18 +1027,37 @@ int32_t C4DefList::Load(C4Group &hGroup, uint32_t dwLoadWhat,
 	}
 
 	// Load sub definitions
-	int i = 0;
+	std::vector<std::string> SubDefs;
 	hGroup.ResetSearch();
 	while (hGroup.FindNextEntry(C4CFN_DefFiles, szEntryname))
-		if (hChild.OpenAsChild(&hGroup, szEntryname))
+		SubDefs.emplace_back(szEntryname);
+
+	// Read them ahead; they are still loaded and added in order
+	std::vector<std::future<std::unique_ptr<C4Group>>> Preloads(SubDefs.size());
+	const bool fPreload = pPreloader && hGroup.IsRandomAccess();
+	const StdStrBuf Path = hGroup.GetFullName() + DirSep;
+	size_t iNextPreload = 0;
+
+	int i = 0;
+	for (size_t iSubDef = 0; iSubDef < SubDefs.size(); ++iSubDef)
+	{
+		if (fPreload)
+			for (; iNextPreload < std::min(SubDefs.size(), iSubDef + pPreloader->ReadAhead); ++iNextPreload)
+				Preloads[iNextPreload] = pPreloader->Add((Path + SubDefs[iNextPreload].c_str()).getData());
+		std::unique_ptr<C4Group> pChild;
+		if (Preloads[iSubDef].valid()) pChild = Preloads[iSubDef].get();
+		if (!pChild)
 		{
-			// Hack: Assume that there are sixteen sub definitions to avoid unnecessary I/O
-			int iSubMinProgress = std::min<int32_t>(iMaxProgress, iMinProgress + ((iMaxProgress - iMinProgress) * i) / 16);
-			int iSubMaxProgress = std::min<int32_t>(iMaxProgress, iMinProgress + ((iMaxProgress - iMinProgress) * (i + 1)) / 16);
-			++i;
-			iResult += Load(hChild, dwLoadWhat, szLanguage, pSoundSystem, fOverload, fSearchMessage, iSubMinProgress, iSubMaxProgress);
-			hChild.Close();
+			pChild = std::make_unique<C4Group>();
+			if (!pChild->OpenAsChild(&hGroup, SubDefs[iSubDef].c_str())) continue;
 		}
+		// Hack: Assume that there are sixteen sub definitions to avoid unnecessary I/O
+		int iSubMinProgress = std::min<int32_t>(iMaxProgress, iMinProgress + ((iMaxProgress - iMinProgress) * i) / 16);
+		int iSubMaxProgress = std::min<int32_t>(iMaxProgress, iMinProgress + ((iMaxProgress - iMinProgress) * (i + 1)) / 16);
+		++i;
+		iResult += LoadGroup(*pChild, dwLoadWhat, szLanguage, pSoundSystem, fOverload, fSearchMessage, iSubMinProgress, iSubMaxProgress, true, pPreloader);
+		pChild->Close();
+	}
 
 	// load additional system scripts for def groups only
 	C4Group SysGroup;
@@ -1083,8 +1194,10 @@ bool C4DefList::Add(C4Def *pDef, bool fOverload)
 	else
 	{
 		// Add new def
+		DefIndices.emplace(pDef->id, Defs.size());
 		Defs.emplace_back(pDef);
 	}
+	CategoryDefs.clear();
 
 	return true;
 }
@@ -1094,6 +1207,7 @@ bool C4DefList::Remove(C4ID id)
 	if (const auto it = FindDefByID(id); it != Defs.end())
 	{
 		Defs.erase(it);
+		UpdateIndices();
 		return true;
 	}
 	return false;
@@ -1107,14 +1221,16 @@ void C4DefList::Remove(C4Def *def)
 		}); it != Defs.end())
 	{
 		Defs.erase(it);
+		UpdateIndices();
 	}
 }
 
 void C4DefList::Clear()
 {
 	Defs.clear();
+	DefIndices.clear();
+	CategoryDefs.clear();
 	LoadFailure = false;
-	Sorted = false;
 }
 
 C4Def *C4DefList::ID2Def(C4ID id)
@@ -1129,9 +1245,10 @@ C4Def *C4DefList::ID2Def(C4ID id)
 
 int32_t C4DefList::GetIndex(C4ID id)
 {
-	if (const auto it = FindDefByID(id); it != Defs.end())
+	// only uses the index, so this may be called while Defs is being filtered (see CheckRequireDef)
+	if (const auto it = DefIndices.find(id); it != DefIndices.end())
 	{
-		return std::distance(Defs.begin(), it);
+		return static_cast<int32_t>(it->second);
 	}
 	return -1;
 }
@@ -1145,11 +1262,16 @@ C4Def *C4DefList::GetDef(const std::size_t index, const std::uint32_t category)
 	}
 	else
 	{
-		std::size_t i{0};
-		const auto it = std::find_if(Defs.begin(), Defs.end(), [&](const auto &def) {
-			return (def->Category & category) && i++ == index; });
-		if (it == Defs.end()) return nullptr;
-		return it->get();
+		// callers usually iterate over all indices, so the matching definitions are collected once per category mask
+		auto [it, inserted] = CategoryDefs.try_emplace(category);
+		if (inserted)
+		{
+			for (const auto &def : Defs)
+				if (def->Category & category)
+					it->second.push_back(def.get());
+		}
+		if (index >= it->second.size()) return nullptr;
+		return it->second[index];
 	}
 }
 
@@ -1182,6 +1304,7 @@ int32_t C4DefList::CheckEngineVersion(int32_t ver1, int32_t ver2, int32_t ver3,
 		}
 		return false;
 	}), Defs.end());
+	UpdateIndices();
 	return rcount;
 }
 
@@ -1203,6 +1326,7 @@ int32_t C4DefList::CheckRequireDef()
 			}
 			return false;
 		}), Defs.end());
+		UpdateIndices();
 	} while (rcount != rcount2);
 	return rcount;
 }
@@ -1233,7 +1357,10 @@ bool C4DefList::Reload(C4Def *pDef, uint32_t dwLoadWhat, const char *szLanguage,
 	// Reload def
 	C4Group hGroup;
 	if (!hGroup.Open(pDef->Filename)) return false;
-	if (!pDef->Load(hGroup, dwLoadWhat, szLanguage, pSoundSystem)) return false;
+	const bool fSuccess{pDef->Load(hGroup, dwLoadWhat, szLanguage, pSoundSystem)};
+	// ID and category may have changed (or been cleared on failure)
+	UpdateIndices();
+	if (!fSuccess) return false;
 	hGroup.Close();
 	// rebuild quick access table
 	SortByID();
@@ -1401,7 +1528,7 @@ void C4DefList::SortByID()
 		return a->id < b->id;
 	});
 
-	Sorted = true;
+	UpdateIndices();
 }
 
 void C4DefList::Synchronize()
@@ -1418,21 +1545,21 @@ void C4DefList::ResetIncludeDependencies()
 
 std::vector<std::unique_ptr<C4Def>>::iterator C4DefList::FindDefByID(C4ID id)
 {
-	if (Sorted)
+	if (const auto it = DefIndices.find(id); it != DefIndices.end())
 	{
-		const auto it = std::lower_bound(Defs.begin(), Defs.end(), id, [](const auto &def, C4ID id)
-		{
-			return def->id < id;
-		});
-		if (it != Defs.end() && (*it)->id != id)
-		{
-			return Defs.end();
-		}
-		return it;
+		return Defs.begin() + it->second;
 	}
+	return Defs.end();
+}
 
-	return std::find_if(Defs.begin(), Defs.end(), [id](const auto &def)
+void C4DefList::UpdateIndices()
+{
+	DefIndices.clear();
+	DefIndices.reserve(Defs.size());
+	for (std::size_t i = 0; i < Defs.size(); ++i)
 	{
-		return def->id == id;
-	});
+		// keep the first definition if there are duplicates, like the linear search did
+		DefIndices.emplace(Defs[i]->id, i);
+	}
+	CategoryDefs.clear();
 }
@@ -36,6 +36,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 const int32_t C4D_None                   = 0,
@@ -416,9 +417,16 @@ public:
 
 private:
 	std::vector<std::unique_ptr<C4Def>>::iterator FindDefByID(C4ID id);
+	void UpdateIndices(); // must be called whenever Defs or the IDs or categories of its definitions change
+	int32_t LoadGroup(C4Group &hGroup,
+		uint32_t dwLoadWhat, const char *szLanguage,
+		C4SoundSystem *pSoundSystem, bool fOverload,
+		bool fSearchMessage, int32_t iMinProgress, int32_t iMaxProgress, bool fLoadSysGroups,
+		class C4DefPreloader *pPreloader);
 
 	std::vector<std::unique_ptr<C4Def>> Defs;
-	bool Sorted;
+	std::unordered_map<C4ID, std::size_t> DefIndices; // index into Defs by ID
+	std::unordered_map<std::uint32_t, std::vector<C4Def *>> CategoryDefs; // definitions matching a category mask, filled on demand
 
 public:
 	using Iterable = ConstIterableMember<&C4DefList::Defs>;
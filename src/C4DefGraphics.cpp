@@ -58,10 +58,12 @@ void C4DefGraphics::Clear()
 bool C4DefGraphics::LoadGraphics(C4Group &hGroup, const char *szFilename, const char *szFilenamePNG, const char *szOverlayPNG, bool fColorByOwner)
 {
 	// try png
-	if (szFilenamePNG && hGroup.AccessEntry(szFilenamePNG))
+	C4GroupMappedBuf PNGData;
+	if (szFilenamePNG && hGroup.LoadEntryMapped(szFilenamePNG, PNGData))
 	{
 		Bitmap = new C4Surface();
-		if (!Bitmap->ReadPNG(hGroup)) return false;
+		if (!Bitmap->ReadPNG(PNGData.getData(), PNGData.getSize())) return false;
+		PNGData.Clear();
 	}
 	else
 	{
@@ -76,10 +78,11 @@ bool C4DefGraphics::LoadGraphics(C4Group &hGroup, const char *szFilename, const
 		// Create additionmal bitmap
 		BitmapClr = new C4Surface();
 		// if overlay-surface is present, load from that
-		if (szOverlayPNG && hGroup.AccessEntry(szOverlayPNG))
+		if (szOverlayPNG && hGroup.LoadEntryMapped(szOverlayPNG, PNGData))
 		{
-			if (!BitmapClr->ReadPNG(hGroup))
+			if (!BitmapClr->ReadPNG(PNGData.getData(), PNGData.getSize()))
 				return false;
+			PNGData.Clear();
 			// set as Clr-surface, also checking size
 			if (!BitmapClr->SetAsClrByOwnerOf(Bitmap))
 			{
@@ -279,6 +282,13 @@ void C4DefGraphics::DrawClr(C4Facet &cgo, bool fAspect, uint32_t dwClr)
 void C4DefGraphicsAdapt::CompileFunc(StdCompiler *pComp)
 {
 	bool fCompiler = pComp->isCompiler();
+	// binary compilers can't tell a missing ID, so they get a flag
+	if (!pComp->hasNaming())
+	{
+		bool fPresent = !!pDefGraphics;
+		pComp->Value(fPresent);
+		if (!fPresent) { pDefGraphics = nullptr; return; }
+	}
 	// nothing?
 	if (!fCompiler && !pDefGraphics) return;
 	// definition
@@ -881,6 +891,17 @@ bool C4GraphicsOverlay::operator==(const C4GraphicsOverlay &rCmp) const
 void C4GraphicsOverlayListAdapt::CompileFunc(StdCompiler *pComp)
 {
 	bool fNaming = pComp->hasNaming();
+	// binary compilers: empty lists are marked, because the first overlay is always read
+	if (!fNaming)
+	{
+		bool fAny = !!pOverlay;
+		pComp->Value(fAny);
+		if (!fAny)
+		{
+			if (pComp->isCompiler()) { delete pOverlay; pOverlay = nullptr; }
+			return;
+		}
+	}
 	if (pComp->isCompiler())
 	{
 		// clear list
@@ -396,6 +396,13 @@ void C4DrawTransform::CompileFunc(StdCompiler *pComp)
 {
 	bool fCompiler = pComp->isCompiler();
 	int i;
+	// binary compilers keep the exact values
+	if (!pComp->hasNaming())
+	{
+		pComp->Raw(mat, sizeof(mat));
+		pComp->Value(FlipDir);
+		return;
+	}
 	// hacky. StdCompiler doesn't allow floats to be safed directly.
 	for (i = 0; i < 6; i++)
 	{
@@ -163,6 +163,8 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs)
 		return 0;
 	if (IsEnsured())
 		return Objs.ObjectCount();
+	if (!MayMatchIn(Objs))
+		return 0;
 	// Count
 	int32_t iCount = 0;
 	for (C4ObjectLink *pLnk = Objs.First; pLnk; pLnk = pLnk->Next)
@@ -175,7 +177,7 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs)
 C4Object *C4FindObject::Find(const C4ObjectList &Objs)
 {
 	// Trivial case
-	if (IsImpossible())
+	if (IsImpossible() || !MayMatchIn(Objs))
 		return nullptr;
 	// Search
 	// Double-check object status, as object might be deleted after Check()!
@@ -198,7 +200,7 @@ C4Object *C4FindObject::Find(const C4ObjectList &Objs)
 C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs)
 {
 	// Trivial case
-	if (IsImpossible())
+	if (IsImpossible() || !MayMatchIn(Objs))
 		return new C4ValueArray();
 	// Set up array
 	C4ValueArray *pArray = new C4ValueArray(32);
@@ -246,6 +248,9 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs, const C4LSectors &Sct)
 		uint32_t iMarker = ::Game.Objects.GetNextMarker();
 		int32_t iCount = 0;
 		for (; pLst; pLst = Area.NextObjectShapes(pLst, &pSct))
+		{
+			// Skip sectors without any candidates
+			if (!MayMatchIn(*pLst)) continue;
 			for (C4ObjectLink *pLnk = pLst->First; pLnk; pLnk = pLnk->Next)
 				if (pLnk->Obj->Status)
 					if (pLnk->Obj->Marker != iMarker)
@@ -254,6 +259,7 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs, const C4LSectors &Sct)
 						if (Check(pLnk->Obj))
 							iCount++;
 					}
+		}
 		return iCount;
 	}
 	else
@@ -329,6 +335,9 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors
 		// Create marker, search all areas
 		uint32_t iMarker = ::Game.Objects.GetNextMarker();
 		for (; pLst; pLst = Area.NextObjectShapes(pLst, &pSct))
+		{
+			// Skip sectors without any candidates
+			if (!MayMatchIn(*pLst)) continue;
 			for (C4ObjectLink *pLnk = pLst->First; pLnk; pLnk = pLnk->Next)
 				if (pLnk->Obj->Status)
 					if (pLnk->Obj->Marker != iMarker)
@@ -343,6 +352,7 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors
 							(*pArray)[iSize++] = C4VObj(pLnk->Obj);
 						}
 					}
+		}
 	}
 	else
 	{
@@ -351,6 +361,9 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors
 		// Search
 		C4LArea Area(&Game.Objects.Sectors, *pBounds); C4LSector *pSct;
 		for (C4ObjectList *pLst = Area.FirstObjects(&pSct); pLst; pLst = Area.NextObjects(pLst, &pSct))
+		{
+			// Skip sectors without any candidates
+			if (!MayMatchIn(*pLst)) continue;
 			for (C4ObjectLink *pLnk = pLst->First; pLnk; pLnk = pLnk->Next)
 				if (pLnk->Obj->Status)
 					if (Check(pLnk->Obj))
@@ -361,6 +374,7 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors
 						// Add object
 						(*pArray)[iSize++] = C4VObj(pLnk->Obj);
 					}
+		}
 	}
 	// Shrink array
 	pArray->SetSize(iSize);
@@ -472,6 +486,14 @@ bool C4FindObjectAnd::IsImpossible()
 	return false;
 }
 
+bool C4FindObjectAnd::MayMatchIn(const C4ObjectList &Objs)
+{
+	for (int32_t i = 0; i < iCnt; i++)
+		if (!ppConds[i]->MayMatchIn(Objs))
+			return false;
+	return true;
+}
+
 // *** C4FindObjectOr
 
 C4FindObjectOr::C4FindObjectOr(int32_t inCnt, C4FindObject **ppConds)
@@ -533,6 +555,14 @@ bool C4FindObjectOr::IsEnsured()
 	return false;
 }
 
+bool C4FindObjectOr::MayMatchIn(const C4ObjectList &Objs)
+{
+	for (int32_t i = 0; i < iCnt; i++)
+		if (ppConds[i]->MayMatchIn(Objs))
+			return true;
+	return false;
+}
+
 // *** C4FindObject* (primitive conditions)
 
 bool C4FindObjectExclude::Check(C4Object *pObj)
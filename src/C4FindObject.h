@@ -94,6 +94,7 @@ protected:
 	virtual bool UseShapes() { return false; }
 	virtual bool IsImpossible() { return false; }
 	virtual bool IsEnsured() { return false; }
+	virtual bool MayMatchIn(const C4ObjectList &Objs) { return true; } // false if no object of the list can match, see C4ObjectList::MayContainCategory
 
 private:
 	void CheckObjectStatus(C4ValueArray *pArray);
@@ -133,6 +134,7 @@ protected:
 	virtual bool UseShapes() override { return fUseShapes; }
 	virtual bool IsEnsured() override { return !iCnt; }
 	virtual bool IsImpossible() override;
+	virtual bool MayMatchIn(const C4ObjectList &Objs) override;
 };
 
 class C4FindObjectOr : public C4FindObject
@@ -151,6 +153,7 @@ protected:
 	virtual C4Rect *GetBounds() override { return fHasBounds ? &Bounds : nullptr; }
 	virtual bool IsEnsured() override;
 	virtual bool IsImpossible() override { return !iCnt; }
+	virtual bool MayMatchIn(const C4ObjectList &Objs) override;
 };
 
 // Primitive conditions
@@ -179,6 +182,7 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual bool IsImpossible() override;
+	virtual bool MayMatchIn(const C4ObjectList &Objs) override { return Objs.MayContainID(id); }
 };
 
 class C4FindObjectInRect : public C4FindObject
@@ -286,6 +290,7 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual bool IsEnsured() override;
+	virtual bool MayMatchIn(const C4ObjectList &Objs) override { return Objs.MayContainCategory(iCategory); }
 };
 
 class C4FindObjectAction : public C4FindObject
@@ -79,6 +79,15 @@ bool C4Game::InitDefs()
 {
 	int32_t iDefs = 0;
 	Log(LoadResStr("IDS_PRC_INITDEFS"));
+	// Phase timing for startup benchmarks
+	uint32_t iPhaseStart = timeGetTime();
+	const auto LogPhaseTime = [&iPhaseStart](const char *szPhase)
+	{
+		const uint32_t iNow = timeGetTime();
+		if (Config.Graphics.VerboseObjectLoading >= 1)
+			LogF("InitDefs: %s took %u ms", szPhase, iNow - iPhaseStart);
+		iPhaseStart = iNow;
+	};
 	int iDefResCount = 0;
 	for ([[maybe_unused]] const auto &def : Parameters.GameRes.iterRes(NRT_Definitions))
 		++iDefResCount;
@@ -94,9 +103,11 @@ bool C4Game::InitDefs()
 		// Def load failure
 		if (Defs.LoadFailure) return false;
 	}
+	LogPhaseTime(Config.General.DefLoadThreads > 0 ? "Loading definitions (read ahead)" : "Loading definitions");
 
 	// Load for scenario file - ignore sys group here, because it has been loaded already
 	iDefs += Defs.Load(ScenarioFile, C4D_Load_RX, Config.General.LanguageEx, &*Application.SoundSystem, true, true, 35, 40, false);
+	LogPhaseTime("Loading scenario definitions");
 
 	// Absolutely no defs: we don't like that
 	if (!iDefs) { LogFatal(LoadResStr("IDS_PRC_NODEFS")); return false; }
@@ -107,9 +118,11 @@ bool C4Game::InitDefs()
 
 	// sort before CheckRequireDef for better id-lookup performance
 	Defs.SortByID();
+	LogPhaseTime("Sorting definitions");
 
 	// Check for unmet requirements
 	Defs.CheckRequireDef();
+	LogPhaseTime("Checking requirements");
 
 	// get default particles
 	Particles.SetDefParticles();
@@ -528,6 +541,8 @@ void C4Game::Clear()
 	}
 
 	FileMonitor.reset();
+	Benchmark.reset();
+	LastSaveState.reset();
 
 	if (Application.MusicSystem)
 	{
@@ -586,6 +601,15 @@ void C4Game::Clear()
 	GameText.Clear();
 	RecordDumpFile.Clear();
 	RecordStream.Clear();
+	if (ProfileFile)
+	{
+		C4Profiler::Stop();
+		if (C4Profiler::Export(ProfileFile.getData()))
+			LogF(LoadResStr("IDS_MSG_PROFILERSAVED"), ProfileFile.getData());
+		else
+			LogF(LoadResStr("IDS_ERR_PROFILERSAVE"), ProfileFile.getData());
+		ProfileFile.Clear();
+	}
 
 	PathFinder.Clear();
 	TransferZones.Clear();
@@ -741,7 +765,7 @@ C4ST_NEW(MessagesStat,    "C4Game::Execute Messages.Execute")
 C4ST_NEW(ScriptStat,      "C4Game::Execute Script.Execute")
 
 #define EXEC_S(Expressions, Stat) \
-	{ C4ST_START(Stat) Expressions C4ST_STOP(Stat) }
+	{ C4BenchmarkSection BenchmarkSection{Benchmark.get(), #Stat}; C4ST_START(Stat) Expressions C4ST_STOP(Stat) }
 
 #ifdef DEBUGREC
 #define EXEC_S_DR(Expressions, Stat, DebugRecName) { AddDbgRec(RCT_Block, DebugRecName, 6); EXEC_S(Expressions, Stat) }
@@ -753,6 +777,8 @@ C4ST_NEW(ScriptStat,      "C4Game::Execute Script.Execute")
 
 bool C4Game::Execute() // Returns true if the game is over
 {
+	C4ProfilerZone ProfilerZone{"C4Game::Execute"};
+
 	// Let's go
 	GameGo = true;
 
@@ -1927,6 +1953,14 @@ void C4Game::CompileFunc(StdCompiler *pComp, CompileSettings comp)
 	}
 }
 
+void C4Game::CompileSaveState(StdCompiler *pComp)
+{
+	CompileFunc(pComp, CompileSettings(false, false, true));
+	// the save state header makes sure the player list is the same
+	for (C4Player *pPlr = Players.First; pPlr; pPlr = pPlr->Next)
+		pComp->Value(mkNamingAdapt(*pPlr, FormatString("Player%d", pPlr->ID).getData()));
+}
+
 void SetClientPrefix(char *szFilename, const char *szClient);
 
 bool C4Game::Decompile(StdStrBuf &rBuf, bool fSaveSection, bool fSaveExact)
@@ -3123,6 +3157,16 @@ void C4Game::ParseCommandLine(const char *szCmdLine)
 		// record stream
 		if (SEqual2NoCase(szParameter, "/stream:"))
 			RecordStream.Copy(szParameter + 8);
+		// frame profiler from startup on
+		if (SEqual2NoCase(szParameter, "/profile:"))
+		{
+			ProfileFile.Copy(szParameter + 9);
+			C4Profiler::Start();
+		}
+		// headless benchmark
+		if (SEqual2NoCase(szParameter, "/benchmark:"))
+			if (const int32_t iFrames{atoi(szParameter + 11)}; iFrames > 0)
+				Benchmark = std::make_unique<C4Benchmark>(iFrames);
 		// startup start screen
 		if (SEqual2NoCase(szParameter, "/startup:"))
 			C4Startup::SetStartScreen(szParameter + 9);
@@ -55,9 +55,13 @@
 #include <C4RoundResults.h>
 #include <C4NetworkRestartInfos.h>
 #include "C4FileMonitor.h"
+#include "C4Benchmark.h"
+#include "C4SaveState.h"
 
 class C4Game
 {
+	friend class C4SaveState;
+
 private:
 	// used as StdCompiler-parameter
 	struct CompileSettings
@@ -156,6 +160,7 @@ public:
 	bool Verbose; // default false; set to true only by command line
 	StdStrBuf RecordDumpFile;
 	StdStrBuf RecordStream;
+	StdStrBuf ProfileFile; // frame profiler trace written when the game is cleared (/profile:file)
 	bool TempScenarioFile;
 	bool fPreinited; // set after PreInit has been called; unset by Clear and Default
 	int32_t FrameCounter;
@@ -326,6 +331,7 @@ protected:
 
 public:
 	void CompileFunc(StdCompiler *pComp, CompileSettings comp);
+	void CompileSaveState(StdCompiler *pComp); // exact game data and players in list order, see C4SaveState
 	bool SaveData(C4Group &hGroup, bool fSaveSection, bool fInitial, bool fSaveExact);
 
 protected:
@@ -361,6 +367,10 @@ protected:
 	CStdCSecEx PreloadMutex;
 	bool LandscapeLoaded;
 	std::unique_ptr<C4FileMonitor> FileMonitor;
+
+public:
+	std::unique_ptr<C4Benchmark> Benchmark; // set by /benchmark:frames
+	std::unique_ptr<C4SaveState> LastSaveState; // set by /quicksave
 };
 
 const int32_t C4RULE_StructuresNeedEnergy      = 1,
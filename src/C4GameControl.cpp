@@ -26,6 +26,7 @@
 #include <C4Log.h>
 #include <C4Network2Stats.h>
 
+#include <algorithm>
 #include <cassert>
 
 // *** C4GameControl
@@ -106,6 +107,7 @@ void C4GameControl::ChangeToLocal()
 	// replay: close playback
 	else if (eMode == CM_Replay)
 	{
+		ReplayStates.clear();
 		delete pPlayback; pPlayback = nullptr;
 	}
 
@@ -121,6 +123,38 @@ void C4GameControl::ChangeToLocal()
 	ControlRate = 1;
 }
 
+bool C4GameControl::SeekReplay(int32_t iFrame)
+{
+	if (!isReplay() || !pPlayback || !pPlayback->CanSeek() || Game.Network.isEnabled()) return false;
+	// states are only kept once seeking is used, starting with the current one
+	if (!fKeepReplayStates && Config.General.ReplayStateMemory > 0)
+	{
+		fKeepReplayStates = true;
+		CaptureReplayState();
+	}
+	// closest state before the target, unless the replay is already closer to it
+	auto it = std::find_if(ReplayStates.rbegin(), ReplayStates.rend(), [iFrame](const ReplayState &State) { return State.iFrame <= iFrame; });
+	if (it != ReplayStates.rend() && (iFrame < Game.FrameCounter || it->iFrame > Game.FrameCounter))
+	{
+		if (!it->State->Restore()) return false;
+		pPlayback->SetPosition(it->Chunk);
+		// sync checks of the frames after the state will be done again
+		SyncChecks.Clear();
+		DoSync = false;
+	}
+	else if (iFrame < Game.FrameCounter)
+		return false;
+	// run the remaining frames
+	while (Game.FrameCounter < iFrame && Game.IsRunning && !Game.GameOver)
+	{
+		const int32_t iPrevFrame = Game.FrameCounter;
+		Game.Execute();
+		// halted
+		if (Game.FrameCounter == iPrevFrame) break;
+	}
+	return Game.FrameCounter == iFrame;
+}
+
 void C4GameControl::OnGameSynchronizing()
 {
 	// start record if desired
@@ -217,6 +251,9 @@ void C4GameControl::Default()
 	pRecord = nullptr;
 	pPlayback = nullptr;
 	SyncChecks.Clear();
+	ReplayStates.clear();
+	ReplayStateRate = C4ReplayStateRate;
+	fKeepReplayStates = false;
 	ControlRate = BoundBy<int>(Config.Network.ControlRate, 1, C4MaxControlRate);
 	ControlTick = 0;
 	SyncRate = C4SyncCheckRate;
@@ -294,6 +331,7 @@ void C4GameControl::Execute()
 	if (eMode == CM_Replay)
 	{
 		if (!pPlayback) { ChangeToLocal(); return; }
+		if (fKeepReplayStates && !(Game.FrameCounter % ReplayStateRate)) CaptureReplayState();
 		// control = replay data
 		pPlayback->ExecuteControl(&Control, Game.FrameCounter);
 	}
@@ -483,6 +521,33 @@ void C4GameControl::ExecControlPacket(C4PacketType eCtrlType, C4ControlPacket *p
 		pRecord->Rec(eCtrlType, pPkt, Game.FrameCounter);
 }
 
+void C4GameControl::CaptureReplayState()
+{
+	if (!pPlayback->CanSeek() || Game.Network.isEnabled()) return;
+	// still kept from before seeking back
+	if (!ReplayStates.empty() && ReplayStates.back().iFrame >= Game.FrameCounter) return;
+	auto pState = std::make_unique<C4SaveState>();
+	if (!pState->Capture()) return;
+	const size_t iMaxSize = static_cast<size_t>(std::max<int32_t>(Config.General.ReplayStateMemory, 0)) * 1024 * 1024;
+	if (pState->GetSize() > iMaxSize) return;
+	ReplayStates.push_back({std::move(pState), Game.FrameCounter, pPlayback->GetPosition()});
+	// thin out until they fit
+	const auto getSize = [this]
+	{
+		size_t iSize = 0;
+		for (const ReplayState &State : ReplayStates) iSize += State.State->GetSize();
+		return iSize;
+	};
+	while (ReplayStates.size() > 1 && getSize() > iMaxSize)
+	{
+		size_t iKept = 0;
+		for (size_t i = 0; i < ReplayStates.size(); i += 2)
+			ReplayStates[iKept++] = std::move(ReplayStates[i]);
+		ReplayStates.resize(iKept);
+		ReplayStateRate *= 2;
+	}
+}
+
 C4ControlSyncCheck *C4GameControl::GetSyncCheck(int32_t iTick)
 {
 	for (C4IDPacket *pPkt = SyncChecks.firstPkt(); pPkt; pPkt = SyncChecks.nextPkt(pPkt))
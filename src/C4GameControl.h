@@ -22,6 +22,10 @@
 #include "C4GameControlNetwork.h"
 #include "C4Network2Client.h"
 #include "C4Record.h"
+#include "C4SaveState.h"
+
+#include <memory>
+#include <vector>
 
 enum C4ControlMode
 {
@@ -38,6 +42,10 @@ const int32_t C4SyncCheckRate = 100,
 #endif
               C4SyncCheckMaxKeep = 50;
 
+// after the first seek, replays keep a save state every few seconds to seek back to;
+// if they take more than Config.General.ReplayStateMemory, every other one is dropped and the rate halved
+const int32_t C4ReplayStateRate = 36 * 10;
+
 class C4GameControl
 {
 	friend class C4ControlSyncCheck;
@@ -64,6 +72,16 @@ protected:
 
 	C4Control SyncChecks;
 
+	struct ReplayState
+	{
+		std::unique_ptr<C4SaveState> State;
+		int32_t iFrame;
+		C4Playback::Position Chunk; // first chunk not executed at iFrame
+	};
+	std::vector<ReplayState> ReplayStates; // ascending by frame
+	int32_t ReplayStateRate;
+	bool fKeepReplayStates;
+
 	C4GameControlClient *pClients;
 
 	C4Control *pExecutingControl; // Control that is in the process of being executed - needed by non-initial records
@@ -93,6 +111,7 @@ public:
 	bool InitReplay(C4Group &rGroup);
 
 	void ChangeToLocal();
+	bool SeekReplay(int32_t iFrame); // runs the frames after the closest replay state without drawing
 
 	void Clear();
 	void Default();
@@ -138,6 +157,9 @@ public:
 	void OnGameSynchronizing(); // start record if desired
 
 protected:
+	// replay states
+	void CaptureReplayState();
+
 	// sync checks
 	C4ControlSyncCheck *GetSyncCheck(int32_t iTick);
 	void RemoveOldSyncChecks();
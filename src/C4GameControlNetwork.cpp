@@ -32,6 +32,7 @@ C4GameControlNetwork::C4GameControlNetwork(C4GameControl *pnParent)
 	iControlPreSend(1), iWaitStart(-1), iAvgControlSendTime(0), iTargetFPS(DefaultTargetFPS),
 	iControlSent(0), iControlReady(0),
 	pCtrlStack(nullptr),
+	iKeepCtrlTick(-1),
 	iNextControlReqeust(0),
 	pParent(pnParent)
 {
@@ -66,6 +67,7 @@ void C4GameControlNetwork::Clear() // by main thread
 {
 	fEnabled = false; fRunning = false;
 	iAvgControlSendTime = 0;
+	iKeepCtrlTick = -1;
 	ClearCtrl(); ClearClients();
 	// clear sync control
 	SyncControl.Clear();
@@ -718,8 +720,11 @@ void C4GameControlNetwork::CheckCompleteCtrl(bool fSetEvent) // by both
 			Application.NextTick(true);
 	}
 	// clear old ctrl
-	if (Game.Control.ControlTick >= C4ControlBacklog)
-		ClearCtrl(Game.Control.ControlTick - C4ControlBacklog);
+	int32_t iClearTick = Game.Control.ControlTick - C4ControlBacklog;
+	if (const int32_t iKeepTick = iKeepCtrlTick; iKeepTick >= 0)
+		iClearTick = (std::min)(iClearTick, iKeepTick);
+	if (iClearTick >= 0)
+		ClearCtrl(iClearTick);
 	// target ctrl tick to reach?
 	if (iControlReady < iTargetTick &&
 		(!fActivated || iControlSent > iControlReady) &&
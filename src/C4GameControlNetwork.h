@@ -98,6 +98,9 @@ protected:
 	C4Control SyncControl;
 	C4GameControlPacket *pSyncCtrlQueue;
 
+	// control from this tick on is kept regardless of the backlog, e.g. for clients joining by an older dynamic (-1: none)
+	std::atomic<std::int32_t> iKeepCtrlTick;
+
 	// control request timing
 	uint32_t iNextControlReqeust;
 
@@ -113,6 +116,7 @@ public:
 	int32_t getControlPreSend() const { return iControlPreSend; }
 	void setControlPreSend(int32_t iToVal) { iControlPreSend = (std::min)(iToVal, C4MaxPreSend); }
 	int32_t getAvgControlSendTime() const { return iAvgControlSendTime; }
+	void KeepCtrl(int32_t iFromTick) { iKeepCtrlTick = iFromTick; } // by main thread
 	void setTargetFPS(int32_t iToVal) { iTargetFPS = iToVal; }
 
 	// main thread communication
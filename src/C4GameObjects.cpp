@@ -24,6 +24,7 @@
 #include <C4ObjectCom.h>
 #include <C4Random.h>
 #include <C4SolidMask.h>
+#include <C4SyncHash.h>
 #include <C4Network2Stats.h>
 #include <C4Game.h>
 #include <C4Wrappers.h>
@@ -84,6 +85,30 @@ bool C4GameObjects::Remove(C4Object *pObj)
 	return C4ObjectList::Remove(pObj);
 }
 
+uint32_t C4GameObjects::GetSyncHash()
+{
+	uint32_t iHash = 0;
+	for (C4ObjectLink *clnk = First; clnk; clnk = clnk->Next)
+	{
+		C4Object *cObj = clnk->Obj;
+		if (!cObj->Status) continue;
+		iHash = SyncHashAdd(iHash, cObj->Number);
+		iHash = SyncHashAdd(iHash, cObj->id);
+		iHash = SyncHashAdd(iHash, cObj->Owner);
+		iHash = SyncHashAdd(iHash, cObj->GetCon());
+		iHash = SyncHashAdd(iHash, cObj->Energy);
+		iHash = SyncHashAdd(iHash, cObj->fix_x.val);
+		iHash = SyncHashAdd(iHash, cObj->fix_y.val);
+		iHash = SyncHashAdd(iHash, cObj->fix_r.val);
+		iHash = SyncHashAdd(iHash, cObj->xdir.val);
+		iHash = SyncHashAdd(iHash, cObj->ydir.val);
+		iHash = SyncHashAdd(iHash, cObj->rdir.val);
+		iHash = SyncHashAdd(iHash, cObj->Contained ? cObj->Contained->Number : 0);
+		iHash = SyncHashAdd(iHash, cObj->Action.Phase);
+	}
+	return iHash;
+}
+
 C4ObjectList &C4GameObjects::ObjectsAt(int ix, int iy)
 {
 	return Sectors.SectorAt(ix, iy)->ObjectShapes;
@@ -128,8 +153,8 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 							if (Game.Players.Hostile(obj1->Owner, obj2->Owner))
 							{
 								// RejectFight callback
-								if (obj1->Call(PSF_RejectFight, {C4VObj(obj2)}).getBool()) continue;
-								if (obj2->Call(PSF_RejectFight, {C4VObj(obj1)}).getBool()) continue;
+								if (obj1->Call(C4AulCallback::RejectFight, {C4VObj(obj2)}).getBool()) continue;
+								if (obj2->Call(C4AulCallback::RejectFight, {C4VObj(obj1)}).getBool()) continue;
 								ObjectActionFight(obj1, obj2);
 								ObjectActionFight(obj2, obj1);
 								continue;
@@ -165,7 +190,7 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 										obj2->Marker = Marker;
 										// Hit
 										if ((obj2->OCF & OCF_HitSpeed2) && (obj1->OCF & OCF_Alive) && (obj2->Category & C4D_Object))
-											if (!obj1->Call(PSF_QueryCatchBlow, {C4VObj(obj2)}))
+											if (!obj1->Call(C4AulCallback::QueryCatchBlow, {C4VObj(obj2)}))
 											{
 												// "realistic" hit energy
 												C4Fixed dXDir = obj2->xdir - obj1->xdir, dYDir = obj2->ydir - obj1->ydir;
@@ -175,7 +200,7 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 												int tmass = std::max<int32_t>(obj1->Mass, 50);
 												if (!Tick3 || (obj1->Action.Act >= 0 && obj1->Def->ActMap[obj1->Action.Act].Procedure != DFA_FLIGHT))
 													obj1->Fling(obj2->xdir * 50 / tmass, -Abs(obj2->ydir / 2) * 50 / tmass, false, obj2->Controller);
-												obj1->Call(PSF_CatchBlow, {C4VInt(-iHitEnergy / 5),
+												obj1->Call(C4AulCallback::CatchBlow, {C4VInt(-iHitEnergy / 5),
 													C4VObj(obj2)});
 												// obj1 might have been tampered with
 												if (!obj1->Status || obj1->Contained || !(obj1->OCF & focf))
@@ -547,6 +572,11 @@ int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
 		Name.getData()))
 		return 0;
 
+	return PostLoad(fKeepInactive);
+}
+
+int C4GameObjects::PostLoad(bool fKeepInactive)
+{
 	// Process objects
 	C4ObjectLink *cLnk;
 	C4Object *pObj;
@@ -648,6 +678,8 @@ int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
 			Mass -= pObj->Mass;
 		}
 	}
+	// links were moved directly, so sort hints may refer to the inactive list now
+	ResetSortHints();
 
 	{
 		C4DebugRecOff DBGRECOFF; // - script callbacks that would kill DebugRec-sync for runtime start
@@ -661,6 +693,8 @@ int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
 
 	// make sure list is sorted by category - after sorting out inactives, because inactives aren't sorted into the main list
 	FixObjectOrder();
+	// list summaries may be off, because links were moved and categories fixed directly
+	C4ObjectList::InvalidateSummaries();
 
 	// misc updates
 	for (cLnk = First; cLnk; cLnk = cLnk->Next)
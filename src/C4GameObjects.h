@@ -52,6 +52,7 @@ public:
 	C4Object *AtObject(int ctx, int cty, uint32_t &ocf, C4Object *exclude = nullptr); // find object at ctx/cty
 	void Synchronize(); // network synchronization
 	uint32_t GetNextMarker();
+	uint32_t GetSyncHash(); // hash of positions and basic state of all active objects
 
 	C4Object *FindInternal(C4ID id); // find object in first sector
 	virtual C4Object *ObjectPointer(int32_t iNumber) override; // object pointer by number
@@ -63,6 +64,7 @@ public:
 	void RemoveSolidMasks();
 
 	int Load(C4Group &hGroup, bool fKeepInactive);
+	int PostLoad(bool fKeepInactive); // denumerate and check freshly compiled objects
 	bool Save(const char *szFilename, bool fSaveGame, bool fSaveInactive);
 	bool Save(C4Group &hGroup, bool fSaveGame, bool fSaveInactive);
 
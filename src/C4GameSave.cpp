@@ -27,6 +27,7 @@
 #include <C4Log.h>
 #include <C4Player.h>
 #include <C4RTF.h>
+#include <CStdFile.h>
 
 #include <utility>
 
@@ -128,13 +129,35 @@ bool C4GameSave::SaveScenarioSections()
 			// modified section: delete current
 			pSaveGroup->DeleteEntry(fn);
 			// replace by new
-			pSaveGroup->Add(pSect->GetTempFilename(), fn);
+			if (!GetAsyncClose())
+				pSaveGroup->Add(pSect->GetTempFilename(), fn);
+			// the section might be entered and changed again before the group is written
+			else if (!AddSectionCopy(pSect->GetTempFilename(), fn))
+				return false;
 		}
 	}
 	// done, success
 	return true;
 }
 
+bool C4GameSave::AddSectionCopy(const char *szSectionFilename, const char *szAddAs)
+{
+	StdBuf Section;
+	// the temp store of the main section is a folder
+	if (DirectoryExists(szSectionFilename))
+	{
+		char szTempSection[_MAX_PATH + 1];
+		SCopy(Config.AtTempPath(szAddAs), szTempSection, _MAX_PATH);
+		MakeTempFilename(szTempSection);
+		const bool fSuccess = C4Group_PackDirectoryTo(szSectionFilename, szTempSection) && Section.LoadFromFile(szTempSection);
+		EraseItem(szTempSection);
+		if (!fSuccess) return false;
+	}
+	else if (!Section.LoadFromFile(szSectionFilename))
+		return false;
+	return pSaveGroup->Add(szAddAs, Section, true, true);
+}
+
 bool C4GameSave::SaveLandscape()
 {
 	// exact?
@@ -145,12 +168,22 @@ bool C4GameSave::SaveLandscape()
 		Game.Objects.RemoveSolidMasks();
 		bool fSuccess;
 		if (Game.Landscape.Mode == C4LSC_Exact)
-			fSuccess = !!Game.Landscape.Save(*pSaveGroup);
+			fSuccess = !!Game.Landscape.Save(*pSaveGroup, GetAsyncClose() ? &pLandscapePNG : nullptr);
 		else
 			fSuccess = !!Game.Landscape.SaveDiff(*pSaveGroup, !IsSynced());
 		Game.Objects.PutSolidMasks();
 		if (!fSuccess) return false;
 		DBGRECOFF.Clear();
+		// deferred image: reserve its temp file now, the temp path may only be composed by the main thread
+		if (pLandscapePNG)
+		{
+			char szTempLandscape[_MAX_PATH + 1];
+			SCopy(Config.AtTempPath(C4CFN_TempLandscapePNG), szTempLandscape);
+			MakeTempFilename(szTempLandscape);
+			CStdFile hTemp;
+			if (!hTemp.Create(szTempLandscape) || !hTemp.Close()) return false;
+			LandscapePNGFilename.Copy(szTempLandscape);
+		}
 		// PXS
 		if (!Game.PXS.Save(*pSaveGroup)) return false;
 		// MassMover (create copy, may not modify running data)
@@ -511,13 +544,21 @@ bool C4GameSave::Close()
 	// any group open?
 	if (pSaveGroup)
 	{
+		// encode deferred landscape image
+		if (pLandscapePNG && LandscapePNGFilename.getLength())
+			if (!C4Surface::SavePNG(*pLandscapePNG, LandscapePNGFilename.getData()) || !pSaveGroup->Move(LandscapePNGFilename.getData(), C4CFN_LandscapePNG))
+			{
+				EraseFile(LandscapePNGFilename.getData());
+				fSuccess = false;
+			}
+		pLandscapePNG.reset(); LandscapePNGFilename.Clear();
 		// sort group
 		const char *szSortOrder = GetSortOrder();
 		if (szSortOrder) pSaveGroup->Sort(szSortOrder);
 		// close if owned group
 		if (fOwnGroup)
 		{
-			fSuccess = !!pSaveGroup->Close();
+			fSuccess &= !!pSaveGroup->Close();
 			delete pSaveGroup;
 			fOwnGroup = false;
 		}
@@ -30,6 +30,9 @@
 #include <C4Scenario.h>
 #include <C4Group.h>
 #include <C4Components.h>
+#include <StdBitmap.h>
+
+#include <memory>
 
 class C4GameSave
 {
@@ -45,6 +48,9 @@ protected:
 	// no runtime data will be saved for initial-state-saves
 	// SafeGame/NoInitialize-core-settings will be kept in its current state for initial saves
 	bool fInitial;
+	// landscape image that is only encoded in Close(), so the expensive part can run on another thread
+	std::unique_ptr<StdBitmap> pLandscapePNG;
+	StdStrBuf LandscapePNGFilename;
 
 	// sync state describes what to save
 	enum SyncState
@@ -69,6 +75,7 @@ protected:
 	virtual bool GetSaveScriptPlayers()     { return IsExact(); } // return whether joined script players shall be saved into SavePlayerInfos
 	virtual bool GetSaveUserPlayerFiles()   { return IsExact(); } // return whether .c4p files of joined user players shall be put into the scenario
 	virtual bool GetSaveScriptPlayerFiles() { return IsExact(); } // return whether .c4p files of joined script players shall be put into the scenario
+	virtual bool GetAsyncClose() { return false; } // return whether Close() runs on another thread: image encoding is left to it, files of the running game are copied into memory
 
 	// savegame specializations
 	virtual void AdjustCore(C4Scenario &rC4S) {} // set specific C4S values
@@ -100,6 +107,7 @@ private:
 	bool SaveCreateGroup(const char *szFilename, C4Group &hUseGroup); // create/copy group at target filename
 	bool SaveCore(); // save C4S core
 	bool SaveScenarioSections(); // save scenario sections
+	bool AddSectionCopy(const char *szSectionFilename, const char *szAddAs); // add a modified section as it is now
 	bool SaveLandscape(); // save current landscape
 	bool SaveRuntimeData(); // save any runtime data
 
@@ -173,14 +181,17 @@ protected:
 class C4GameSaveNetwork : public C4GameSave
 {
 public:
-	C4GameSaveNetwork(bool fAInitial) : C4GameSave(fAInitial, SyncSynchronized) {}
+	C4GameSaveNetwork(bool fAInitial, bool fAsyncClose = false) : C4GameSave(fAInitial, SyncSynchronized), fAsyncClose(fAsyncClose) {}
 
 protected:
+	bool fAsyncClose;
+
 	// query functions
 	virtual bool GetSaveOrigin() override { return true; } // clients must know where to get music and localization
 	virtual bool GetKeepTitle() override { return false; } // always delete title files (not used in dynamics)
 	virtual bool GetSaveDesc() override { return false; } // no desc in dynamics
 	virtual bool GetCreateSmallFile() override { return true; } // return whether file size should be minimized
+	virtual bool GetAsyncClose() override { return fAsyncClose; }
 
 	virtual bool GetCopyScenario() override { return false; } // network dynamics do not base on normal scenario
 	// savegame specializations
@@ -23,6 +23,7 @@
 #include <C4Components.h>
 #include <C4InputValidation.h>
 #include "C4Log.h"
+#include "C4Profiler.h"
 #include "StdConfig.h"
 
 #ifdef _WIN32
@@ -40,6 +41,13 @@
 #include <StdSha1.h>
 #include <fcntl.h>
 
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
+#include <zlib.h>
+
+#include <algorithm>
 #include <cstring>
 
 // File Sort Lists
@@ -83,12 +91,22 @@ char C4Group_Ignore[_MAX_PATH + 1] = "cvs;Thumbs.db";
 const char **C4Group_SortList = nullptr;
 time_t C4Group_AssumeTimeOffset = 0;
 bool(*C4Group_ProcessCallback)(const char *, int) = nullptr;
+int C4Group_IndexedCompression = -1; // C4GECM_* for new indexed groups; -1 writes the classic format
 
 void C4Group_SetProcessCallback(bool(*fnCallback)(const char *, int))
 {
 	C4Group_ProcessCallback = fnCallback;
 }
 
+void C4Group_SetIndexedCompression(int iCompression)
+{
+#ifndef USE_ZSTD
+	// Fall back to deflate if zstd isn't available
+	if (iCompression == C4GECM_Zstd) iCompression = C4GECM_Deflate;
+#endif
+	C4Group_IndexedCompression = iCompression;
+}
+
 void C4Group_SetSortList(const char **ppSortList)
 {
 	C4Group_SortList = ppSortList;
@@ -123,6 +141,35 @@ bool C4Group_IsGroup(const char *szFilename)
 	return false;
 }
 
+void MemScramble(uint8_t *bypBuffer, int iSize);
+
+static bool C4Group_IsIndexedHeader(const C4GroupHeader &Head)
+{
+	return SEqual(Head.id, C4GroupFileID) && Head.Ver1 == C4GroupFileVer1 && Head.Ver2 == C4GroupFileVer2Indexed;
+}
+
+static bool C4Group_IsIndexedBuffer(const uint8_t *pData, size_t iSize)
+{
+	if (!pData || iSize < sizeof(C4GroupHeader)) return false;
+	C4GroupHeader Head;
+	std::memcpy(&Head, pData, sizeof(Head));
+	MemScramble(reinterpret_cast<uint8_t *>(&Head), sizeof(Head));
+	return C4Group_IsIndexedHeader(Head);
+}
+
+bool C4Group_IsIndexedGroup(const char *szFilename)
+{
+	// Indexed groups start with a plain (scrambled) header instead of gzip magic bytes
+	FILE *hFile = fopen(szFilename, "rb");
+	if (!hFile) return false;
+	C4GroupHeader Head;
+	const bool fRead = fread(&Head, sizeof(Head), 1, hFile) == 1;
+	fclose(hFile);
+	if (!fRead) return false;
+	MemScramble(reinterpret_cast<uint8_t *>(&Head), sizeof(Head));
+	return C4Group_IsIndexedHeader(Head);
+}
+
 bool C4Group_CopyItem(const char *szSource, const char *szTarget1, bool fNoSort, bool fResetAttributes)
 {
 	// Parameter check
@@ -523,6 +570,153 @@ void MemScramble(uint8_t *bypBuffer, int iSize)
 	}
 }
 
+// Indexed group data
+
+// Random access to the bytes of an indexed group, either a file on disk or a memory copy.
+// Shared between an indexed group and all child groups stored uncompressed inside it.
+class C4GroupIndexedData
+{
+public:
+	C4GroupIndexedData() = default;
+	C4GroupIndexedData(const C4GroupIndexedData &) = delete;
+	C4GroupIndexedData &operator=(const C4GroupIndexedData &) = delete;
+	~C4GroupIndexedData() { if (hFile) fclose(hFile); }
+
+protected:
+	FILE *hFile{};
+	long iFilePos{};
+	long iFileSize{-1};
+	std::vector<uint8_t> Buffer;
+	StdFileMapping FileMapping;
+	bool fMappingFailed{};
+
+public:
+	bool Open(const char *szFilename)
+	{
+		return !!(hFile = fopen(szFilename, "rb"));
+	}
+
+	void SetBuffer(std::vector<uint8_t> &&Data)
+	{
+		Buffer = std::move(Data);
+	}
+
+	bool ReadAt(size_t iOffset, void *pBuffer, size_t iSize)
+	{
+		if (!hFile)
+		{
+			if (iOffset > Buffer.size() || iSize > Buffer.size() - iOffset) return false;
+			std::copy_n(Buffer.data() + iOffset, iSize, static_cast<uint8_t *>(pBuffer));
+			return true;
+		}
+		// Only seek if the last read didn't end here anyway
+		if (iFilePos != static_cast<long>(iOffset))
+		{
+			if (fseek(hFile, static_cast<long>(iOffset), SEEK_SET)) { iFilePos = -1; return false; }
+			iFilePos = static_cast<long>(iOffset);
+		}
+		if (iSize && fread(pBuffer, iSize, 1, hFile) != 1) { iFilePos = -1; return false; }
+		iFilePos += static_cast<long>(iSize);
+		return true;
+	}
+
+	// Sizes read from the group are checked against this before anything is allocated
+	size_t GetSize()
+	{
+		if (!hFile) return Buffer.size();
+		if (iFileSize < 0)
+		{
+			iFilePos = -1;
+			if (fseek(hFile, 0, SEEK_END) || (iFileSize = ftell(hFile)) < 0) { iFileSize = -1; return 0; }
+		}
+		return static_cast<size_t>(iFileSize);
+	}
+
+	// All group data in memory; files are mapped on first use
+	const uint8_t *GetMappedData(size_t &iSize)
+	{
+		if (!hFile)
+		{
+			iSize = Buffer.size();
+			return Buffer.data();
+		}
+		if (!FileMapping.getData())
+		{
+			if (fMappingFailed) return nullptr;
+			if (!FileMapping.Open(hFile)) { fMappingFailed = true; return nullptr; }
+		}
+		iSize = FileMapping.getSize();
+		return static_cast<const uint8_t *>(FileMapping.getData());
+	}
+
+	bool IsZeroAt(size_t iPos) const
+	{
+		if (!hFile) return iPos < Buffer.size() && !Buffer[iPos];
+		return FileMapping.IsZeroAt(iPos);
+	}
+};
+
+static bool C4Group_CompressEntry(char cMethod, const StdBuf &Data, StdBuf &Compressed)
+{
+	switch (cMethod)
+	{
+	case C4GECM_Deflate:
+	{
+		uLongf iSize = compressBound(checked_cast<uLong>(Data.getSize()));
+		Compressed.New(iSize);
+		if (compress2(static_cast<Bytef *>(Compressed.getMData()), &iSize, static_cast<const Bytef *>(Data.getData()), checked_cast<uLong>(Data.getSize()), Z_BEST_COMPRESSION) != Z_OK)
+			return false;
+		Compressed.Shrink(Compressed.getSize() - iSize);
+		return true;
+	}
+#ifdef USE_ZSTD
+	case C4GECM_Zstd:
+	{
+		Compressed.New(ZSTD_compressBound(Data.getSize()));
+		const size_t iSize = ZSTD_compress(Compressed.getMData(), Compressed.getSize(), Data.getData(), Data.getSize(), 19);
+		if (ZSTD_isError(iSize)) return false;
+		Compressed.Shrink(Compressed.getSize() - iSize);
+		return true;
+	}
+#endif
+	}
+	return false;
+}
+
+// Deflate can't compress better than 1032:1, so larger sizes in a directory are corrupt
+const int32_t C4Group_MaxDeflateRatio = 1032;
+
+// Checks the uncompressed size of an indexed entry against its stored size, so it can't force huge allocations
+static bool C4Group_CheckIndexedEntrySize(char cMethod, int32_t iStoredSize, int32_t iSize)
+{
+	switch (cMethod)
+	{
+	case C4GECM_Stored:
+		return iSize == iStoredSize;
+	case C4GECM_Deflate:
+		return iSize / C4Group_MaxDeflateRatio <= iStoredSize;
+	}
+	// zstd frames carry their size, which is checked on access; other methods can't be accessed anyway
+	return true;
+}
+
+static bool C4Group_DecompressEntry(char cMethod, const std::vector<uint8_t> &Compressed, std::vector<uint8_t> &Data)
+{
+	switch (cMethod)
+	{
+	case C4GECM_Deflate:
+	{
+		uLongf iSize = checked_cast<uLongf>(Data.size());
+		return uncompress(Data.data(), &iSize, Compressed.data(), checked_cast<uLong>(Compressed.size())) == Z_OK && iSize == Data.size();
+	}
+#ifdef USE_ZSTD
+	case C4GECM_Zstd:
+		return ZSTD_decompress(Data.data(), Data.size(), Compressed.data(), Compressed.size()) == Data.size();
+#endif
+	}
+	return false;
+}
+
 // C4Group
 
 void C4GroupHeader::Init()
@@ -612,8 +806,17 @@ void C4Group::Init()
 	Head.Init();
 	FirstEntry = nullptr;
 	SearchPtr = nullptr;
+	// Indexed group file only
+	IndexedData.reset();
+	IndexedBase = 0;
+	IndexedEntry = nullptr;
+	IndexedEntryBuf.clear();
+	// Preloaded entries
+	PreloadedEntry = nullptr;
+	PreloadedPtr = 0;
 	// Folder only
 	FolderSearch.Reset();
+	FolderPreloads.clear();
 	// Error status
 	SCopy("No Error", ErrorString, C4GroupMaxError);
 }
@@ -644,6 +847,8 @@ bool C4Group::Open(const char *szGroupName, bool fCreate)
 	if (!szGroupName) return Error("Open: Null filename");
 	if (!szGroupName[0]) return Error("Open: Empty filename");
 
+	C4ProfilerZone ProfilerZone{"C4Group::Open", GetFilename(szGroupName)};
+
 	char szGroupNameN[_MAX_FNAME];
 	SCopy(szGroupName, szGroupNameN, _MAX_FNAME);
 	// Convert to native path
@@ -741,6 +946,14 @@ bool C4Group::OpenRealGrpFile()
 	int cnt, file_entries;
 	C4GroupEntryCore corebuf;
 
+	// Indexed group: no gzip stream, entries are read from the file directly
+	if (C4Group_IsIndexedGroup(FileName))
+	{
+		auto pData = std::make_shared<C4GroupIndexedData>();
+		if (!pData->Open(FileName)) return Error("OpenRealGrpFile: Cannot open standard file");
+		return OpenIndexed(std::move(pData), 0);
+	}
+
 	// Open StdFile
 	if (!StdFile.Open(FileName, true)) return Error("OpenRealGrpFile: Cannot open standard file");
 
@@ -766,13 +979,135 @@ bool C4Group::OpenRealGrpFile()
 			corebuf.FileName, corebuf.Size, corebuf.Time,
 			corebuf.HasCRC, corebuf.CRC, corebuf.FileName,
 			nullptr, false, false,
-			!!corebuf.Executable))
+			!!corebuf.Executable, false,
+			!!corebuf.IndexedChild))
 			return Error("OpenRealGrpFile: Cannot add entry");
 	}
 
 	return true;
 }
 
+bool C4Group::OpenIndexed(std::shared_ptr<C4GroupIndexedData> pData, size_t iBase)
+{
+	// Read header
+	if (!pData->ReadAt(iBase, &Head, sizeof(C4GroupHeader))) return Error("OpenIndexed: Error reading header");
+	MemScramble(reinterpret_cast<uint8_t *>(&Head), sizeof(C4GroupHeader));
+	if (!C4Group_IsIndexedHeader(Head) || Head.Entries < 0 || Head.DirectoryOffset < static_cast<int32_t>(sizeof(C4GroupHeader)))
+		return Error("OpenIndexed: Invalid header");
+	// The directory and all entries must lie within the data, so a crafted header can't force huge allocations
+	const size_t iDataSize = pData->GetSize();
+	if (iBase > iDataSize) return Error("OpenIndexed: Invalid header");
+	const size_t iGroupSize = iDataSize - iBase;
+	if (static_cast<size_t>(Head.DirectoryOffset) > iGroupSize
+		|| static_cast<size_t>(Head.Entries) > (iGroupSize - Head.DirectoryOffset) / sizeof(C4GroupEntryCore))
+		return Error("OpenIndexed: Invalid header");
+
+	// Read the whole directory at once
+	std::vector<C4GroupEntryCore> Directory(Head.Entries);
+	if (!pData->ReadAt(iBase + Head.DirectoryOffset, Directory.data(), Directory.size() * sizeof(C4GroupEntryCore)))
+		return Error("OpenIndexed: Error reading entries");
+	Head.Entries = 0; // Reset, will be recounted by AddEntry
+	Head.DirectoryOffset = 0; // Only meaningful in the file
+	for (auto &corebuf : Directory)
+	{
+		C4InVal::ValidateFilename(corebuf.FileName); // filename validation: Prevent overwriting of user stuff by malicuous groups
+		if (corebuf.Offset < 0 || corebuf.StoredSize < 0 || corebuf.Size < 0
+			|| static_cast<size_t>(corebuf.Offset) > iGroupSize || static_cast<size_t>(corebuf.StoredSize) > iGroupSize - corebuf.Offset
+			|| !C4Group_CheckIndexedEntrySize(corebuf.Compression, corebuf.StoredSize, corebuf.Size))
+			return Error("OpenIndexed: Invalid entry");
+		if (!AddEntry(C4GRES_InGroup, !!corebuf.ChildGroup,
+			corebuf.FileName, corebuf.Size, corebuf.Time,
+			corebuf.HasCRC, corebuf.CRC, corebuf.FileName,
+			nullptr, false, false,
+			!!corebuf.Executable, false,
+			!!corebuf.IndexedChild))
+			return Error("OpenIndexed: Cannot add entry");
+	}
+
+	// Entries have been appended in directory order: take over the data locations
+	auto itCore = Directory.begin();
+	for (C4GroupEntry *centry = FirstEntry; centry; centry = centry->Next, ++itCore)
+	{
+		centry->Offset = itCore->Offset;
+		centry->StoredSize = itCore->StoredSize;
+		centry->Compression = itCore->Compression;
+	}
+
+	IndexedData = std::move(pData);
+	IndexedBase = iBase;
+	return true;
+}
+
+bool C4Group::OpenIndexedChild(C4GroupEntry *pEntry, size_t iSize)
+{
+	// Stored inside an indexed mother: share the mother's data
+	if (Mother->IndexedData && pEntry && pEntry->Compression == C4GECM_Stored)
+		return OpenIndexed(Mother->IndexedData, Mother->IndexedBase + pEntry->Offset);
+
+	auto pData = std::make_shared<C4GroupIndexedData>();
+
+	// Inside a folder: open the file itself
+	if (Mother->Status == GRPF_Folder)
+	{
+		if (!pData->Open(GetFullName().getData())) return Error("OpenIndexedChild: Cannot open file");
+		return OpenIndexed(std::move(pData), 0);
+	}
+
+	// Otherwise, the child has to be unpacked to memory once
+	// The header has already been read (and unscrambled) by OpenAsChild
+	if (iSize < sizeof(C4GroupHeader)) return Error("OpenIndexedChild: Entry too small");
+	std::vector<uint8_t> Data(iSize);
+	C4GroupHeader RawHead = Head;
+	MemScramble(reinterpret_cast<uint8_t *>(&RawHead), sizeof(C4GroupHeader));
+	std::memcpy(Data.data(), &RawHead, sizeof(C4GroupHeader));
+	if (!Mother->Read(Data.data() + sizeof(C4GroupHeader), iSize - sizeof(C4GroupHeader)))
+		return Error("OpenIndexedChild: Entry reading error");
+	pData->SetBuffer(std::move(Data));
+	return OpenIndexed(std::move(pData), 0);
+}
+
+bool C4Group::AccessIndexedEntry(C4GroupEntry *pEntry)
+{
+	PreloadedEntry = nullptr;
+	// Compressed entries are inflated once on access
+	if (pEntry != IndexedEntry)
+	{
+		IndexedEntry = nullptr;
+		IndexedEntryBuf.clear();
+		if (pEntry->Compression != C4GECM_Stored)
+		{
+			std::vector<uint8_t> Compressed(pEntry->StoredSize);
+			if (!IndexedData->ReadAt(IndexedBase + pEntry->Offset, Compressed.data(), Compressed.size()))
+				return Error("AccessIndexedEntry: Error reading entry");
+			// the directory size has to match the data before anything is allocated for it
+			switch (pEntry->Compression)
+			{
+			case C4GECM_Deflate:
+				break;
+#ifdef USE_ZSTD
+			case C4GECM_Zstd:
+				if (ZSTD_getFrameContentSize(Compressed.data(), Compressed.size()) != static_cast<unsigned long long>(pEntry->Size))
+					return Error("AccessIndexedEntry: Invalid entry size");
+				break;
+#endif
+			default:
+				return Error("AccessIndexedEntry: Unknown compression");
+			}
+			IndexedEntryBuf.resize(pEntry->Size);
+			if (!C4Group_DecompressEntry(pEntry->Compression, Compressed, IndexedEntryBuf))
+			{
+				IndexedEntryBuf.clear();
+				return Error("AccessIndexedEntry: Cannot decompress entry");
+			}
+		}
+		else if (pEntry->StoredSize != pEntry->Size)
+			return Error("AccessIndexedEntry: Invalid entry size");
+		IndexedEntry = pEntry;
+	}
+	FilePtr = 0;
+	return true;
+}
+
 bool C4Group::AddEntry(int status,
 	bool childgroup,
 	const char *fname,
@@ -785,13 +1120,15 @@ bool C4Group::AddEntry(int status,
 	bool fDeleteOnDisk,
 	bool fHoldBuffer,
 	bool fExecutable,
-	bool fBufferIsStdbuf)
+	bool fBufferIsStdbuf,
+	bool fIndexedChild)
 {
 	// Folder: add file to folder immediately
 	if (Status == GRPF_Folder)
 	{
 		// Close open StdFile
 		StdFile.Close();
+		ClearFolderPreloads();
 
 		// Get path to target folder file
 		char tfname[_MAX_FNAME];
@@ -808,7 +1145,7 @@ bool C4Group::AddEntry(int status,
 		case C4GRES_InMemory: // Save buffer to file in folder
 			CStdFile hFile;
 			bool fOkay = false;
-			if (hFile.Create(tfname, !!childgroup))
+			if (hFile.Create(tfname, childgroup && !C4Group_IsIndexedBuffer(membuf, size)))
 				fOkay = !!hFile.Write(membuf, size);
 			hFile.Close();
 
@@ -847,6 +1184,9 @@ bool C4Group::AddEntry(int status,
 	nentry->HasCRC = cCRC;
 	nentry->CRC = iCRC;
 	nentry->Executable = fExecutable;
+	nentry->IndexedChild = childgroup && (fIndexedChild
+		|| (status == C4GRES_OnDisk && C4Group_IsIndexedGroup(fname))
+		|| (status == C4GRES_InMemory && C4Group_IsIndexedBuffer(membuf, size)));
 	nentry->DeleteOnDisk = fDeleteOnDisk;
 	nentry->HoldBuffer = fHoldBuffer;
 	nentry->BufferIsStdbuf = fBufferIsStdbuf;
@@ -945,19 +1285,6 @@ bool C4Group::Save(bool fReOpen)
 	C4GroupEntry *centry;
 	char szTempFileName[_MAX_FNAME + 1], szGrpFileName[_MAX_FNAME + 1];
 
-	// Create temporary core list with new actual offsets to be saved
-	save_core = new C4GroupEntryCore[Head.Entries];
-	cscore = 0;
-	for (centry = FirstEntry; centry; centry = centry->Next)
-		if (centry->Status != C4GRES_Deleted)
-		{
-			save_core[cscore] = *centry;
-			// Make actual offset
-			save_core[cscore].Offset = 0;
-			if (cscore > 0) save_core[cscore].Offset = save_core[cscore - 1].Offset + save_core[cscore - 1].Size;
-			cscore++;
-		}
-
 	// Create target temp file (in working directory!)
 	SCopy(FileName, szGrpFileName, _MAX_FNAME);
 	SCopy(GetFilename(FileName), szTempFileName, _MAX_FNAME);
@@ -969,36 +1296,58 @@ bool C4Group::Save(bool fReOpen)
 		MakeTempFilename(szTempFileName);
 	}
 
-	// Create the new (temp) group file
-	CStdFile tfile;
-	if (!tfile.Create(szTempFileName, true))
+	// Indexed groups stay indexed, others are converted if requested
+	if (IndexedData || C4Group_IndexedCompression >= 0)
 	{
-		delete[] save_core; return Error("Close: ...");
+		if (!SaveIndexed(szTempFileName))
+			return false;
 	}
-
-	// Save header and core list
-	C4GroupHeader headbuf = Head;
-	MemScramble(reinterpret_cast<uint8_t *>(&headbuf), sizeof(C4GroupHeader));
-	if (!tfile.Write(reinterpret_cast<uint8_t *>(&headbuf), sizeof(C4GroupHeader))
-		|| !tfile.Write(reinterpret_cast<uint8_t *>(save_core), Head.Entries * sizeof(C4GroupEntryCore)))
+	else
 	{
-		tfile.Close(); delete[] save_core; return Error("Close: ...");
-	}
-	delete[] save_core;
+		// Create temporary core list with new actual offsets to be saved
+		save_core = new C4GroupEntryCore[Head.Entries];
+		cscore = 0;
+		for (centry = FirstEntry; centry; centry = centry->Next)
+			if (centry->Status != C4GRES_Deleted)
+			{
+				save_core[cscore] = *centry;
+				// Make actual offset
+				save_core[cscore].Offset = 0;
+				if (cscore > 0) save_core[cscore].Offset = save_core[cscore - 1].Offset + save_core[cscore - 1].Size;
+				cscore++;
+			}
 
-	// Save Entries to temp file
-	int iTotalSize = 0, iSizeDone = 0;
-	for (centry = FirstEntry; centry; centry = centry->Next) iTotalSize += centry->Size;
-	for (centry = FirstEntry; centry; centry = centry->Next)
-		if (AppendEntry2StdFile(centry, tfile))
+		// Create the new (temp) group file
+		CStdFile tfile;
+		if (!tfile.Create(szTempFileName, true))
 		{
-			iSizeDone += centry->Size; if (iTotalSize && fnProcessCallback) fnProcessCallback(centry->FileName, 100 * iSizeDone / iTotalSize);
+			delete[] save_core; return Error("Close: ...");
 		}
-		else
+
+		// Save header and core list
+		C4GroupHeader headbuf = Head;
+		MemScramble(reinterpret_cast<uint8_t *>(&headbuf), sizeof(C4GroupHeader));
+		if (!tfile.Write(reinterpret_cast<uint8_t *>(&headbuf), sizeof(C4GroupHeader))
+			|| !tfile.Write(reinterpret_cast<uint8_t *>(save_core), Head.Entries * sizeof(C4GroupEntryCore)))
 		{
-			tfile.Close(); return false;
+			tfile.Close(); delete[] save_core; return Error("Close: ...");
 		}
-	tfile.Close();
+		delete[] save_core;
+
+		// Save Entries to temp file
+		int iTotalSize = 0, iSizeDone = 0;
+		for (centry = FirstEntry; centry; centry = centry->Next) iTotalSize += centry->Size;
+		for (centry = FirstEntry; centry; centry = centry->Next)
+			if (AppendEntry2StdFile(centry, tfile))
+			{
+				iSizeDone += centry->Size; if (iTotalSize && fnProcessCallback) fnProcessCallback(centry->FileName, 100 * iSizeDone / iTotalSize);
+			}
+			else
+			{
+				tfile.Close(); return false;
+			}
+		tfile.Close();
+	}
 
 	// Child: move temp file to mother
 	if (Mother)
@@ -1058,22 +1407,56 @@ void C4Group::Clear()
 	Init();
 }
 
+bool C4Group::PrepareDiskChild(C4GroupEntry *centry, char *szFileSource, bool &fTempFile)
+{
+	SCopy(centry->DiskPath, szFileSource, _MAX_FNAME);
+	fTempFile = false;
+
+	// Disk item is a directory
+	if (DirectoryExists(centry->DiskPath))
+		return Error("AE2S: Cannot add directory to group file");
+
+	// Resort group if neccessary
+	// (The group might be renamed by adding, forcing a resort)
+	if (centry->ChildGroup)
+		if (!centry->NoSort)
+			if (!SEqual(GetFilename(szFileSource), centry->FileName))
+			{
+				// copy group
+				MakeTempFilename(szFileSource);
+				if (!CopyItem(centry->DiskPath, szFileSource))
+					return Error("AE2S: Cannot copy item");
+				// open group and resort
+				C4Group SortGrp;
+				if (!SortGrp.Open(szFileSource))
+					return Error("AE2S: Cannot open group");
+				if (!SortGrp.SortByList(C4Group_SortList, centry->FileName))
+					return Error("AE2S: Cannot resort group");
+				fTempFile = true;
+				// close group (won't be saved if the sort didn't change)
+				SortGrp.Close();
+			}
+
+	return true;
+}
+
 bool C4Group::AppendEntry2StdFile(C4GroupEntry *centry, CStdFile &hTarget)
 {
 	CStdFile hSource;
-	long csize;
-	uint8_t fbuf;
+	size_t csize, ctransfer;
+	uint8_t fbuf[CStdFileBufSize];
 
 	switch (centry->Status)
 	{
 	case C4GRES_InGroup: // Copy from group to std file
-		if (!SetFilePtr(centry->Offset))
+		if (IndexedData ? !AccessIndexedEntry(centry) : !SetFilePtr(centry->Offset))
 			return Error("AE2S: Cannot set file pointer");
-		for (csize = centry->Size; csize > 0; csize--)
+		for (csize = centry->Size; csize > 0; csize -= ctransfer)
 		{
-			if (!Read(&fbuf, 1))
+			ctransfer = std::min<size_t>(csize, sizeof(fbuf));
+			if (!Read(fbuf, ctransfer))
 				return Error("AE2S: Cannot read entry from group file");
-			if (!hTarget.Write(&fbuf, 1))
+			if (!hTarget.Write(fbuf, ctransfer))
 				return Error("AE2S: Cannot write to target file");
 		}
 		break;
@@ -1081,44 +1464,22 @@ bool C4Group::AppendEntry2StdFile(C4GroupEntry *centry, CStdFile &hTarget)
 	case C4GRES_OnDisk: // Copy/move from disk item to std file
 	{
 		char szFileSource[_MAX_FNAME + 1];
-		SCopy(centry->DiskPath, szFileSource, _MAX_FNAME);
-
-		// Disk item is a directory
-		if (DirectoryExists(centry->DiskPath))
-			return Error("AE2S: Cannot add directory to group file");
-
-		// Resort group if neccessary
-		// (The group might be renamed by adding, forcing a resort)
-		bool fTempFile = false;
-		if (centry->ChildGroup)
-			if (!centry->NoSort)
-				if (!SEqual(GetFilename(szFileSource), centry->FileName))
-				{
-					// copy group
-					MakeTempFilename(szFileSource);
-					if (!CopyItem(centry->DiskPath, szFileSource))
-						return Error("AE2S: Cannot copy item");
-					// open group and resort
-					C4Group SortGrp;
-					if (!SortGrp.Open(szFileSource))
-						return Error("AE2S: Cannot open group");
-					if (!SortGrp.SortByList(C4Group_SortList, centry->FileName))
-						return Error("AE2S: Cannot resort group");
-					fTempFile = true;
-					// close group (won't be saved if the sort didn't change)
-					SortGrp.Close();
-				}
+		bool fTempFile;
+		if (!PrepareDiskChild(centry, szFileSource, fTempFile))
+			return false;
 
 		// Append disk source to target file
-		if (!hSource.Open(szFileSource, !!centry->ChildGroup))
+		// (indexed child groups aren't gzip wrapped and are copied as they are)
+		if (!hSource.Open(szFileSource, centry->ChildGroup && !centry->IndexedChild))
 			return Error("AE2S: Cannot open on-disk file");
-		for (csize = centry->Size; csize > 0; csize--)
+		for (csize = centry->Size; csize > 0; csize -= ctransfer)
 		{
-			if (!hSource.Read(&fbuf, 1))
+			ctransfer = std::min<size_t>(csize, sizeof(fbuf));
+			if (!hSource.Read(fbuf, ctransfer))
 			{
 				hSource.Close(); return Error("AE2S: Cannot read on-disk file");
 			}
-			if (!hTarget.Write(&fbuf, 1))
+			if (!hTarget.Write(fbuf, ctransfer))
 			{
 				hSource.Close(); return Error("AE2S: Cannot write to target file");
 			}
@@ -1150,6 +1511,138 @@ bool C4Group::AppendEntry2StdFile(C4GroupEntry *centry, CStdFile &hTarget)
 	return true;
 }
 
+bool C4Group::LoadEntryData(C4GroupEntry *centry, StdBuf &Buf)
+{
+	Buf.New(centry->Size);
+
+	switch (centry->Status)
+	{
+	case C4GRES_InGroup: // Read from group
+		if (IndexedData ? !AccessIndexedEntry(centry) : !SetFilePtr(centry->Offset))
+			return Error("LED: Cannot set file pointer");
+		if (Buf.getSize() && !Read(Buf.getMData(), Buf.getSize()))
+			return Error("LED: Cannot read entry from group file");
+		return true;
+
+	case C4GRES_OnDisk: // Read disk item
+	{
+		char szFileSource[_MAX_FNAME + 1];
+		bool fTempFile;
+		if (!PrepareDiskChild(centry, szFileSource, fTempFile))
+			return false;
+		CStdFile hSource;
+		const bool fSuccess = hSource.Open(szFileSource, centry->ChildGroup && !centry->IndexedChild)
+			&& (!Buf.getSize() || hSource.Read(Buf.getMData(), Buf.getSize()));
+		hSource.Close();
+		if (fTempFile)
+			EraseItem(szFileSource);
+		if (!fSuccess)
+			return Error("LED: Cannot read on-disk file");
+		if (centry->DeleteOnDisk)
+			EraseItem(centry->DiskPath);
+		return true;
+	}
+
+	case C4GRES_InMemory: // Copy from memory
+		if (!centry->bpMemBuf) return Error("LED: no buffer");
+		Buf.Write(centry->bpMemBuf, centry->Size);
+		return true;
+	}
+
+	return Error("LED: Unknown file status");
+}
+
+bool C4Group::SaveIndexed(const char *szFilename)
+{
+	const char cCompression = static_cast<char>(C4Group_IndexedCompression >= 0 ? C4Group_IndexedCompression : C4GECM_Deflate);
+
+	CStdFile tfile;
+	if (!tfile.Create(szFilename, false))
+		return Error("Close: Cannot create indexed group file");
+
+	// Header is rewritten once the directory offset is known
+	C4GroupHeader headbuf = Head;
+	if (!tfile.Write(&headbuf, sizeof(C4GroupHeader)))
+	{
+		tfile.Close(); return Error("Close: Cannot write header");
+	}
+
+	// Save entries, each one compressed on its own
+	std::vector<C4GroupEntryCore> Directory;
+	Directory.reserve(Head.Entries);
+	size_t iOffset = sizeof(C4GroupHeader);
+	int iTotalSize = 0, iSizeDone = 0;
+	for (C4GroupEntry *centry = FirstEntry; centry; centry = centry->Next) iTotalSize += centry->Size;
+	for (C4GroupEntry *centry = FirstEntry; centry; centry = centry->Next)
+	{
+		if (centry->Status == C4GRES_Deleted) continue;
+		C4GroupEntryCore core = *centry;
+		if (centry->Status == C4GRES_InGroup && IndexedData)
+		{
+			// Unchanged entry of an indexed group: copy stored data as it is
+			StdBuf Stored; Stored.New(centry->StoredSize);
+			if (!IndexedData->ReadAt(IndexedBase + centry->Offset, Stored.getMData(), Stored.getSize())
+				|| (Stored.getSize() && !tfile.Write(Stored.getData(), Stored.getSize())))
+			{
+				tfile.Close(); return Error("Close: Cannot copy entry");
+			}
+		}
+		else
+		{
+			StdBuf Data, Compressed;
+			if (!LoadEntryData(centry, Data))
+			{
+				tfile.Close(); return false;
+			}
+			// Indexed child groups are stored so they can be read in place
+			// Data that doesn't get any smaller is stored as well
+			core.Compression = C4GECM_Stored;
+			if (cCompression != C4GECM_Stored && !centry->IndexedChild)
+				if (C4Group_CompressEntry(cCompression, Data, Compressed) && Compressed.getSize() < Data.getSize())
+				{
+					core.Compression = cCompression;
+					Data = std::move(Compressed);
+				}
+			core.StoredSize = checked_cast<int32_t>(Data.getSize());
+			if (Data.getSize() && !tfile.Write(Data.getData(), Data.getSize()))
+			{
+				tfile.Close(); return Error("Close: Cannot write entry");
+			}
+		}
+		core.Offset = checked_cast<int32_t>(iOffset);
+		iOffset += core.StoredSize;
+		// Stored entries are followed by a zero byte, so mapped text can be used in place
+		if (core.Compression == C4GECM_Stored)
+		{
+			if (!tfile.Write("", 1))
+			{
+				tfile.Close(); return Error("Close: Cannot write entry");
+			}
+			++iOffset;
+		}
+		Directory.push_back(core);
+		iSizeDone += centry->Size; if (iTotalSize && fnProcessCallback) fnProcessCallback(centry->FileName, 100 * iSizeDone / iTotalSize);
+	}
+
+	// Save directory
+	if ((!Directory.empty() && !tfile.Write(Directory.data(), Directory.size() * sizeof(C4GroupEntryCore))) || !tfile.Close())
+	{
+		tfile.Close(); return Error("Close: Cannot write directory");
+	}
+
+	// Complete header
+	headbuf.Ver2 = C4GroupFileVer2Indexed;
+	headbuf.Entries = checked_cast<int32_t>(Directory.size());
+	headbuf.DirectoryOffset = checked_cast<int32_t>(iOffset);
+	MemScramble(reinterpret_cast<uint8_t *>(&headbuf), sizeof(C4GroupHeader));
+	FILE *hFile = fopen(szFilename, "r+b");
+	if (!hFile) return Error("Close: Cannot reopen indexed group file");
+	const bool fSuccess = fwrite(&headbuf, sizeof(C4GroupHeader), 1, hFile) == 1;
+	if (fclose(hFile) || !fSuccess) return Error("Close: Cannot write header");
+
+	return true;
+}
+
 void C4Group::ResetSearch()
 {
 	switch (Status)
@@ -1223,6 +1716,16 @@ bool C4Group::SetFilePtr(size_t iOffset)
 	if (Status == GRPF_Folder)
 		return Error("SetFilePtr not implemented for Folders");
 
+	PreloadedEntry = nullptr;
+
+	// Indexed group: position within the accessed entry
+	if (IndexedData)
+	{
+		if (!IndexedEntry || iOffset > static_cast<size_t>(IndexedEntry->Size)) return false;
+		FilePtr = iOffset;
+		return true;
+	}
+
 	// ensure mother is at correct pos
 	if (Mother && !Mother->EnsureChildFilePtr(this))
 		return false;
@@ -1240,21 +1743,45 @@ bool C4Group::SetFilePtr(size_t iOffset)
 
 bool C4Group::Advance(size_t iOffset)
 {
+	if (PreloadedEntry)
+	{
+		if (iOffset > static_cast<size_t>(PreloadedEntry->Size) - PreloadedPtr) return false;
+		PreloadedPtr += iOffset;
+		return true;
+	}
 	if (Status == GRPF_Folder) return !!StdFile.Advance(iOffset);
-	// FIXME: reading the file one byte at a time sounds just slow.
-	uint8_t buf;
-	for (; iOffset > 0; iOffset--)
-		if (!Read(&buf, 1)) return false;
-	return true;
+	return AdvanceFilePtr(iOffset);
 }
 
 bool C4Group::Read(void *pBuffer, size_t iSize)
 {
+	// Preloaded entry: read from memory, the file pointer stays where it is
+	if (PreloadedEntry)
+	{
+		if (iSize > static_cast<size_t>(PreloadedEntry->Size) - PreloadedPtr)
+			return Error("Read: Beyond end of entry");
+		std::copy_n(PreloadedEntry->PreloadedData->data() + PreloadedPtr, iSize, static_cast<uint8_t *>(pBuffer));
+		PreloadedPtr += iSize;
+		return true;
+	}
 	switch (Status)
 	{
 	case GRPF_File:
+		// Indexed group: read from accessed entry
+		if (IndexedData)
+		{
+			if (!IndexedEntry || iSize > static_cast<size_t>(IndexedEntry->Size) - FilePtr)
+				return Error("Read: Beyond end of entry");
+			if (IndexedEntry->Compression == C4GECM_Stored)
+			{
+				if (!IndexedData->ReadAt(IndexedBase + IndexedEntry->Offset + FilePtr, pBuffer, iSize))
+					return Error("Read:");
+			}
+			else
+				std::copy_n(IndexedEntryBuf.data() + FilePtr, iSize, static_cast<uint8_t *>(pBuffer));
+		}
 		// Child group: read from mother group
-		if (Mother)
+		else if (Mother)
 		{
 			if (!Mother->Read(pBuffer, iSize))
 			{
@@ -1281,8 +1808,14 @@ bool C4Group::Read(void *pBuffer, size_t iSize)
 
 bool C4Group::AdvanceFilePtr(size_t iOffset, C4Group *pByChild)
 {
+	// Indexed group: just move within the accessed entry
+	if ((Status == GRPF_File) && IndexedData)
+	{
+		if (!IndexedEntry || iOffset > static_cast<size_t>(IndexedEntry->Size) - FilePtr)
+			return false;
+	}
 	// Child group file: pass command to mother
-	if ((Status == GRPF_File) && Mother)
+	else if ((Status == GRPF_File) && Mother)
 	{
 		// Ensure mother file ptr for it may have been moved by foreign access to mother
 		if (!Mother->EnsureChildFilePtr(this))
@@ -1312,6 +1845,15 @@ bool C4Group::AdvanceFilePtr(size_t iOffset, C4Group *pByChild)
 
 bool C4Group::RewindFilePtr()
 {
+	PreloadedEntry = nullptr;
+
+	// Indexed group: back to the start of the accessed entry, nothing to unpack again
+	if ((Status == GRPF_File) && IndexedData)
+	{
+		FilePtr = 0;
+		return true;
+	}
+
 #ifndef NDEBUG
 #ifdef C4ENGINE
 	if (szCurrAccessedEntry && !iC4GroupRewindFilePtrNoWarn)
@@ -1461,7 +2003,7 @@ bool C4Group::AddEntryOnDisk(const char *szFilename,
 
 	// Determine size
 	bool fIsGroup = !!C4Group_IsGroup(szFilename);
-	const auto iSize = fIsGroup ? UncompressedFileSize(szFilename) : FileSize(szFilename);
+	const auto iSize = fIsGroup && !C4Group_IsIndexedGroup(szFilename) ? UncompressedFileSize(szFilename) : FileSize(szFilename);
 
 	// Determine executable bit (linux only)
 	bool fExecutable = false;
@@ -1597,6 +2139,7 @@ bool C4Group::DeleteEntry(const char *szFilename, bool fRecycle)
 		break;
 	case GRPF_Folder:
 		StdFile.Close();
+		ClearFolderPreloads();
 		char szPath[_MAX_FNAME + 1];
 		sprintf(szPath, "%s%c%s", FileName, DirectorySeparator, szFilename);
 
@@ -1631,6 +2174,7 @@ bool C4Group::Rename(const char *szFile, const char *szNewName)
 		break;
 	case GRPF_Folder:
 		StdFile.Close();
+		ClearFolderPreloads();
 		char path[_MAX_FNAME + 1]; SCopy(FileName, path, _MAX_PATH - 1);
 		AppendBackslash(path); SAppend(szFile, path, _MAX_PATH);
 		char path2[_MAX_FNAME + 1]; SCopy(FileName, path2, _MAX_PATH - 1);
@@ -1734,7 +2278,7 @@ bool C4Group::ExtractEntry(const char *szFilename, const char *szExtractTo)
 		SCopy(szTargetFName, szTempFName, _MAX_FNAME);
 		MakeTempFilename(szTempFName);
 		// Create temp target file
-		if (!tfile.Create(szTempFName, !!pEntry->ChildGroup, !!pEntry->Executable))
+		if (!tfile.Create(szTempFName, pEntry->ChildGroup && !pEntry->IndexedChild, !!pEntry->Executable))
 			return Error("Extract: Cannot create target file");
 		// Write entry file to temp target file
 		if (!AppendEntry2StdFile(pEntry, tfile))
@@ -1782,6 +2326,8 @@ bool C4Group::OpenAsChild(C4Group *pMother,
 {
 	if (!pMother) return Error("OpenAsChild: No mother specified");
 
+	C4ProfilerZone ProfilerZone{"C4Group::OpenAsChild", szEntryName};
+
 	if (SCharCount('*', szEntryName)) return Error("OpenAsChild: No wildcards allowed");
 
 	// Open nested child group check: If szEntryName is a reference to
@@ -1853,6 +2399,18 @@ bool C4Group::OpenAsChild(C4Group *pMother,
 	MemScramble(reinterpret_cast<uint8_t *>(&Head), sizeof(C4GroupHeader));
 	EntryOffset += sizeof(C4GroupHeader);
 
+	// Indexed child: read directory, entries won't be read through the mother
+	if (C4Group_IsIndexedHeader(Head))
+	{
+		if (!OpenIndexedChild(centry, iSize))
+		{
+			CloseExclusiveMother(); Clear(); return false;
+		}
+		ResetSearch();
+		Status = GRPF_File;
+		return true;
+	}
+
 	// Check Header
 	if (!SEqual(Head.id, C4GroupFileID)
 		|| (Head.Ver1 != C4GroupFileVer1) || (Head.Ver2 > C4GroupFileVer2))
@@ -1910,6 +2468,8 @@ bool C4Group::AccessEntry(const char *szWildCard,
 	szCurrAccessedEntry = nullptr;
 #endif
 	if (!fResult) return false;
+	// Folder files may have changed on disk since they were preloaded
+	if (PreloadedEntry) iCurrFileSize = PreloadedEntry->Size;
 	if (sFileName) SCopy(fname, sFileName);
 	if (iSize) *iSize = iCurrFileSize;
 	return true;
@@ -1929,6 +2489,8 @@ bool C4Group::AccessNextEntry(const char *szWildCard,
 	szCurrAccessedEntry = nullptr;
 #endif
 	if (!fResult) return false;
+	// Folder files may have changed on disk since they were preloaded
+	if (PreloadedEntry) iCurrFileSize = PreloadedEntry->Size;
 	if (sFileName) SCopy(fname, sFileName);
 	if (iSize) *iSize = iCurrFileSize;
 	return true;
@@ -1940,15 +2502,28 @@ bool C4Group::SetFilePtr2Entry(const char *szName, C4Group *pByChild)
 	{
 	case GRPF_File:
 		C4GroupEntry *centry;
+		PreloadedEntry = nullptr;
 		if (!(centry = GetEntry(szName))) return false;
 		if (centry->Status != C4GRES_InGroup) return false;
+		if (centry->PreloadedData)
+		{
+			PreloadedEntry = centry;
+			PreloadedPtr = 0;
+			return true;
+		}
+		if (IndexedData) return AccessIndexedEntry(centry);
 		return SetFilePtr(static_cast<size_t>(centry->Offset));
 
 	case GRPF_Folder:
 		StdFile.Close();
+		if ((PreloadedEntry = GetFolderPreload(szName)))
+		{
+			PreloadedPtr = 0;
+			return true;
+		}
 		char path[_MAX_FNAME + 1]; SCopy(FileName, path, _MAX_FNAME);
 		AppendBackslash(path); SAppend(szName, path);
-		bool childgroup = C4Group_IsGroup(path);
+		bool childgroup = C4Group_IsGroup(path) && !C4Group_IsIndexedGroup(path);
 		bool fSuccess = StdFile.Open(path, !!childgroup);
 		return fSuccess;
 	}
@@ -2247,6 +2822,149 @@ bool C4Group::LoadEntryString(const char *szEntryName, StdStrBuf &Buf)
 	return true;
 }
 
+bool C4Group::LoadEntryMapped(const char *szEntryName, C4GroupMappedBuf &Buf)
+{
+	char szName[_MAX_FNAME + 1]; size_t iSize;
+	Buf.Clear();
+	if (!FindEntry(szEntryName, szName, &iSize)) return Error("LoadEntry: Not found");
+	// Reference the data in place if possible
+	std::shared_ptr<const void> Mapping; const void *pData;
+	if (!MapEntry(szName, iSize, false, Mapping, pData))
+		return LoadEntry(szName, Buf);
+	Buf.RefMapping(pData, iSize, std::move(Mapping));
+	return true;
+}
+
+bool C4Group::LoadEntryStringMapped(const char *szEntryName, C4GroupMappedStrBuf &Buf)
+{
+	char szName[_MAX_FNAME + 1]; size_t iSize;
+	Buf.Clear();
+	if (!FindEntry(szEntryName, szName, &iSize)) return Error("LoadEntry: Not found");
+	// The terminator must be part of the mapping as well
+	std::shared_ptr<const void> Mapping; const void *pData;
+	if (!MapEntry(szName, iSize, true, Mapping, pData))
+		return LoadEntryString(szName, Buf);
+	Buf.RefMapping(pData, iSize + 1, std::move(Mapping));
+	return true;
+}
+
+bool C4Group::MapEntry(const char *szName, size_t iSize, bool fZeroTerminated, std::shared_ptr<const void> &Mapping, const void *&pData)
+{
+	// Empty entries cannot be mapped
+	if (!iSize) return false;
+	switch (Status)
+	{
+	case GRPF_File:
+	{
+		C4GroupEntry *centry = GetEntry(szName);
+		if (!centry || centry->Status != C4GRES_InGroup) return false;
+		// Preloaded entries are shared as they are
+		if (centry->PreloadedData)
+		{
+			pData = centry->PreloadedData->data();
+			Mapping = centry->PreloadedData;
+			return true;
+		}
+		// Only indexed groups store entries as they are
+		if (!IndexedData || centry->Compression != C4GECM_Stored) return false;
+		size_t iDataSize;
+		const uint8_t *pGroupData = IndexedData->GetMappedData(iDataSize);
+		const size_t iPos = IndexedBase + centry->Offset;
+		if (!pGroupData || iPos > iDataSize || iSize > iDataSize - iPos) return false;
+		if (fZeroTerminated && !IndexedData->IsZeroAt(iPos + iSize)) return false;
+		pData = pGroupData + iPos;
+		// Shares ownership of the group data
+		Mapping = std::shared_ptr<const void>(IndexedData, pData);
+		return true;
+	}
+
+	case GRPF_Folder:
+	{
+		if (C4GroupEntry *pPreload = GetFolderPreload(szName))
+		{
+			if (static_cast<size_t>(pPreload->Size) != iSize) return false;
+			pData = pPreload->PreloadedData->data();
+			Mapping = pPreload->PreloadedData;
+			return true;
+		}
+		char szPath[_MAX_FNAME + 1]; SCopy(FileName, szPath, _MAX_FNAME);
+		AppendBackslash(szPath); SAppend(szName, szPath, _MAX_FNAME);
+		auto pFileMapping = std::make_shared<StdFileMapping>();
+		if (!pFileMapping->Open(szPath) || pFileMapping->getSize() != iSize) return false;
+		if (fZeroTerminated && !pFileMapping->IsZeroAt(iSize)) return false;
+		// Packed child groups are unpacked on access. Folder entries aren't checked for ChildGroup status,
+		// so leave anything with gzip magic bytes to SetFilePtr2Entry instead of opening it as a group here.
+		const auto *pMagic = static_cast<const uint8_t *>(pFileMapping->getData());
+		if (iSize >= 2 && (std::equal(pMagic, pMagic + 2, StdGzCompressedFile::C4GroupMagic) || std::equal(pMagic, pMagic + 2, StdGzCompressedFile::GZMagic)))
+			return false;
+		pData = pFileMapping->getData();
+		Mapping = std::move(pFileMapping);
+		return true;
+	}
+	}
+	return false;
+}
+
+bool C4Group::Preload(const char *szWildCard)
+{
+	if (Status == GRPF_Folder)
+	{
+		// Child groups and directories are opened on their own
+		ResetSearch();
+		for (C4GroupEntry *centry; (centry = SearchNextEntry(szWildCard)); )
+		{
+			if (C4Group_IsGroup(centry->DiskPath) || GetFolderPreload(centry->FileName)) continue;
+			auto pEntry = std::make_shared<C4GroupEntry>(*centry);
+			pEntry->PreloadedData = std::make_shared<std::vector<uint8_t>>(pEntry->Size + 1);
+			CStdFile hFile;
+			if (!hFile.Open(pEntry->DiskPath) || (pEntry->Size && !hFile.Read(pEntry->PreloadedData->data(), pEntry->Size)))
+			{
+				ResetSearch();
+				return Error("Preload: Cannot read entry");
+			}
+			FolderPreloads.push_back(std::move(pEntry));
+		}
+		ResetSearch();
+		return true;
+	}
+	if (Status != GRPF_File) return false;
+	// Read in file order, so packed groups are unpacked only once
+	for (C4GroupEntry *centry = FirstEntry; centry; centry = centry->Next)
+	{
+		if (centry->Status != C4GRES_InGroup || centry->ChildGroup || centry->PreloadedData) continue;
+		if (!WildcardMatch(szWildCard, centry->FileName)) continue;
+		auto pData = std::make_shared<std::vector<uint8_t>>(centry->Size + 1);
+		if (!SetFilePtr2Entry(centry->FileName) || (centry->Size && !Read(pData->data(), centry->Size)))
+			return Error("Preload: Cannot read entry");
+		centry->PreloadedData = std::move(pData);
+	}
+	return true;
+}
+
+C4GroupEntry *C4Group::GetFolderPreload(const char *szName)
+{
+	for (const auto &pEntry : FolderPreloads)
+		if (WildcardMatch(szName, pEntry->FileName))
+			return pEntry.get();
+	return nullptr;
+}
+
+void C4Group::ClearFolderPreloads()
+{
+	// Changed files have to be read from disk again
+	PreloadedEntry = nullptr;
+	FolderPreloads.clear();
+}
+
+bool C4Group::IsRandomAccess() const
+{
+	// Classic group files are a single zlib stream that has to be unpacked up to the accessed entry
+	for (const C4Group *pGroup = this; pGroup; pGroup = pGroup->Mother)
+		if (pGroup->Status == GRPF_File && !pGroup->IndexedData)
+			return false;
+	return true;
+}
+
 void C4Group::SetMaker(const char *szMaker)
 {
 	if (!SEqual(szMaker, Head.Maker)) Modified = true;
@@ -2362,6 +3080,18 @@ bool C4Group::SortByList(const char **ppSortList, const char *szFilename)
 
 bool C4Group::EnsureChildFilePtr(C4Group *pChild)
 {
+	// the child reads from the file
+	PreloadedEntry = nullptr;
+
+	// indexed group file: the child is an entry of its own
+	if (Status == GRPF_File && IndexedData)
+	{
+		C4GroupEntry *centry = GetEntry(GetFilename(pChild->FileName));
+		if (!centry || (centry != IndexedEntry && !AccessIndexedEntry(centry)))
+			return false;
+		return SetFilePtr(pChild->EntryOffset + pChild->FilePtr);
+	}
+
 	// group file
 	if (Status == GRPF_File)
 	{
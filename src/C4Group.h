@@ -22,6 +22,9 @@
 #include <StdBuf.h>
 #include <StdCompiler.h>
 
+#include <memory>
+#include <vector>
+
 // C4Group-Rewind-warning:
 // The current C4Group-implementation cannot handle random file access very well,
 // because all files are written within a single zlib-stream.
@@ -38,8 +41,10 @@
 // sort order lists in C4Components.h accordingly, and enforce a reading order for that
 // component.
 //
-// Maybe some day, someone will write a C4Group-implementation that is probably capable of
-// random access...
+// Groups written in the indexed format (see C4Group_SetIndexedCompression) don't have this
+// problem: every entry is compressed on its own and located through a directory at the end
+// of the file, so entries can be accessed in any order. Child groups are stored uncompressed
+// inside an indexed mother, so they are read from the same file without any unpacking.
 #ifndef NDEBUG
 extern int iC4GroupRewindFilePtrNoWarn;
 #define C4GRP_DISABLE_REWINDWARN ++iC4GroupRewindFilePtrNoWarn;
@@ -49,7 +54,8 @@ extern int iC4GroupRewindFilePtrNoWarn;
 #define C4GRP_ENABLE_REWINDWARN ;
 #endif
 
-const int C4GroupFileVer1 = 1, C4GroupFileVer2 = 2;
+const int C4GroupFileVer1 = 1, C4GroupFileVer2 = 2,
+          C4GroupFileVer2Indexed = 3; // not gzip wrapped; entries compressed separately, directory at DirectoryOffset
 
 const int C4GroupMaxMaker = 30,
           C4GroupMaxPassword = 30,
@@ -62,7 +68,9 @@ void C4Group_SetTempPath(const char *szPath);
 const char *C4Group_GetTempPath();
 void C4Group_SetSortList(const char **ppSortList);
 void C4Group_SetProcessCallback(bool(*fnCallback)(const char *, int));
+void C4Group_SetIndexedCompression(int iCompression);
 bool C4Group_IsGroup(const char *szFilename);
+bool C4Group_IsIndexedGroup(const char *szFilename);
 bool C4Group_CopyItem(const char *szSource, const char *szTarget, bool fNoSort = false, bool fResetAttributes = false);
 bool C4Group_MoveItem(const char *szSource, const char *szTarget, bool fNoSort = false);
 bool C4Group_DeleteItem(const char *szItem, bool fRecycle = false);
@@ -92,7 +100,8 @@ public:
 	char Maker[C4GroupMaxMaker + 2]{};
 	char Password[C4GroupMaxPassword + 2]{};
 	int32_t Creation{}, Original{};
-	uint8_t fbuf[92]{};
+	int32_t DirectoryOffset{}; // indexed groups only
+	uint8_t fbuf[88]{};
 
 public:
 	void Init();
@@ -102,6 +111,11 @@ const char C4GECS_None = 0,
            C4GECS_Old = 1,
            C4GECS_New = 2;
 
+// entry compression methods of indexed groups
+const char C4GECM_Stored = 0,
+           C4GECM_Deflate = 1,
+           C4GECM_Zstd = 2;
+
 class C4GroupEntryCore
 {
 public:
@@ -112,9 +126,14 @@ public:
 	char HasCRC{};
 	unsigned int CRC{};
 	char Executable{};
-	uint8_t fbuf[26]{};
+	char Compression{}; // indexed groups only
+	int32_t StoredSize{}; // indexed groups only: size of the (compressed) data at Offset
+	char IndexedChild{}; // child group in indexed format, not gzip wrapped on disk
+	uint8_t fbuf[20]{};
 };
 
+static_assert(sizeof(C4GroupHeader) == 204 && sizeof(C4GroupEntryCore) == 316, "group file layout changed");
+
 #pragma pack (pop)
 
 const int C4GRES_InGroup = 0,
@@ -135,6 +154,7 @@ public:
 	bool BufferIsStdbuf{};
 	bool NoSort{};
 	uint8_t *bpMemBuf{};
+	std::shared_ptr<std::vector<uint8_t>> PreloadedData; // contents read ahead by C4Group::Preload, followed by a zero byte
 	C4GroupEntry *Next{};
 
 public:
@@ -145,6 +165,42 @@ const int GRPF_Inactive = 0,
           GRPF_File = 1,
           GRPF_Folder = 2;
 
+class C4GroupIndexedData;
+
+// Buffer that may reference a read-only mapping of the group data instead of holding a copy.
+// The mapping stays alive as long as a buffer references it.
+template <typename BufT>
+class C4GroupMappedBuffer : public BufT
+{
+public:
+	C4GroupMappedBuffer() = default;
+	C4GroupMappedBuffer(const C4GroupMappedBuffer &) = delete;
+	C4GroupMappedBuffer &operator=(const C4GroupMappedBuffer &) = delete;
+
+protected:
+	std::shared_ptr<const void> Mapping;
+
+public:
+	bool isMapped() const { return !!Mapping; }
+	const std::shared_ptr<const void> &GetMapping() const { return Mapping; }
+
+	// Reference iSize bytes of mapped data (including the terminator for strings)
+	void RefMapping(const void *pData, size_t iSize, std::shared_ptr<const void> &&pMapping)
+	{
+		StdBuf::Ref(pData, iSize);
+		Mapping = std::move(pMapping);
+	}
+
+	void Clear()
+	{
+		BufT::Clear();
+		Mapping.reset();
+	}
+};
+
+using C4GroupMappedBuf = C4GroupMappedBuffer<StdBuf>;
+using C4GroupMappedStrBuf = C4GroupMappedBuffer<StdStrBuf>;
+
 class C4Group : public CStdStream
 {
 public:
@@ -172,6 +228,15 @@ protected:
 	DirectoryIterator FolderSearch;
 	C4GroupEntry FolderSearchEntry;
 	C4GroupEntry LastFolderSearchEntry;
+	std::vector<std::shared_ptr<C4GroupEntry>> FolderPreloads; // files read by Preload
+	// Indexed group file only
+	std::shared_ptr<C4GroupIndexedData> IndexedData; // shared with child groups stored inside
+	size_t IndexedBase; // position of this group within IndexedData
+	C4GroupEntry *IndexedEntry; // last accessed entry
+	std::vector<uint8_t> IndexedEntryBuf; // inflated contents of IndexedEntry, unless stored
+	// Preloaded entries
+	C4GroupEntry *PreloadedEntry; // accessed entry that is read from memory
+	size_t PreloadedPtr;
 
 	bool StdOutput;
 	bool(*fnProcessCallback)(const char *, int);
@@ -214,6 +279,12 @@ public:
 		size_t *ipSize = nullptr, int iAppendZeros = 0);
 	bool LoadEntry(const char *szEntryName, StdBuf &Buf);
 	bool LoadEntryString(const char *szEntryName, StdStrBuf &Buf);
+	// Like LoadEntry, but files of folder groups and entries stored uncompressed in indexed groups
+	// are referenced from a read-only file mapping instead of being copied
+	bool LoadEntryMapped(const char *szEntryName, C4GroupMappedBuf &Buf);
+	bool LoadEntryStringMapped(const char *szEntryName, C4GroupMappedStrBuf &Buf);
+	// Reads matching entries (except child groups) into memory, so later accesses don't touch the file
+	bool Preload(const char *szWildCard = "*");
 	bool FindEntry(const char *szWildCard,
 		char *sFileName = nullptr,
 		size_t *iSize = nullptr,
@@ -245,6 +316,7 @@ public:
 	C4Group *GetMother();
 	inline bool IsPacked() { return Status == GRPF_File; }
 	inline bool HasPackedMother() { if (!Mother) return false; return Mother->IsPacked(); }
+	bool IsRandomAccess() const;
 	inline bool SetNoSort(bool fNoSort) { NoSort = fNoSort; return true; }
 #ifndef NDEBUG
 	void PrintInternals(const char *szIndent = nullptr);
@@ -259,6 +331,10 @@ protected:
 	bool Error(const char *szStatus);
 	bool OpenReal(const char *szGroupName);
 	bool OpenRealGrpFile();
+	bool OpenIndexed(std::shared_ptr<C4GroupIndexedData> pData, size_t iBase);
+	bool OpenIndexedChild(C4GroupEntry *pEntry, size_t iSize);
+	bool AccessIndexedEntry(C4GroupEntry *pEntry);
+	bool SaveIndexed(const char *szFilename);
 	bool SetFilePtr(size_t iOffset);
 	bool RewindFilePtr();
 	bool AdvanceFilePtr(size_t iOffset, C4Group *pByChild = nullptr);
@@ -274,12 +350,18 @@ protected:
 		bool fDeleteOnDisk = false,
 		bool fHoldBuffer = false,
 		bool fExecutable = false,
-		bool fBufferIsStdbuf = false);
+		bool fBufferIsStdbuf = false,
+		bool fIndexedChild = false);
 	bool AddEntryOnDisk(const char *szFilename, const char *szAddAs = nullptr, bool fMove = false);
 	bool SetFilePtr2Entry(const char *szName, C4Group *pByChild = nullptr);
 	bool AppendEntry2StdFile(C4GroupEntry *centry, CStdFile &stdfile);
+	bool LoadEntryData(C4GroupEntry *centry, StdBuf &Buf);
+	bool MapEntry(const char *szName, size_t iSize, bool fZeroTerminated, std::shared_ptr<const void> &Mapping, const void *&pData);
+	bool PrepareDiskChild(C4GroupEntry *centry, char *szFileSource, bool &fTempFile);
 	C4GroupEntry *GetEntry(const char *szName);
 	C4GroupEntry *SearchNextEntry(const char *szName);
 	C4GroupEntry *GetNextFolderEntry();
+	C4GroupEntry *GetFolderPreload(const char *szName);
+	void ClearFolderPreloads();
 	bool CalcCRC32(C4GroupEntry *pEntry);
 };
@@ -27,6 +27,8 @@
 #include <C4Physics.h>
 #include <C4Random.h>
 #include <C4SurfaceFile.h>
+#include <C4SyncHash.h>
+#include <C4Thread.h>
 #include <C4ToolsDlg.h>
 #ifdef DEBUGREC
 #include <C4Record.h>
@@ -39,10 +41,14 @@
 #include <StdBitmap.h>
 #include <StdPNG.h>
 
+#include <atomic>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <stdexcept>
+#include <thread>
 #include <utility>
+#include <vector>
 
 int32_t MVehic = MNone, MTunnel = MNone, MWater = MNone, MSnow = MNone, MEarth = MNone, MGranite = MNone;
 uint8_t MCVehic = 0;
@@ -277,14 +283,14 @@ int32_t C4Landscape::ChunkyRandom(int32_t &iOffset, int32_t iRange)
 	return (iOffset ^ MapSeed) % iRange;
 }
 
-void C4Landscape::DrawChunk(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mcol, int32_t iChunkType, int32_t cro)
+void C4Landscape::DrawChunk(CSurface8 *sfcTarget, int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mcol, int32_t iChunkType, int32_t cro)
 {
 	uint8_t top_rough; uint8_t side_rough;
 	// what to do?
 	switch (iChunkType)
 	{
 	case C4M_Flat:
-		Surface8->Box(tx, ty, tx + wdt, ty + hgt, mcol);
+		sfcTarget->Box(tx, ty, tx + wdt, ty + hgt, mcol);
 		return;
 	case C4M_TopFlat:
 		top_rough = 0; side_rough = 1;
@@ -308,10 +314,10 @@ void C4Landscape::DrawChunk(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, in
 	vtcs[12] = tx + wdt + ChunkyRandom(cro, rx / 2);          vtcs[13] = ty - ChunkyRandom(cro, rx / 2 * top_rough);
 	vtcs[14] = tx + wdt / 2;                                  vtcs[15] = ty - ChunkyRandom(cro, rx * top_rough);
 
-	Surface8->Polygon(8, vtcs, mcol);
+	sfcTarget->Polygon(8, vtcs, mcol);
 }
 
-void C4Landscape::DrawSmoothOChunk(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mcol, uint8_t flip, int32_t cro)
+void C4Landscape::DrawSmoothOChunk(CSurface8 *sfcTarget, int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mcol, uint8_t flip, int32_t cro)
 {
 	int vtcs[8];
 	int32_t rx = (std::max)(wdt / 2, 1);
@@ -330,10 +336,10 @@ void C4Landscape::DrawSmoothOChunk(int32_t tx, int32_t ty, int32_t wdt, int32_t
 		vtcs[6] = tx + wdt / 2; vtcs[7] = ty + hgt / 3;
 	}
 
-	Surface8->Polygon(4, vtcs, mcol);
+	sfcTarget->Polygon(4, vtcs, mcol);
 }
 
-void C4Landscape::ChunkOZoom(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, int32_t iTexture, int32_t iOffX, int32_t iOffY)
+void C4Landscape::ChunkOZoom(CSurface8 *sfcTarget, CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, int32_t iTexture, int32_t iOffX, int32_t iOffY)
 {
 	int32_t iX, iY, iChunkWidth, iChunkHeight, iToX, iToY;
 	int32_t iIFT;
@@ -350,8 +356,6 @@ void C4Landscape::ChunkOZoom(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, in
 	iMapWdt = BoundBy<int32_t>(iMapWdt, 0, iMapWidth - iMapX); iMapHgt = BoundBy<int32_t>(iMapHgt, 0, iMapHeight - iMapY);
 	// get chunk size
 	iChunkWidth = MapZoom; iChunkHeight = MapZoom;
-	Surface32->Lock();
-	if (AnimationSurface) AnimationSurface->Lock();
 	// Scan map lines
 	for (iY = iMapY; iY < iMapY + iMapHgt; iY++)
 	{
@@ -372,7 +376,7 @@ void C4Landscape::ChunkOZoom(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, in
 				// Determine IFT
 				iIFT = 0; if (byMapPixel >= 128) iIFT = IFT;
 				// Draw chunk
-				DrawChunk(iToX, iToY, iChunkWidth, iChunkHeight, byColor + iIFT, pMaterial->MapChunkType, (iX << 2) + iY);
+				DrawChunk(sfcTarget, iToX, iToY, iChunkWidth, iChunkHeight, byColor + iIFT, pMaterial->MapChunkType, (iX << 2) + iY);
 			}
 			// Other chunk, check for slope smoothers
 			else
@@ -385,7 +389,7 @@ void C4Landscape::ChunkOZoom(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, in
 						// Determine IFT
 						iIFT = 0; if (sfcMap->GetPix(iX - 1, iY) >= 128) iIFT = IFT;
 						// Draw smoother
-						DrawSmoothOChunk(iToX, iToY, iChunkWidth, iChunkHeight, byColor + iIFT, 0, (iX << 2) + iY);
+						DrawSmoothOChunk(sfcTarget, iToX, iToY, iChunkWidth, iChunkHeight, byColor + iIFT, 0, (iX << 2) + iY);
 					}
 					// Same texture-material on right
 					if ((iX < iMapWidth - 1) && ((sfcMap->GetPix(iX + 1, iY) & 127) == iTexture))
@@ -393,13 +397,11 @@ void C4Landscape::ChunkOZoom(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, in
 						// Determine IFT
 						iIFT = 0; if (sfcMap->GetPix(iX + 1, iY) >= 128) iIFT = IFT;
 						// Draw smoother
-						DrawSmoothOChunk(iToX, iToY, iChunkWidth, iChunkHeight, byColor + iIFT, 1, (iX << 2) + iY);
+						DrawSmoothOChunk(sfcTarget, iToX, iToY, iChunkWidth, iChunkHeight, byColor + iIFT, 1, (iX << 2) + iY);
 					}
 				}
 		}
 	}
-	Surface32->Unlock();
-	if (AnimationSurface) AnimationSurface->Unlock();
 }
 
 bool C4Landscape::GetTexUsage(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, uint32_t *dwpTextureUsage)
@@ -423,6 +425,15 @@ bool C4Landscape::GetTexUsage(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, i
 
 bool C4Landscape::TexOZoom(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, uint32_t *dwpTextureUsage, int32_t iToX, int32_t iToY)
 {
+	// Large areas (e.g. the whole landscape at scenario start) are zoomed in row bands on multiple threads
+	const C4Rect Target{Surface8->ClipX, Surface8->ClipY, Surface8->ClipX2 - Surface8->ClipX + 1, Surface8->ClipY2 - Surface8->ClipY + 1};
+	const int32_t iThreadCount = std::min<int32_t>(Config.General.MapRenderThreads, Target.Hgt / C4LS_MinZoomBandHgt);
+	if (iThreadCount > 1 && Target.Wdt * Target.Hgt >= C4LS_MinParallelZoomArea)
+	{
+		TexOZoomParallel(sfcMap, iMapX, iMapY, iMapWdt, iMapHgt, dwpTextureUsage, iToX, iToY, Target, iThreadCount);
+		return true;
+	}
+
 	int32_t iIndex;
 
 	// ChunkOZoom all used textures
@@ -430,13 +441,55 @@ bool C4Landscape::TexOZoom(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int3
 		if (dwpTextureUsage[iIndex] > 0)
 		{
 			// ChunkOZoom map to landscape
-			ChunkOZoom(sfcMap, iMapX, iMapY, iMapWdt, iMapHgt, iIndex, iToX, iToY);
+			ChunkOZoom(Surface8, sfcMap, iMapX, iMapY, iMapWdt, iMapHgt, iIndex, iToX, iToY);
 		}
 
 	// Done
 	return true;
 }
 
+void C4Landscape::TexOZoomParallel(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, uint32_t *dwpTextureUsage, int32_t iToX, int32_t iToY, const C4Rect &Target, int32_t iThreadCount)
+{
+	// Chunk polygons are rasterized independently of clipping and position, so zooming each band
+	// into a buffer of its own yields exactly the same pixels as zooming the whole area at once
+	const int32_t iBandCount = std::min<int32_t>(Target.Hgt / C4LS_MinZoomBandHgt, iThreadCount * 4);
+	// clip the map segment like ChunkOZoom does, so the bands cover exactly the same map rows
+	iMapY = BoundBy<int32_t>(iMapY, 0, sfcMap->Hgt - 1);
+	iMapHgt = BoundBy<int32_t>(iMapHgt, 0, sfcMap->Hgt - iMapY);
+	std::atomic<int32_t> iNextBand{0};
+	const auto ZoomBands = [&]
+	{
+		uint32_t dwBandTexUsage[C4M_MaxTexIndex + 1];
+		for (int32_t iBand; (iBand = iNextBand.fetch_add(1, std::memory_order_relaxed)) < iBandCount; )
+		{
+			const int32_t iBandY = Target.y + Target.Hgt * iBand / iBandCount;
+			const int32_t iBandHgt = Target.y + Target.Hgt * (iBand + 1) / iBandCount - iBandY;
+			CSurface8 sfcBand(Target.Wdt, iBandHgt);
+			for (int32_t iY = 0; iY < iBandHgt; ++iY)
+				std::memcpy(sfcBand.Bits + iY * sfcBand.Pitch, Surface8->Bits + (iBandY + iY) * Surface8->Pitch + Target.x, Target.Wdt);
+			// map rows whose chunks may reach into the band (chunks overlap their neighbours by up to two map pixels)
+			const int32_t iBandMapY = std::max<int32_t>(iMapY, (iBandY - iToY) / MapZoom - 3);
+			const int32_t iBandMapY2 = std::min<int32_t>(iMapY + iMapHgt, (iBandY + iBandHgt - iToY) / MapZoom + 4);
+			if (iBandMapY < iBandMapY2 && GetTexUsage(sfcMap, iMapX, iBandMapY, iMapWdt, iBandMapY2 - iBandMapY, dwBandTexUsage))
+				for (int32_t iIndex = 1; iIndex < C4M_MaxTexIndex; iIndex++)
+					if (dwpTextureUsage[iIndex] > 0 && dwBandTexUsage[iIndex] > 0)
+						ChunkOZoom(&sfcBand, sfcMap, iMapX, iBandMapY, iMapWdt, iBandMapY2 - iBandMapY, iIndex, iToX - Target.x, iToY - iBandY);
+			for (int32_t iY = 0; iY < iBandHgt; ++iY)
+				std::memcpy(Surface8->Bits + (iBandY + iY) * Surface8->Pitch + Target.x, sfcBand.Bits + iY * sfcBand.Pitch, Target.Wdt);
+		}
+	};
+	// the calling thread zooms, too
+	std::vector<std::thread> Threads;
+	for (int32_t i = 1; i < std::min(iThreadCount, iBandCount); ++i)
+		Threads.emplace_back([&ZoomBands]
+		{
+			C4Thread::SetCurrentThreadName("LandscapeZoom");
+			ZoomBands();
+		});
+	ZoomBands();
+	for (auto &Thread : Threads) Thread.join();
+}
+
 bool C4Landscape::SkyToLandscape(int32_t iToX, int32_t iToY, int32_t iToWdt, int32_t iToHgt, int32_t iOffX, int32_t iOffY)
 {
 	if (!Surface32->Lock()) return false;
@@ -729,6 +782,10 @@ bool C4Landscape::Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bo
 	// enforce first color to be transparent
 	Surface8->EnforceC0Transparency();
 
+	// initial sync hash
+	PixHash = 0;
+	UpdatePixHash(C4Rect(0, 0, Width, Height));
+
 	// after map/landscape creation, the seed must be fixed again, so there's no difference between clients creating
 	// and not creating the map
 	Game.FixRandom(Game.Parameters.RandomSeed);
@@ -786,6 +843,9 @@ bool C4Landscape::_SetPix(int32_t x, int32_t y, uint8_t npix)
 	// get and check pixel
 	uint8_t opix = _GetPix(x, y);
 	if (npix == opix) return true;
+	// update sync hash, unless the pixel is in the area of a pending change, which is hashed as a whole
+	if (!fPixHashPending || !PixHashPending.Contains(x, y))
+		PixHash ^= SyncHash((static_cast<uint64_t>(y * Width + x) << 8) | opix) ^ SyncHash((static_cast<uint64_t>(y * Width + x) << 8) | npix);
 	// count pixels
 	if (Pix2Dens[npix])
 	{
@@ -1439,7 +1499,7 @@ bool C4Landscape::Incinerate(int32_t x, int32_t y)
 	return false;
 }
 
-bool C4Landscape::Save(C4Group &hGroup)
+bool C4Landscape::Save(C4Group &hGroup, std::unique_ptr<StdBitmap> *pDeferredPNG)
 {
 	// Save members
 	if (!Sky.Save(hGroup))
@@ -1456,11 +1516,20 @@ bool C4Landscape::Save(C4Group &hGroup)
 	if (!hGroup.Move(szTempLandscape, C4CFN_Landscape))
 		return false;
 
-	SCopy(Config.AtTempPath(C4CFN_TempLandscapePNG), szTempLandscape);
-	MakeTempFilename(szTempLandscape);
-	if (!Surface32->SavePNG(szTempLandscape, true, false, false))
-		return false;
-	if (!hGroup.Move(szTempLandscape, C4CFN_LandscapePNG)) return false;
+	// encoding is slow, so the caller might want to do it later
+	if (pDeferredPNG)
+	{
+		if (!(*pDeferredPNG = Surface32->GetBitmap(true, false, false)))
+			return false;
+	}
+	else
+	{
+		SCopy(Config.AtTempPath(C4CFN_TempLandscapePNG), szTempLandscape);
+		MakeTempFilename(szTempLandscape);
+		if (!Surface32->SavePNG(szTempLandscape, true, false, false))
+			return false;
+		if (!hGroup.Move(szTempLandscape, C4CFN_LandscapePNG)) return false;
+	}
 
 	if (fMapChanged && Map)
 		if (!SaveMap(hGroup)) return false;
@@ -1660,6 +1729,8 @@ void C4Landscape::Default()
 	Modulation = 0;
 	fMapChanged = false;
 	ShadeMaterials = true;
+	PixHash = 0;
+	fPixHashPending = false;
 }
 
 void C4Landscape::ClearBlastMatCount()
@@ -1676,6 +1747,9 @@ void C4Landscape::Synchronize()
 {
 	ScanX = 0;
 	ClearBlastMatCount();
+	// rehash, so that joining clients can compare
+	PixHash = 0;
+	UpdatePixHash(C4Rect(0, 0, Width, Height));
 }
 
 namespace
@@ -2447,7 +2521,7 @@ bool C4Landscape::DrawChunks(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, i
 	int32_t x, y;
 	for (x = 0; x < icntx; x++)
 		for (y = 0; y < icnty; y++)
-			DrawChunk(tx + wdt * x / icntx, ty + hgt * y / icnty, wdt / icntx, hgt / icnty, byColor, Game.Material.Map[iMaterial].MapChunkType, Random(1000));
+			DrawChunk(Surface8, tx + wdt * x / icntx, ty + hgt * y / icnty, wdt / icntx, hgt / icnty, byColor, Game.Material.Map[iMaterial].MapChunkType, Random(1000));
 
 	// remove clipper
 	Surface8->NoClip();
@@ -2543,27 +2617,59 @@ bool C4Landscape::ApplyLighting(C4Rect To)
 
 	if (!Surface32->LockForUpdate(To)) return false;
 	Surface32->ClearBoxDw(To.x, To.y, To.Wdt, To.Hgt);
+
+	// The landscape is stored row by row, so walk it that way.
+	// Shading needs the placement of the 8 pixels above and below each pixel plus its horizontal neighbours:
+	// placement rows To.y - 9 to To.y + To.Hgt + 8 are kept in a ring buffer of PlacementRows rows,
+	// each spanning To.x - 1 to To.x + To.Wdt, and every column keeps running sums of the rows above and below.
+	constexpr int32_t PlacementRows = 18;
+	const int32_t rowWdt = To.Wdt + 2;
+	std::vector<int32_t> placement, aboveDensity, belowDensity;
+	const auto placementRow = [&](int32_t iY) { return placement.data() + ((iY - To.y + PlacementRows) % PlacementRows) * rowWdt + 1; };
+
+	if (ShadeMaterials)
+	{
+		placement.resize(PlacementRows * rowWdt);
+		aboveDensity.assign(To.Wdt, 0);
+		belowDensity.assign(To.Wdt, 0);
+		for (int32_t iY = To.y - 9; iY < To.y + 8; ++iY)
+		{
+			GetPlacementRow(iY, To.x - 1, rowWdt, placementRow(iY) - 1);
+		}
+		for (int32_t i = 1; i <= 8; ++i)
+		{
+			const int32_t *const above = placementRow(To.y - i - 1), *const below = placementRow(To.y + i - 1);
+			for (int32_t iX = 0; iX < To.Wdt; ++iX)
+			{
+				aboveDensity[iX] += above[iX];
+				belowDensity[iX] += below[iX];
+			}
+		}
+	}
+
 	// do lightning
-	for (int32_t iX = To.x; iX < To.x + To.Wdt; ++iX)
+	for (int32_t iY = To.y; iY < To.y + To.Hgt; ++iY)
 	{
-		int AboveDensity = 0, BelowDensity = 0;
+		const int32_t *own = nullptr;
 		if (ShadeMaterials)
 		{
-			for (int i = 1; i <= 8; ++i)
+			// the row entering below replaces row iY - 10, which has already left both windows
+			const int32_t *const aboveOut = placementRow(iY - 9), *const aboveIn = placementRow(iY - 1);
+			own = placementRow(iY);
+			for (int32_t iX = 0; iX < To.Wdt; ++iX)
+			{
+				aboveDensity[iX] += aboveIn[iX] - aboveOut[iX];
+			}
+			int32_t *const belowIn = placementRow(iY + 8);
+			GetPlacementRow(iY + 8, To.x - 1, rowWdt, belowIn - 1);
+			for (int32_t iX = 0; iX < To.Wdt; ++iX)
 			{
-				AboveDensity += GetPlacement(iX, To.y - i - 1);
-				BelowDensity += GetPlacement(iX, To.y + i - 1);
+				belowDensity[iX] += belowIn[iX] - own[iX];
 			}
 		}
 
-		for (int32_t iY = To.y; iY < To.y + To.Hgt; ++iY)
+		for (int32_t iX = To.x; iX < To.x + To.Wdt; ++iX)
 		{
-			// do not move that code into the if (ShadeMaterials) block, as it needs to be run for sky pixels as well
-			AboveDensity -= GetPlacement(iX, iY - 9);
-			AboveDensity += GetPlacement(iX, iY - 1);
-			BelowDensity -= GetPlacement(iX, iY);
-			BelowDensity += GetPlacement(iX, iY + 8);
-
 			// Normal color
 			uint32_t dwBackClr = GetClrByTex(iX, iY);
 
@@ -2577,14 +2683,15 @@ bool C4Landscape::ApplyLighting(C4Rect To)
 
 			if (ShadeMaterials)
 			{
+				const int32_t i = iX - To.x;
 				// get density
 				int iOwnDens = Pix2Place[pix];
 				if (!iOwnDens) continue;
 				iOwnDens *= 2;
-				iOwnDens += GetPlacement(iX + 1, iY) + GetPlacement(iX - 1, iY);
+				iOwnDens += own[i + 1] + own[i - 1];
 				iOwnDens /= 4;
 				// get density of surrounding materials
-				int iCompareDens = AboveDensity / 8;
+				int iCompareDens = aboveDensity[i] / 8;
 				if (iOwnDens > iCompareDens)
 				{
 					// apply light
@@ -2594,7 +2701,7 @@ bool C4Landscape::ApplyLighting(C4Rect To)
 				{
 					DarkenClrBy(dwBackClr, (std::min)(30, 2 * (iCompareDens - iOwnDens)));
 				}
-				iCompareDens = BelowDensity / 8;
+				iCompareDens = belowDensity[i] / 8;
 				if (iOwnDens > iCompareDens)
 				{
 					DarkenClrBy(dwBackClr, (std::min)(30, 2 * (iOwnDens - iCompareDens)));
@@ -2609,6 +2716,22 @@ bool C4Landscape::ApplyLighting(C4Rect To)
 	return UpdateAnimationSurface(To);
 }
 
+void C4Landscape::GetPlacementRow(int32_t iY, int32_t iX, int32_t iWdt, int32_t *pOut)
+{
+	// rows outside the landscape and columns beyond the left or right border go through the border checks of GetPix
+	if (iY < 0 || iY >= Height)
+	{
+		for (int32_t i = 0; i < iWdt; ++i) pOut[i] = GetPlacement(iX + i, iY);
+		return;
+	}
+	const int32_t iX1 = (std::max)(iX, 0), iX2 = (std::min)(iX + iWdt, Width);
+	for (int32_t x = iX; x < iX1; ++x) *pOut++ = GetPlacement(x, iY);
+	// unchecked interior
+	const uint8_t *pPix = Surface8->Bits + iY * Surface8->Pitch + iX1;
+	for (int32_t x = iX1; x < iX2; ++x) *pOut++ = Pix2Place[*pPix++];
+	for (int32_t x = iX2; x < iX + iWdt; ++x) *pOut++ = GetPlacement(x, iY);
+}
+
 bool C4Landscape::UpdateAnimationSurface(C4Rect To)
 {
 	if (!AnimationSurface) return true;
@@ -2617,9 +2740,9 @@ bool C4Landscape::UpdateAnimationSurface(C4Rect To)
 
 	AnimationSurface->ClearBoxDw(To.x, To.y, To.Wdt, To.Hgt);
 
-	for (int32_t iX = To.x; iX < To.x + To.Wdt; ++iX)
+	for (int32_t iY = To.y; iY < To.y + To.Hgt; ++iY)
 	{
-		for (int32_t iY = To.y; iY < To.y + To.Hgt; ++iY)
+		for (int32_t iX = To.x; iX < To.x + To.Wdt; ++iX)
 		{
 			AnimationSurface->SetPixDw(iX, iY, DensityLiquid(Pix2Dens[_GetPix(iX, iY)]) ? 255 << 24 : 0);
 		}
@@ -2863,6 +2986,12 @@ void C4Landscape::PrepareChange(C4Rect BoundingBox, const bool updateMatCnt)
 		pSolid->RemoveTemporary(SolidMaskRect);
 	}
 	if (updateMatCnt) UpdateMatCnt(BoundingBox, false);
+	// take area out of the sync hash until FinishChange
+	assert(!fPixHashPending);
+	PixHashPending = BoundingBox;
+	PixHashPending.Intersect(C4Rect(0, 0, Width, Height));
+	UpdatePixHash(PixHashPending);
+	fPixHashPending = true;
 }
 
 void C4Landscape::FinishChange(C4Rect BoundingBox, const bool updateMatAndPixCnt)
@@ -2870,6 +2999,9 @@ void C4Landscape::FinishChange(C4Rect BoundingBox, const bool updateMatAndPixCnt
 	// relight
 	Relight(BoundingBox);
 	if (updateMatAndPixCnt) UpdateMatCnt(BoundingBox, true);
+	// rehash area before solidmasks go back in
+	UpdatePixHash(PixHashPending);
+	fPixHashPending = false;
 	// Restore Solidmasks
 	C4Rect SolidMaskRect = BoundingBox;
 	SolidMaskRect.x -= 2 * C4LS_MaxLightDistX; SolidMaskRect.y -= 2 * C4LS_MaxLightDistY;
@@ -2899,6 +3031,14 @@ void C4Landscape::UpdatePixCnt(const C4Rect &Rect, bool fCheck)
 		}
 }
 
+void C4Landscape::UpdatePixHash(C4Rect Rect)
+{
+	Rect.Intersect(C4Rect(0, 0, Width, Height));
+	for (int32_t y = Rect.y; y < Rect.y + Rect.Hgt; y++)
+		for (int32_t x = Rect.x; x < Rect.x + Rect.Wdt; x++)
+			PixHash ^= SyncHash((static_cast<uint64_t>(y * Width + x) << 8) | _GetPix(x, y));
+}
+
 void C4Landscape::UpdateMatCnt(C4Rect Rect, bool fPlus)
 {
 	Rect.Intersect(C4Rect(0, 0, Width, Height));
@@ -2984,6 +3124,31 @@ void C4Landscape::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(Mode,                    "Mode",          C4LSC_Undefined));
 }
 
+void C4Landscape::CompilePixels(StdCompiler *pComp)
+{
+	int32_t iWdt = Width, iHgt = Height;
+	pComp->Value(iWdt); pComp->Value(iHgt);
+	if (iWdt != Width || iHgt != Height)
+	{
+		pComp->excCorrupt("Landscape: size %dx%d does not match %dx%d", static_cast<int>(iWdt), static_cast<int>(iHgt), static_cast<int>(Width), static_cast<int>(Height));
+		return;
+	}
+	if (!pComp->isCompiler())
+	{
+		for (int32_t y = 0; y < Height; ++y)
+			pComp->Raw(Surface8->Bits + y * Surface8->Pitch, Width);
+		return;
+	}
+	// read everything first, so broken data leaves the landscape untouched
+	std::vector<uint8_t> Pixels(static_cast<size_t>(Width) * Height);
+	pComp->Raw(Pixels.data(), Pixels.size());
+	const C4Rect All{0, 0, Width, Height};
+	PrepareChange(All);
+	for (int32_t y = 0; y < Height; ++y)
+		std::memcpy(Surface8->Bits + y * Surface8->Pitch, Pixels.data() + static_cast<size_t>(y) * Width, Width);
+	FinishChange(All);
+}
+
 void C4Landscape::RemoveUnusedTexMapEntries()
 {
 	// check usage in landscape
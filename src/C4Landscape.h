@@ -25,6 +25,9 @@
 #include <StdSurface8.h>
 
 #include <cstdint>
+#include <memory>
+
+class StdBitmap;
 
 const uint8_t GBM        = 128,
               GBM_ColNum = 64,
@@ -42,6 +45,10 @@ const int32_t C4LSC_Undefined = 0,
 
 const int32_t C4LS_MaxRelights = 50;
 
+// landscape areas zoomed from the map on multiple threads (see Config.General.MapRenderThreads)
+const int32_t C4LS_MinParallelZoomArea = 256 * 256,
+              C4LS_MinZoomBandHgt = 32;
+
 class C4MapCreatorS2;
 class C4Object;
 
@@ -80,6 +87,9 @@ protected:
 	int32_t PixCntPitch;
 	uint8_t *PixCnt;
 	C4Rect Relights[C4LS_MaxRelights];
+	uint32_t PixHash; // sync hash of all pixels, see UpdatePixHash // NoSave //
+	C4Rect PixHashPending; // area between PrepareChange and FinishChange, which is not part of PixHash meanwhile
+	bool fPixHashPending;
 
 public:
 	void Default();
@@ -104,7 +114,7 @@ public:
 	void FindMatTop(int32_t mat, int32_t &x, int32_t &y);
 	uint8_t GetMapIndex(int32_t iX, int32_t iY);
 	bool Load(C4Group &hGroup, bool fLoadSky, bool fSavegame);
-	bool Save(C4Group &hGroup);
+	bool Save(C4Group &hGroup, std::unique_ptr<StdBitmap> *pDeferredPNG = nullptr); // if given, the PNG is left to the caller to encode
 	bool SaveDiff(C4Group &hGroup, bool fSyncSave);
 	bool SaveMap(C4Group &hGroup);
 	bool SaveInitial();
@@ -207,6 +217,7 @@ public:
 	bool ReplaceMapColor(uint8_t iOldIndex, uint8_t iNewIndex); // find every occurance of iOldIndex in map; replace it by new index
 	bool SetTextureIndex(const char *szMatTex, uint8_t iNewIndex, bool fInsert); // change color index of map texture, or insert a new one
 	void SetMapChanged() { fMapChanged = true; }
+	uint32_t GetPixHash() const { return PixHash; }
 	void HandleTexMapUpdate();
 	void UpdatePixMaps();
 	bool DoRelights();
@@ -216,11 +227,12 @@ protected:
 	void ExecuteScan();
 	int32_t DoScan(int32_t x, int32_t y, int32_t mat, int32_t dir);
 	int32_t ChunkyRandom(int32_t &iOffset, int32_t iRange); // return static random value, according to offset and MapSeed
-	void DrawChunk(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mcol, int32_t iChunkType, int32_t cro);
-	void DrawSmoothOChunk(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mcol, uint8_t flip, int32_t cro);
-	void ChunkOZoom(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, int32_t iTexture, int32_t iOffX = 0, int32_t iOffY = 0);
+	void DrawChunk(CSurface8 *sfcTarget, int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mcol, int32_t iChunkType, int32_t cro);
+	void DrawSmoothOChunk(CSurface8 *sfcTarget, int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mcol, uint8_t flip, int32_t cro);
+	void ChunkOZoom(CSurface8 *sfcTarget, CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, int32_t iTexture, int32_t iOffX = 0, int32_t iOffY = 0);
 	bool GetTexUsage(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, uint32_t *dwpTextureUsage);
 	bool TexOZoom(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, uint32_t *dwpTextureUsage, int32_t iToX = 0, int32_t iToY = 0);
+	void TexOZoomParallel(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, uint32_t *dwpTextureUsage, int32_t iToX, int32_t iToY, const C4Rect &Target, int32_t iThreadCount);
 	bool MapToSurface(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, int32_t iToX, int32_t iToY, int32_t iToWdt, int32_t iToHgt, int32_t iOffX, int32_t iOffY);
 	bool MapToLandscape(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, int32_t iOffsX = 0, int32_t iOffsY = 0); // zoom map segment to surface (or sector surfaces)
 	bool GetMapColorIndex(const char *szMaterial, const char *szTexture, bool fIFT, uint8_t &rbyCol);
@@ -229,6 +241,7 @@ protected:
 	CSurface8 *CreateMapS2(C4Group &ScenFile); // create map by def file
 	bool Relight(C4Rect To);
 	bool ApplyLighting(C4Rect To);
+	void GetPlacementRow(int32_t iY, int32_t iX, int32_t iWdt, int32_t *pOut); // placement of iWdt pixels starting at iX in row iY (bounds checked)
 	bool UpdateAnimationSurface(C4Rect To);
 	uint32_t GetClrByTex(int32_t iX, int32_t iY);
 	bool Mat2Pal(); // assign material colors to landscape palette
@@ -241,12 +254,15 @@ protected:
 
 	void UpdatePixCnt(const class C4Rect &Rect, bool fCheck = false);
 	void UpdateMatCnt(C4Rect Rect, bool fPlus);
+	void UpdatePixHash(C4Rect Rect); // toggle all pixels within rect in the sync hash
 	void PrepareChange(C4Rect BoundingBox, bool updateMatCnt = true);
 	void FinishChange(C4Rect BoundingBox, bool updateMatAndPixCnt = true);
 	static bool DrawLineLandscape(int32_t iX, int32_t iY, int32_t iGrade);
 
 public:
 	void CompileFunc(StdCompiler *pComp); // without landscape bitmaps and sky
+	void CompilePixels(StdCompiler *pComp); // raw 8 bit landscape, for binary compilers; solid masks must be removed
+	bool RelightAll() { return ApplyLighting(C4Rect{0, 0, Width, Height}); } // as after loading; for benchmarks
 };
 
 /* Some global landscape functions */
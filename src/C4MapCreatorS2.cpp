@@ -22,9 +22,26 @@
 #include <C4Random.h>
 
 #include <C4Game.h>
+#include <C4Thread.h>
 #include <C4Wrappers.h>
 
+#include <atomic>
 #include <cassert>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	// callback pixel enabled while rendering a row band in parallel
+	struct C4MCDeferredPixel
+	{
+		C4MCCallbackArray *pArray;
+		int32_t iX, iY;
+	};
+
+	// set while rendering a band in parallel; pixels are enabled afterwards in serial order
+	thread_local std::vector<C4MCDeferredPixel> *pDeferredPixels = nullptr;
+}
 
 // C4MCCallbackArray
 
@@ -48,6 +65,12 @@ C4MCCallbackArray::~C4MCCallbackArray()
 
 void C4MCCallbackArray::EnablePixel(int32_t iX, int32_t iY)
 {
+	// rendering a band in parallel? enable it later
+	if (pDeferredPixels)
+	{
+		pDeferredPixels->push_back({this, iX, iY});
+		return;
+	}
 	// array not yet created? then do that now!
 	if (!pMap)
 	{
@@ -566,6 +589,16 @@ bool C4MCOverlay::PeekPix(int32_t iX, int32_t iY)
 	return fLastSetC;
 }
 
+bool C4MCOverlay::CanRenderParallel()
+{
+	// script algorithms call into the script engine
+	if (Algorithm && SEqual(Algorithm->Identifier, "script")) return false;
+	for (C4MCNode *pChild = Child0; pChild; pChild = pChild->Next)
+		if (C4MCOverlay *pOvrl = pChild->Overlay())
+			if (!pOvrl->CanRenderParallel()) return false;
+	return true;
+}
+
 // point
 
 C4MCPoint::C4MCPoint(C4MCNode *pOwner) : C4MCNode(pOwner)
@@ -643,8 +676,30 @@ bool C4MCMap::RenderTo(uint8_t *pToBuf, int32_t iPitch)
 {
 	// set current render target
 	if (MapCreator) MapCreator->pCurrentMap = this;
+	const uint32_t iStartTime = timeGetTime();
+	// render in row bands on multiple threads, if possible
+	int32_t iThreadCount = Config.General.MapRenderThreads;
+#ifdef DEBUGREC
+	// debug records need the serial pixel order
+	iThreadCount = 1;
+#endif
+	if (iThreadCount > 1 && CanRenderParallel())
+		RenderRowsParallel(pToBuf, iPitch, iThreadCount);
+	else
+		RenderRows(pToBuf, iPitch, 0, Hgt);
+	if (Config.Graphics.VerboseObjectLoading >= 1)
+		LogF("MapCreatorS2: Rendering %dx%d map took %u ms", static_cast<int>(Wdt), static_cast<int>(Hgt), static_cast<unsigned int>(timeGetTime() - iStartTime));
+	// reset render target
+	if (MapCreator) MapCreator->pCurrentMap = nullptr;
+	// success
+	return true;
+}
+
+void C4MCMap::RenderRows(uint8_t *pToBuf, int32_t iPitch, int32_t iFromY, int32_t iToY)
+{
+	pToBuf += iFromY * iPitch;
 	// draw pixel by pixel
-	for (int32_t iY = 0; iY < Hgt; iY++)
+	for (int32_t iY = iFromY; iY < iToY; iY++)
 	{
 		for (int32_t iX = 0; iX < Wdt; iX++)
 		{
@@ -663,10 +718,37 @@ bool C4MCMap::RenderTo(uint8_t *pToBuf, int32_t iPitch)
 		// next line
 		pToBuf += iPitch - Wdt;
 	}
-	// reset render target
-	if (MapCreator) MapCreator->pCurrentMap = nullptr;
-	// success
-	return true;
+}
+
+void C4MCMap::RenderRowsParallel(uint8_t *pToBuf, int32_t iPitch, int32_t iThreadCount)
+{
+	// more bands than threads, so expensive parts of the map don't stall a single thread
+	const int32_t iBandCount = std::min<int32_t>(Hgt, iThreadCount * 8);
+	std::vector<std::vector<C4MCDeferredPixel>> BandPixels(iBandCount);
+	std::atomic<int32_t> iNextBand{0};
+	const auto RenderBands = [&]
+	{
+		for (int32_t iBand; (iBand = iNextBand.fetch_add(1, std::memory_order_relaxed)) < iBandCount; )
+		{
+			pDeferredPixels = &BandPixels[iBand];
+			RenderRows(pToBuf, iPitch, Hgt * iBand / iBandCount, Hgt * (iBand + 1) / iBandCount);
+		}
+		pDeferredPixels = nullptr;
+	};
+	// the calling thread renders, too
+	std::vector<std::thread> Threads;
+	for (int32_t i = 1; i < std::min(iThreadCount, iBandCount); ++i)
+		Threads.emplace_back([&RenderBands]
+		{
+			C4Thread::SetCurrentThreadName("MapRenderer");
+			RenderBands();
+		});
+	RenderBands();
+	for (auto &Thread : Threads) Thread.join();
+	// enable callback pixels in the same order as the serial renderer
+	for (const auto &Pixels : BandPixels)
+		for (const auto &Pixel : Pixels)
+			Pixel.pArray->EnablePixel(Pixel.iX, Pixel.iY);
 }
 
 void C4MCMap::SetSize(int32_t iWdt, int32_t iHgt)
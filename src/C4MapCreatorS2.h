@@ -286,6 +286,7 @@ public:
 	bool CheckMask(int32_t iX, int32_t iY); // check whether algorithms succeeds at iX/iY
 	bool RenderPix(int32_t iX, int32_t iY, uint8_t &rPix, C4MCTokenType eLastOp = MCT_NONE, bool fLastSet = false, bool fDraw = true, C4MCOverlay **ppPixelSetOverlay = nullptr); // render this pixel
 	bool PeekPix(int32_t iX, int32_t iY); // check mask; regard operator chain
+	bool CanRenderParallel(); // whether this overlay and its children may be rendered on multiple threads
 	bool InBounds(int32_t iX, int32_t iY) { return iX >= X && iY >= Y && iX < X + Wdt && iY < Y + Hgt; } // return whether point iX/iY is inside bounds
 
 public:
@@ -337,6 +338,10 @@ public:
 	bool RenderTo(uint8_t *pToBuf, int32_t iPitch); // render to buffer
 	void SetSize(int32_t iWdt, int32_t iHgt);
 
+protected:
+	void RenderRows(uint8_t *pToBuf, int32_t iPitch, int32_t iFromY, int32_t iToY); // render rows [iFromY, iToY)
+	void RenderRowsParallel(uint8_t *pToBuf, int32_t iPitch, int32_t iThreadCount); // render row bands on multiple threads
+
 public:
 	C4MCNodeType Type() override { return MCN_Map; } // get node type
 
@@ -22,8 +22,12 @@
 #include <C4Random.h>
 #include <C4Material.h>
 #include <C4Game.h>
+#include <C4SyncHash.h>
 #include <C4Wrappers.h>
 
+#include <algorithm>
+#include <bit>
+
 // Note: creation optimized using advancing CreatePtr, so sequential
 // creation does not keep rescanning the complete set for a free
 // slot. (This had caused extreme delays.) This had the effect that
@@ -34,6 +38,11 @@
 // a mathematical triangular shape with no delays! Since masses are
 // running slower and smoother, overall MM counts are much lower,
 // hardly ever exceeding 1000. October 1997
+//
+// Live slots are tracked in a bitmap, so execution and creation skip
+// free slots a word at a time while keeping the slot order described
+// above. Slots are allocated in chunks up to the scenario's
+// MaxMassMovers; unallocated slots count as free.
 
 C4MassMoverSet::C4MassMoverSet()
 {
@@ -45,47 +54,111 @@ C4MassMoverSet::~C4MassMoverSet()
 	Clear();
 }
 
-void C4MassMoverSet::Clear() {}
+void C4MassMoverSet::Clear()
+{
+	Chunks.clear();
+	Used.clear();
+	Count = 0;
+}
 
 void C4MassMoverSet::Execute()
 {
-	C4MassMover *cmm;
-	// Init counts
-	Count = 0;
-	// Execute & count
+	// Nothing to move
+	if (!Count) return;
+	// Execute live slots in descending order
 	for (int32_t speed = 2; speed > 0; speed--)
+		for (int32_t iSlot = FindUsedBelow(GetAllocated() - 1); iSlot >= 0; iSlot = FindUsedBelow(iSlot - 1))
+			ExecuteSlot(iSlot);
+}
+
+void C4MassMoverSet::ExecuteSlot(int32_t iSlot)
+{
+	// Chunks are never reallocated, so the mover stays in place even if it creates new ones
+	C4MassMover &rMover = Get(iSlot);
+	rMover.Execute();
+	// Ceased: free slot
+	if (rMover.Mat == MNone)
 	{
-		cmm = &(Set[C4MassMoverChunk - 1]);
-		for (int32_t cnt = 0; cnt < C4MassMoverChunk; cnt++, cmm--)
-			if (cmm->Mat != MNone)
-			{
-				Count++; cmm->Execute();
-			}
+		SetUsed(iSlot, false);
+		Count--;
 	}
 }
 
 bool C4MassMoverSet::Create(int32_t x, int32_t y, bool fExecute)
 {
-	if (Count == C4MassMoverChunk) return false;
+	const int32_t iCapacity = GetCapacity();
+	if (Count >= iCapacity) return false;
 #ifdef DEBUGREC
 	C4RCMassMover rc;
 	rc.x = x; rc.y = y;
 	AddDbgRec(RCT_MMC, &rc, sizeof(rc));
 #endif
-	int32_t cptr = CreatePtr;
-	do
+	// Next free slot after CreatePtr, wrapping around
+	int32_t iSlot = FindFree(CreatePtr + 1, iCapacity);
+	if (iSlot < 0) iSlot = FindFree(0, std::min(CreatePtr + 1, iCapacity));
+	if (iSlot < 0) return false;
+	Allocate(iSlot + 1);
+	if (!Get(iSlot).Init(x, y)) return false;
+	SetUsed(iSlot, true);
+	Count++;
+	CreatePtr = iSlot;
+	if (fExecute) ExecuteSlot(iSlot);
+	return true;
+}
+
+int32_t C4MassMoverSet::GetCapacity() const
+{
+	return std::max<int32_t>(Game.C4S.Landscape.MaxMassMovers, 0);
+}
+
+void C4MassMoverSet::SetUsed(int32_t iSlot, bool fUsed)
+{
+	const uint64_t iBit = uint64_t{1} << (iSlot % 64);
+	if (fUsed)
+		Used[iSlot / 64] |= iBit;
+	else
+		Used[iSlot / 64] &= ~iBit;
+}
+
+void C4MassMoverSet::Allocate(int32_t iSlots)
+{
+	while (GetAllocated() < iSlots)
+	{
+		auto &pChunk = Chunks.emplace_back(std::make_unique<C4MassMover[]>(C4MassMoverChunk));
+		for (int32_t cnt = 0; cnt < C4MassMoverChunk; cnt++) pChunk[cnt].Mat = MNone;
+	}
+	Used.resize((GetAllocated() + 63) / 64, 0);
+}
+
+int32_t C4MassMoverSet::FindUsedBelow(int32_t iSlot) const
+{
+	// Highest live slot <= iSlot, -1 if none
+	iSlot = std::min(iSlot, GetAllocated() - 1);
+	if (iSlot < 0) return -1;
+	int32_t iWord = iSlot / 64;
+	uint64_t iBits = Used[iWord] & (~uint64_t{0} >> (63 - iSlot % 64));
+	while (!iBits)
+	{
+		if (--iWord < 0) return -1;
+		iBits = Used[iWord];
+	}
+	return iWord * 64 + 63 - std::countl_zero(iBits);
+}
+
+int32_t C4MassMoverSet::FindFree(int32_t iFrom, int32_t iTo) const
+{
+	// Lowest free slot in [iFrom, iTo), -1 if none
+	for (int32_t iSlot = iFrom; iSlot < iTo; iSlot = (iSlot / 64 + 1) * 64)
 	{
-		cptr++;
-		if (cptr >= C4MassMoverChunk) cptr = 0;
-		if (Set[cptr].Mat == MNone)
+		if (iSlot >= GetAllocated()) return iSlot;
+		const uint64_t iFree = ~Used[iSlot / 64] & (~uint64_t{0} << (iSlot % 64));
+		if (iFree)
 		{
-			if (!Set[cptr].Init(x, y)) return false;
-			CreatePtr = cptr;
-			if (fExecute) Set[cptr].Execute();
-			return true;
+			const int32_t iFound = iSlot / 64 * 64 + std::countr_zero(iFree);
+			return iFound < iTo ? iFound : -1;
 		}
-	} while (cptr != CreatePtr);
-	return false;
+	}
+	return -1;
 }
 
 bool C4MassMover::Init(int32_t tx, int32_t ty)
@@ -96,7 +169,6 @@ bool C4MassMover::Init(int32_t tx, int32_t ty)
 	// Check mat
 	Mat = GBackMat(tx, ty);
 	x = tx; y = ty;
-	Game.MassMover.Count++;
 	return (Mat != MNone);
 }
 
@@ -107,7 +179,6 @@ void C4MassMover::Cease()
 	rc.x = x; rc.y = y;
 	AddDbgRec(RCT_MMD, &rc, sizeof(rc));
 #endif
-	Game.MassMover.Count--;
 	Mat = MNone;
 }
 
@@ -172,30 +243,28 @@ bool C4MassMover::Corrosion(int32_t dx, int32_t dy)
 
 void C4MassMoverSet::Default()
 {
-	int32_t cnt;
-	for (cnt = 0; cnt < C4MassMoverChunk; cnt++) Set[cnt].Mat = MNone;
+	Chunks.clear();
+	Used.clear();
 	Count = 0;
 	CreatePtr = 0;
 }
 
 bool C4MassMoverSet::Save(C4Group &hGroup)
 {
-	int32_t cnt;
 	// Consolidate
 	Consolidate();
-	// Recount
-	Count = 0;
-	for (cnt = 0; cnt < C4MassMoverChunk; cnt++)
-		if (Set[cnt].Mat != MNone)
-			Count++;
 	// All empty: delete component
 	if (!Count)
 	{
 		hGroup.Delete(C4CFN_MassMover);
 		return true;
 	}
-	// Save set
-	if (!hGroup.Add(C4CFN_MassMover, Set, Count * sizeof(C4MassMover)))
+	// Save set (live movers are in slots 0 to Count-1 now)
+	StdBuf Buf;
+	Buf.New(Count * sizeof(C4MassMover));
+	for (int32_t cnt = 0; cnt < Count; cnt++)
+		Buf.getMPtr<C4MassMover>(0)[cnt] = Get(cnt);
+	if (!hGroup.Add(C4CFN_MassMover, Buf, false, true))
 		return false;
 	// Success
 	return true;
@@ -211,41 +280,103 @@ bool C4MassMoverSet::Load(C4Group &hGroup)
 	if ((iBinSize % iMoverSize) != 0) return false;
 
 	// load new
-	Count = iBinSize / iMoverSize;
-	if (!hGroup.Read(Set, iBinSize)) return false;
+	const auto iLoadCount = static_cast<int32_t>(iBinSize / iMoverSize);
+	Allocate(iLoadCount);
+	for (int32_t iChunk = 0; iChunk * C4MassMoverChunk < iLoadCount; iChunk++)
+		if (!hGroup.Read(Chunks[iChunk].get(), std::min(iLoadCount - iChunk * C4MassMoverChunk, C4MassMoverChunk) * iMoverSize))
+			return false;
+	for (int32_t cnt = 0; cnt < iLoadCount; cnt++)
+		if (Get(cnt).Mat != MNone)
+		{
+			SetUsed(cnt, true);
+			Count++;
+		}
 	return true;
 }
 
-void C4MassMoverSet::Consolidate()
+void C4MassMoverSet::CompileFunc(StdCompiler *pComp)
 {
-	// Consolidate set
-	int32_t iSpot, iPtr, iConsolidated;
-	for (iSpot = -1, iPtr = 0, iConsolidated = 0; iPtr < C4MassMoverChunk; iPtr++)
+	const auto compileMover = [pComp](int32_t &iSlot, C4MassMover &rMover)
+	{
+		pComp->Value(iSlot); pComp->Separator(StdCompiler::SEP_SET);
+		pComp->Value(rMover.Mat); pComp->Separator();
+		pComp->Value(rMover.x); pComp->Separator();
+		pComp->Value(rMover.y);
+	};
+	// live movers with their slots, so execution order and slot reuse stay the same
+	pComp->Value(mkNamingAdapt(CreatePtr, "CreatePtr", 0));
+	int32_t iCount = Count;
+	pComp->Value(mkNamingAdapt(iCount, "Count", 0));
+	pComp->Separator(StdCompiler::SEP_START);
+	if (pComp->isCompiler())
 	{
-		// Empty: set new spot if needed
-		if (Set[iPtr].Mat == MNone)
+		Clear();
+		for (int32_t cnt = 0; cnt < iCount; cnt++)
 		{
-			if (iSpot == -1) iSpot = iPtr;
+			if (cnt) pComp->Separator(StdCompiler::SEP_SEP2);
+			int32_t iSlot; C4MassMover Mover;
+			compileMover(iSlot, Mover);
+			if (!Inside<int32_t>(iSlot, 0, GetCapacity() - 1) || IsUsed(iSlot))
+			{
+				pComp->excCorrupt("MassMover: invalid slot %d", static_cast<int>(iSlot)); return;
+			}
+			Allocate(iSlot + 1);
+			Get(iSlot) = Mover;
+			SetUsed(iSlot, true);
+			Count++;
 		}
-		// Full: move down to empty spot if possible
-		else if (iSpot != -1)
+	}
+	else
+	{
+		bool fFirst = true;
+		for (int32_t iSlot = 0; iSlot < GetAllocated(); iSlot++)
+			if (IsUsed(iSlot))
+			{
+				if (!fFirst) pComp->Separator(StdCompiler::SEP_SEP2);
+				compileMover(iSlot, Get(iSlot));
+				fFirst = false;
+			}
+	}
+	pComp->Separator(StdCompiler::SEP_END);
+}
+
+void C4MassMoverSet::Consolidate()
+{
+	// Move live movers down to slots 0 to Count-1, keeping their order
+	int32_t iDest = 0;
+	for (int32_t iSlot = 0; iSlot < GetAllocated(); iSlot++)
+		if (IsUsed(iSlot))
 		{
-			// Move to spot
-			Set[iSpot] = Set[iPtr];
-			Set[iPtr].Mat = MNone;
-			iConsolidated++;
-			// Advance empty spot (as far as ptr)
-			for (; iSpot < iPtr; iSpot++)
-				if (Set[iSpot].Mat == MNone)
-					break;
-			// No empty spot below ptr
-			if (iSpot == iPtr) iSpot = -1;
+			if (iSlot != iDest) Get(iDest) = Get(iSlot);
+			iDest++;
 		}
-	}
+	Count = iDest;
+	// Release chunks that are free now
+	Chunks.resize((Count + C4MassMoverChunk - 1) / C4MassMoverChunk);
+	Used.assign((GetAllocated() + 63) / 64, 0);
+	for (int32_t cnt = 0; cnt < GetAllocated(); cnt++)
+		if (cnt < Count)
+			SetUsed(cnt, true);
+		else
+			Get(cnt).Mat = MNone;
 	// Reset create ptr
 	CreatePtr = 0;
 }
 
+uint32_t C4MassMoverSet::GetSyncHash() const
+{
+	uint32_t iHash = 0;
+	for (int32_t iSlot = 0; iSlot < GetAllocated(); iSlot++)
+		if (IsUsed(iSlot))
+		{
+			const C4MassMover &rMover = Get(iSlot);
+			iHash = SyncHashAdd(iHash, rMover.Mat);
+			iHash = SyncHashAdd(iHash, rMover.x);
+			iHash = SyncHashAdd(iHash, rMover.y);
+		}
+	return iHash;
+}
+
 void C4MassMoverSet::Synchronize()
 {
 	Consolidate();
@@ -256,5 +387,10 @@ void C4MassMoverSet::Copy(C4MassMoverSet &rSet)
 	Clear();
 	Count = rSet.Count;
 	CreatePtr = rSet.CreatePtr;
-	for (int32_t cnt = 0; cnt < C4MassMoverChunk; cnt++) Set[cnt] = rSet.Set[cnt];
+	for (const auto &pChunk : rSet.Chunks)
+	{
+		auto &pCopy = Chunks.emplace_back(std::make_unique<C4MassMover[]>(C4MassMoverChunk));
+		std::copy_n(pChunk.get(), C4MassMoverChunk, pCopy.get());
+	}
+	Used = rSet.Used;
 }
@@ -22,10 +22,15 @@
 
 #include <cstdint>
 
+#include <memory>
+#include <vector>
+
+// Slots are allocated in chunks of this size, so movers never move in memory while executing
 const int32_t C4MassMoverChunk = 10000;
 
 class C4MassMoverSet;
 
+// Also the on-disk record of MassMover.c4b
 class C4MassMover
 {
 	friend class C4MassMoverSet;
@@ -40,6 +45,8 @@ protected:
 	bool Corrosion(int32_t dx, int32_t dy);
 };
 
+static_assert(sizeof(C4MassMover) == 3 * sizeof(int32_t), "MassMover.c4b record layout changed");
+
 class C4MassMoverSet
 {
 public:
@@ -47,11 +54,13 @@ public:
 	~C4MassMoverSet();
 
 public:
-	int32_t Count;
+	int32_t Count; // number of live movers
 	int32_t CreatePtr;
 
 protected:
-	C4MassMover Set[C4MassMoverChunk];
+	// Slot index is execution order (descending); slots beyond the allocated chunks are free
+	std::vector<std::unique_ptr<C4MassMover[]>> Chunks;
+	std::vector<uint64_t> Used; // one bit per allocated slot, set for live movers
 
 public:
 	void Copy(C4MassMoverSet &rSet);
@@ -62,7 +71,19 @@ public:
 	bool Create(int32_t x, int32_t y, bool fExecute = false);
 	bool Load(C4Group &hGroup);
 	bool Save(C4Group &hGroup);
+	void CompileFunc(StdCompiler *pComp); // keeps slots, unlike Save
+	int32_t GetCapacity() const;
+	uint32_t GetSyncHash() const;
 
 protected:
 	void Consolidate();
+	C4MassMover &Get(int32_t iSlot) { return Chunks[iSlot / C4MassMoverChunk][iSlot % C4MassMoverChunk]; }
+	const C4MassMover &Get(int32_t iSlot) const { return Chunks[iSlot / C4MassMoverChunk][iSlot % C4MassMoverChunk]; }
+	int32_t GetAllocated() const { return static_cast<int32_t>(Chunks.size()) * C4MassMoverChunk; }
+	bool IsUsed(int32_t iSlot) const { return iSlot < GetAllocated() && (Used[iSlot / 64] >> (iSlot % 64)) & 1; }
+	void SetUsed(int32_t iSlot, bool fUsed);
+	void Allocate(int32_t iSlots);
+	int32_t FindUsedBelow(int32_t iSlot) const;
+	int32_t FindFree(int32_t iFrom, int32_t iTo) const;
+	void ExecuteSlot(int32_t iSlot);
 };
@@ -0,0 +1,158 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Material amounts collected by an object (e.g. by digging) */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Sparse material -> amount map. Most objects never collect any material and
+// diggers rarely hold more than a few kinds at once, so the first entries are
+// stored inline and only larger sets spill to the heap.
+// Entries are kept sorted by material and never hold a zero amount.
+class C4MaterialContents
+{
+public:
+	struct Entry
+	{
+		std::int32_t Material;
+		std::int32_t Amount;
+	};
+
+private:
+	static constexpr std::size_t InlineCapacity{2};
+
+	std::array<Entry, InlineCapacity> inlineEntries{};
+	std::vector<Entry> spilledEntries; // all entries once there are more than InlineCapacity
+	std::uint32_t inlineCount{0};
+
+public:
+	void Add(std::int32_t material, std::int32_t amount)
+	{
+		if (!amount) return;
+		const auto entries = Entries();
+		const auto it = LowerBound(entries, material);
+		if (it != entries.end() && it->Material == material)
+		{
+			if (!(it->Amount += amount))
+			{
+				Erase(it - entries.begin());
+			}
+			return;
+		}
+		Insert(it - entries.begin(), {material, amount});
+	}
+
+	std::int32_t Get(std::int32_t material) const
+	{
+		const auto entries = Entries();
+		const auto it = LowerBound(entries, material);
+		return it != entries.end() && it->Material == material ? it->Amount : 0;
+	}
+
+	void Reset(std::int32_t material)
+	{
+		const auto entries = Entries();
+		if (const auto it = LowerBound(entries, material); it != entries.end() && it->Material == material)
+		{
+			Erase(it - entries.begin());
+		}
+	}
+
+	// smallest material with a non-zero amount that is greater than the given one, -1 if none
+	std::int32_t NextMaterial(std::int32_t material) const
+	{
+		const auto entries = Entries();
+		const auto it = LowerBound(entries, material + 1);
+		return it != entries.end() ? it->Material : -1;
+	}
+
+	void Clear()
+	{
+		inlineCount = 0;
+		spilledEntries.clear();
+		spilledEntries.shrink_to_fit();
+	}
+
+	bool IsEmpty() const { return Entries().empty(); }
+
+private:
+	bool IsSpilled() const { return !spilledEntries.empty(); }
+
+	std::span<Entry> Entries()
+	{
+		return IsSpilled() ? std::span<Entry>{spilledEntries} : std::span<Entry>{inlineEntries.data(), inlineCount};
+	}
+
+	std::span<const Entry> Entries() const
+	{
+		return IsSpilled() ? std::span<const Entry>{spilledEntries} : std::span<const Entry>{inlineEntries.data(), inlineCount};
+	}
+
+	template<typename T>
+	static typename std::span<T>::iterator LowerBound(std::span<T> entries, std::int32_t material)
+	{
+		return std::lower_bound(entries.begin(), entries.end(), material, [](const Entry &entry, std::int32_t mat) { return entry.Material < mat; });
+	}
+
+	void Insert(std::size_t index, Entry entry)
+	{
+		if (IsSpilled())
+		{
+			spilledEntries.insert(spilledEntries.begin() + index, entry);
+		}
+		else if (inlineCount < InlineCapacity)
+		{
+			std::copy_backward(inlineEntries.begin() + index, inlineEntries.begin() + inlineCount, inlineEntries.begin() + inlineCount + 1);
+			inlineEntries[index] = entry;
+			++inlineCount;
+		}
+		else
+		{
+			// spill
+			spilledEntries.reserve(2 * InlineCapacity);
+			spilledEntries.assign(inlineEntries.begin(), inlineEntries.end());
+			spilledEntries.insert(spilledEntries.begin() + index, entry);
+			inlineCount = 0;
+		}
+	}
+
+	void Erase(std::size_t index)
+	{
+		if (IsSpilled())
+		{
+			spilledEntries.erase(spilledEntries.begin() + index);
+			// move back inline once small enough
+			if (spilledEntries.size() <= InlineCapacity)
+			{
+				inlineCount = static_cast<std::uint32_t>(spilledEntries.size());
+				std::copy(spilledEntries.begin(), spilledEntries.end(), inlineEntries.begin());
+				spilledEntries.clear();
+				spilledEntries.shrink_to_fit();
+			}
+		}
+		else
+		{
+			std::copy(inlineEntries.begin() + index + 1, inlineEntries.begin() + inlineCount, inlineEntries.begin() + index);
+			--inlineCount;
+		}
+	}
+};
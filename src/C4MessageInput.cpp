@@ -30,6 +30,8 @@
 #include <C4Log.h>
 #include <C4Player.h>
 #include <C4GameLobby.h>
+#include <C4Profiler.h>
+#include <C4SaveState.h>
 
 // C4ChatInputDialog
 
@@ -451,6 +453,10 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 		LogF("/fast [x] - %s", LoadResStr("IDS_TEXT_SETTOFASTMODESKIPPINGXFRA"));
 		LogF("/slow - %s", LoadResStr("IDS_TEXT_SETTONORMALSPEEDMODE"));
 		LogF("/chart - %s", LoadResStr("IDS_TEXT_DISPLAYNETWORKSTATISTICS"));
+		LogF("/profile [file] - %s", LoadResStr("IDS_TEXT_STARTORSTOPTHEFRAMEPROFI"));
+		LogF("/quicksave [bench] - %s", LoadResStr("IDS_TEXT_SAVETHEROUNDINMEMORY"));
+		LogF("/quickload - %s", LoadResStr("IDS_TEXT_RESTORETHELASTQUICKSAVE"));
+		LogF("/seek [frame] - %s", LoadResStr("IDS_TEXT_JUMPTOAFRAMEOFTHEREPLAY"));
 		LogF("/nodebug - %s", LoadResStr("IDS_TEXT_PREVENTDEBUGMODEINTHISROU"));
 		LogF("/set comment [comment] - %s", LoadResStr("IDS_TEXT_SETANEWNETWORKCOMMENT"));
 		LogF("/set password [password] - %s", LoadResStr("IDS_TEXT_SETANEWNETWORKPASSWORD"));
@@ -696,6 +702,81 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 	if (Game.IsRunning) if (SEqual(szCmdName, "chart"))
 		return Game.ToggleChart();
 
+	// frame profiler
+	if (SEqual(szCmdName, "profile"))
+	{
+		if (!C4Profiler::IsEnabled())
+		{
+			C4Profiler::Start();
+			Log(LoadResStr("IDS_MSG_PROFILERSTARTED"));
+			return true;
+		}
+		C4Profiler::Stop();
+		const char *szFilename = *pCmdPar ? pCmdPar : C4CFN_Profile;
+		if (!C4Profiler::Export(szFilename))
+		{
+			LogF(LoadResStr("IDS_ERR_PROFILERSAVE"), szFilename);
+			return false;
+		}
+		LogF(LoadResStr("IDS_MSG_PROFILERSAVED"), szFilename);
+		return true;
+	}
+
+	// in-memory save states
+	if (SEqual(szCmdName, "quicksave") || SEqual(szCmdName, "quickload"))
+	{
+		if (!Game.IsRunning) return false;
+		// restoring would desync other clients and records
+		if (Game.Network.isEnabled() || Game.Control.isReplay() || Game.Control.isRecord() || Game.Parameters.isLeague())
+		{
+			Log(LoadResStr("IDS_ERR_QUICKSAVEDISABLED"));
+			return false;
+		}
+		if (SEqual(szCmdName, "quicksave"))
+		{
+			if (SEqual(pCmdPar, "bench"))
+			{
+				C4SaveState::Benchmark();
+				return true;
+			}
+			auto pState = std::make_unique<C4SaveState>();
+			if (!pState->Capture())
+			{
+				Log(LoadResStr("IDS_ERR_QUICKSAVE"));
+				return false;
+			}
+			LogF(LoadResStr("IDS_MSG_QUICKSAVED"), static_cast<int>(Game.FrameCounter), static_cast<int>(pState->GetSize() / 1024));
+			Game.LastSaveState = std::move(pState);
+			return true;
+		}
+		if (!Game.LastSaveState)
+		{
+			Log(LoadResStr("IDS_ERR_NOQUICKSAVE"));
+			return false;
+		}
+		if (!Game.LastSaveState->Restore())
+		{
+			Log(LoadResStr("IDS_ERR_QUICKLOAD"));
+			return false;
+		}
+		LogF(LoadResStr("IDS_MSG_QUICKLOADED"), static_cast<int>(Game.FrameCounter));
+		return true;
+	}
+
+	// replay seeking
+	if (SEqual(szCmdName, "seek"))
+	{
+		if (!Game.IsRunning || !Game.Control.isReplay()) return false;
+		const int32_t iFrame = atoi(pCmdPar);
+		if (!Game.Control.SeekReplay(iFrame))
+		{
+			LogF(LoadResStr("IDS_ERR_REPLAYSEEK"), static_cast<int>(iFrame));
+			return false;
+		}
+		LogF(LoadResStr("IDS_MSG_REPLAYSEEKED"), static_cast<int>(Game.FrameCounter));
+		return true;
+	}
+
 	// custom command
 	if (Game.IsRunning && GetCommand(szCmdName))
 	{
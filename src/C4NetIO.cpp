@@ -50,6 +50,11 @@
 
 #endif
 
+#ifdef USE_EPOLL
+#include <array>
+#include <sys/epoll.h>
+#endif
+
 // These are named differently on mac.
 #if !defined(IPV6_ADD_MEMBERSHIP) && defined(IPV6_JOIN_GROUP)
 #define IPV6_ADD_MEMBERSHIP IPV6_JOIN_GROUP
@@ -59,6 +64,11 @@
 #ifdef __linux__
 #include <linux/in6.h>
 #include <linux/if_addr.h>
+#include <netinet/udp.h>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103 // not defined by older C libraries
+#endif
 
 // Linux definitions needed for parsing /proc/if_inet6
 #define IPV6_ADDR_LOOPBACK  0x0010U
@@ -69,6 +79,7 @@
 #include <algorithm>
 #include <cinttypes>
 #include <functional>
+#include <string_view>
 #include <utility>
 
 // constants definition
@@ -613,6 +624,17 @@ bool C4NetIO::HostAddress::operator==(const HostAddress &rhs) const
 	return false;
 }
 
+std::size_t C4NetIO::EndpointAddress::GetHash() const
+{
+	// IPv4 addresses compare equal to their IPv6-mapped counterparts, so only the latter are hashed
+	const EndpointAddress v6Addr{gen.sa_family == AF_INET ? AsIPv6() : *this};
+	char data[sizeof(v6.sin6_addr) + sizeof(v6.sin6_port) + sizeof(v6.sin6_scope_id)];
+	std::memcpy(data, &v6Addr.v6.sin6_addr, sizeof(v6.sin6_addr));
+	std::memcpy(data + sizeof(v6.sin6_addr), &v6Addr.v6.sin6_port, sizeof(v6.sin6_port));
+	std::memcpy(data + sizeof(v6.sin6_addr) + sizeof(v6.sin6_port), &v6Addr.v6.sin6_scope_id, sizeof(v6.sin6_scope_id));
+	return std::hash<std::string_view>{}({data, sizeof(data)});
+}
+
 bool C4NetIO::EndpointAddress::operator==(const addr_t &rhs) const
 {
 	if (!HostAddress::operator==(rhs)) return false;
@@ -915,11 +937,17 @@ C4NetIOTCP::C4NetIOTCP()
 #endif
 	PeerListCSec(this),
 	iListenPort(~0), lsock(INVALID_SOCKET),
+#ifdef USE_EPOLL
+	EpollFD(epoll_create1(EPOLL_CLOEXEC)),
+#endif
 	pCB(nullptr) {}
 
 C4NetIOTCP::~C4NetIOTCP()
 {
 	Close();
+#ifdef USE_EPOLL
+	if (EpollFD >= 0) close(EpollFD);
+#endif
 }
 
 bool C4NetIOTCP::Init(uint16_t iPort)
@@ -950,6 +978,20 @@ bool C4NetIOTCP::Init(uint16_t iPort)
 	}
 #endif
 
+#ifdef USE_EPOLL
+	if (EpollFD < 0)
+	{
+		SetError("could not create epoll instance");
+		return false;
+	}
+
+	// the pipe is drained completely on every wakeup, and UnBlock must never block
+	fcntl(Pipe[0], F_SETFL, fcntl(Pipe[0], F_GETFL) | O_NONBLOCK);
+	fcntl(Pipe[1], F_SETFL, fcntl(Pipe[1], F_GETFL) | O_NONBLOCK);
+	if (!EpollAdd(Pipe[0], EPOLLIN, nullptr))
+		return false;
+#endif
+
 	// create listen socket (if necessary)
 	if (iPort != addr_t::IPPORT_NONE)
 		if (!Listen(iPort))
@@ -1022,6 +1064,98 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 	// security
 	if (!fInit) return false;
 
+#ifdef USE_EPOLL
+	std::array<epoll_event, 64> events;
+	int iTimeout = (iMaxTime == C4NetIO::TO_INF ? -1 : iMaxTime);
+	// sockets are edge triggered, so a failure must not leave the rest of the events unhandled
+	bool fSuccess = true;
+	for (;;)
+	{
+		// wait for something to happen
+		const int ret = epoll_wait(EpollFD, events.data(), static_cast<int>(events.size()), iTimeout);
+
+		// error
+		if (ret < 0)
+		{
+			if (errno == EINTR) return fSuccess;
+			SetError("epoll_wait failed", true);
+			return false;
+		}
+
+		// waited without the lock, so peers and connect waits of the events may have been deleted meanwhile;
+		// keep the remaining ones from being deleted while the batch is handled
+		CStdShareLock PeerListLock(&PeerListCSec);
+
+		for (int i = 0; i < ret; ++i)
+		{
+			void *const pData = events[i].data.ptr;
+
+			// pipe? flush
+			if (!pData)
+			{
+				char buf[64];
+				while (::read(Pipe[0], buf, sizeof(buf)) > 0);
+				continue;
+			}
+
+			// listen socket? accept all waiting connections
+			if (pData == &lsock)
+			{
+				while (lsock != INVALID_SOCKET)
+					if (!Accept())
+					{
+						if (HaveWouldBlockError()) break;
+						// only this connection failed, keep accepting the others
+						fSuccess = false;
+						// out of descriptors or memory: retrying won't help until the next connection comes in
+						if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) break;
+					}
+				continue;
+			}
+
+			// waited-for connection?
+			ConnectWait *pWait = pConnectWaits;
+			while (pWait && pWait != pData)
+				pWait = pWait->Next;
+			if (pWait)
+			{
+				if (pWait->sock != INVALID_SOCKET)
+				{
+					// remove from list
+					SOCKET sock = pWait->sock; pWait->sock = INVALID_SOCKET;
+					epoll_ctl(EpollFD, EPOLL_CTL_DEL, sock, nullptr);
+					if (!OnConnected(sock, pWait->addr))
+						fSuccess = false;
+				}
+				continue;
+			}
+
+			// connected socket (events for peers deleted or closed meanwhile are stale)
+			Peer *pPeer = pPeerList;
+			while (pPeer && pPeer != pData)
+				pPeer = pPeer->Next;
+			if (!pPeer || !pPeer->Open())
+				continue;
+
+			// something to read from socket, or closed?
+			if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+				Receive(pPeer);
+
+			// socket has become writeable?
+			if (pPeer->Open() && (events[i].events & EPOLLOUT))
+				// send remaining data
+				pPeer->Send();
+		}
+
+		// more events pending?
+		if (ret < static_cast<int>(events.size()))
+			break;
+		iTimeout = 0;
+	}
+
+	return fSuccess;
+#else
+
 #ifdef _WIN32
 	// wait for something to happen
 	if (WaitForSingleObject(Event, iMaxTime == C4NetIO::TO_INF ? INFINITE : iMaxTime) == WAIT_TIMEOUT)
@@ -1123,25 +1257,13 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 					if (pCB) pCB->OnDisconn(pWait->addr, this, GetSocketErrorMsg(wsaEvents.iErrorCode[FD_CONNECT_BIT]));
 				}
 				else
-#else
-				// get error code
-				int iErrCode; socklen_t iErrCodeLen = sizeof(iErrCode);
-				if (getsockopt(sock, SOL_SOCKET, SO_ERROR, reinterpret_cast<char *>(&iErrCode), &iErrCodeLen) != 0)
-				{
-					close(sock);
-					if (pCB) pCB->OnDisconn(pWait->addr, this, GetSocketErrorMsg());
-				}
-				// error?
-				else if (iErrCode)
-				{
-					close(sock);
-					if (pCB) pCB->OnDisconn(pWait->addr, this, GetSocketErrorMsg(iErrCode));
-				}
-				else
-#endif
 					// accept connection, do callback
 					if (!Accept(sock, pWait->addr))
 						return false;
+#else
+				if (!OnConnected(sock, pWait->addr))
+					return false;
+#endif
 			}
 		}
 	}
@@ -1150,70 +1272,25 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 	for (Peer *pPeer = pPeerList; pPeer; pPeer = pPeer->Next)
 		if (pPeer->Open())
 		{
-			SOCKET sock = pPeer->GetSocket();
-
 #ifdef _WIN32
 			// get event list
-			if (::WSAEnumNetworkEvents(sock, nullptr, &wsaEvents) == SOCKET_ERROR)
+			if (::WSAEnumNetworkEvents(pPeer->GetSocket(), nullptr, &wsaEvents) == SOCKET_ERROR)
 				return false;
 
 			// something to read from socket?
 			if (wsaEvents.lNetworkEvents & FD_READ)
 #else
 			// something to read from socket?
-			if (FD_ISSET(sock, &fds[0]))
-#endif
-				for (;;)
-				{
-					// how much?
-#ifdef _WIN32
-					DWORD iBytesToRead;
-#else
-					int iBytesToRead;
+			if (FD_ISSET(pPeer->GetSocket(), &fds[0]))
 #endif
-					if (::ioctlsocket(sock, FIONREAD, &iBytesToRead) == SOCKET_ERROR)
-					{
-						pPeer->Close();
-						if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, GetSocketErrorMsg());
-						break;
-					}
-					// The following two lines of code will make sure that if the variable
-					// "iBytesToRead" is zero, it will be increased by one.
-					// In this case, it will hold the value 1 after the operation.
-					// Note it doesn't do anything for negative values.
-					// (This comment has been sponsored by Sven2)
-					if (!iBytesToRead)
-						++iBytesToRead;
-					// get buffer
-					void *pBuf = pPeer->GetRecvBuf(iBytesToRead);
-					// read a buffer full of data from socket
-					int iBytesRead;
-					if ((iBytesRead = ::recv(sock, reinterpret_cast<char *>(pBuf), iBytesToRead, 0)) == SOCKET_ERROR)
-					{
-						// Would block? Ok, let's try this again later
-						if (HaveWouldBlockError()) { ResetSocketError(); break; }
-						// So he's serious after all...
-						pPeer->Close();
-						if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, GetSocketErrorMsg());
-						break;
-					}
-					// nothing? this means the conection was closed, if you trust in linux manpages.
-					if (!iBytesRead)
-					{
-						pPeer->Close();
-						if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, "connection closed");
-						break;
-					}
-					// pass to Peer::OnRecv
-					pPeer->OnRecv(iBytesRead);
-				}
+				Receive(pPeer);
 
 #ifdef _WIN32
 			// socket has become writeable?
 			if (wsaEvents.lNetworkEvents & FD_WRITE)
 #else
 			// socket has become writeable?
-			if (FD_ISSET(sock, &fds[1]))
+			if (FD_ISSET(pPeer->GetSocket(), &fds[1]))
 #endif
 				// send remaining data
 				pPeer->Send();
@@ -1233,8 +1310,85 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 
 	// done
 	return true;
+#endif
+}
+
+void C4NetIOTCP::Receive(Peer *pPeer) // (mt-safe)
+{
+	SOCKET sock = pPeer->GetSocket();
+	// read until the socket would block
+	for (;;)
+	{
+		// how much?
+#ifdef _WIN32
+		DWORD iBytesToRead;
+#else
+		int iBytesToRead;
+#endif
+		if (::ioctlsocket(sock, FIONREAD, &iBytesToRead) == SOCKET_ERROR)
+		{
+			pPeer->Close();
+			if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, GetSocketErrorMsg());
+			break;
+		}
+		// The following two lines of code will make sure that if the variable
+		// "iBytesToRead" is zero, it will be increased by one.
+		// In this case, it will hold the value 1 after the operation.
+		// Note it doesn't do anything for negative values.
+		// (This comment has been sponsored by Sven2)
+		if (!iBytesToRead)
+			++iBytesToRead;
+		// get buffer
+		void *pBuf = pPeer->GetRecvBuf(iBytesToRead);
+		// read a buffer full of data from socket
+		int iBytesRead;
+		if ((iBytesRead = ::recv(sock, reinterpret_cast<char *>(pBuf), iBytesToRead, 0)) == SOCKET_ERROR)
+		{
+			// Would block? Ok, let's try this again later
+			if (HaveWouldBlockError()) { ResetSocketError(); break; }
+			// So he's serious after all...
+			pPeer->Close();
+			if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, GetSocketErrorMsg());
+			break;
+		}
+		// nothing? this means the conection was closed, if you trust in linux manpages.
+		if (!iBytesRead)
+		{
+			pPeer->Close();
+			if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, "connection closed");
+			break;
+		}
+		// pass to Peer::OnRecv
+		pPeer->OnRecv(iBytesRead);
+	}
+}
+
+#ifndef _WIN32
+
+bool C4NetIOTCP::OnConnected(SOCKET sock, const addr_t &addr) // (mt-safe)
+{
+	// get error code
+	int iErrCode; socklen_t iErrCodeLen = sizeof(iErrCode);
+	if (getsockopt(sock, SOL_SOCKET, SO_ERROR, reinterpret_cast<char *>(&iErrCode), &iErrCodeLen) != 0)
+	{
+		close(sock);
+		if (pCB) pCB->OnDisconn(addr, this, GetSocketErrorMsg());
+	}
+	// error?
+	else if (iErrCode)
+	{
+		close(sock);
+		if (pCB) pCB->OnDisconn(addr, this, GetSocketErrorMsg(iErrCode));
+	}
+	else
+		// accept connection, do callback
+		if (!Accept(sock, addr))
+			return false;
+	return true;
 }
 
+#endif
+
 C4NetIOTCP::Socket::~Socket()
 {
 	if (sock != INVALID_SOCKET)
@@ -1438,6 +1592,11 @@ HANDLE C4NetIOTCP::GetEvent() // (mt-safe)
 
 void C4NetIOTCP::GetFDs(fd_set *pFDs, int *pMaxFD)
 {
+#ifdef USE_EPOLL
+	// everything is watched by the epoll instance
+	assert(!FD_ISSET(EpollFD, &pFDs[0]));
+	FD_SET(EpollFD, &pFDs[0]); if (pMaxFD) *pMaxFD = std::max<int>(*pMaxFD, EpollFD);
+#else
 	// add pipe
 	assert(!FD_ISSET(Pipe[0], &pFDs[0]));
 	FD_SET(Pipe[0], &pFDs[0]); if (pMaxFD) *pMaxFD = std::max<SOCKET>(*pMaxFD, Pipe[0]);
@@ -1469,6 +1628,7 @@ void C4NetIOTCP::GetFDs(fd_set *pFDs, int *pMaxFD)
 			}
 			if (pMaxFD) *pMaxFD = std::max<int>(*pMaxFD, pPeer->GetSocket());
 		}
+#endif
 }
 
 #endif
@@ -1518,6 +1678,10 @@ C4NetIOTCP::Peer *C4NetIOTCP::Accept(SOCKET nsock, const addr_t &ConnectAddr) //
 		// accept from listener
 		if ((nsock = ::accept(lsock, &addr, &addrSize)) == INVALID_SOCKET)
 		{
+#ifdef USE_EPOLL
+			// all waiting connections accepted (listen socket is non-blocking)
+			if (HaveWouldBlockError()) return nullptr;
+#endif
 			// set error
 			SetError("socket accept failed", true);
 			return nullptr;
@@ -1580,6 +1744,15 @@ C4NetIOTCP::Peer *C4NetIOTCP::Accept(SOCKET nsock, const addr_t &ConnectAddr) //
 	// create new peer
 	Peer *pnPeer = new Peer(addr, nsock, this);
 
+#ifdef USE_EPOLL
+	// watch for data and writeability
+	if (!EpollAdd(nsock, EPOLLIN | EPOLLOUT | EPOLLRDHUP, pnPeer))
+	{
+		delete pnPeer;
+		return nullptr;
+	}
+#endif
+
 	// get required locks to add item to list
 	CStdShareLock PeerListLock(&PeerListCSec);
 	CStdLock PeerListAddLock(&PeerListAddCSec);
@@ -1587,6 +1760,7 @@ C4NetIOTCP::Peer *C4NetIOTCP::Accept(SOCKET nsock, const addr_t &ConnectAddr) //
 	// add to list
 	pnPeer->Next = pPeerList;
 	pPeerList = pnPeer;
+	PeerAddrs.Add(pnPeer->GetAddr(), pnPeer);
 
 	// clear add-lock
 	PeerListAddLock.Clear();
@@ -1653,6 +1827,21 @@ bool C4NetIOTCP::Listen(uint16_t inListenPort)
 		return false;
 	}
 
+#ifdef USE_EPOLL
+	// disable blocking, so Execute can accept until the queue is empty
+	if (::fcntl(lsock, F_SETFL, fcntl(lsock, F_GETFL) | O_NONBLOCK) == SOCKET_ERROR)
+	{
+		SetError("could not disable blocking for listen socket", true);
+		closesocket(lsock); lsock = INVALID_SOCKET;
+		return false;
+	}
+	if (!EpollAdd(lsock, EPOLLIN, &lsock))
+	{
+		closesocket(lsock); lsock = INVALID_SOCKET;
+		return false;
+	}
+#endif
+
 	// ok
 	iListenPort = inListenPort;
 	return true;
@@ -1661,11 +1850,7 @@ bool C4NetIOTCP::Listen(uint16_t inListenPort)
 C4NetIOTCP::Peer *C4NetIOTCP::GetPeer(const addr_t &addr) // (mt-safe)
 {
 	CStdShareLock PeerListLock(&PeerListCSec);
-	for (Peer *pPeer = pPeerList; pPeer; pPeer = pPeer->Next)
-		if (pPeer->Open())
-			if (pPeer->GetAddr() == addr)
-				return pPeer;
-	return nullptr;
+	return PeerAddrs.Find(addr, [](Peer *pPeer) { return pPeer->Open(); });
 }
 
 void C4NetIOTCP::OnShareFree(CStdCSecEx *pCSec)
@@ -1683,6 +1868,7 @@ void C4NetIOTCP::OnShareFree(CStdCSecEx *pCSec)
 				Peer *pDelete = pPeer;
 				pPeer = pPeer->Next;
 				(pLast ? pLast->Next : pPeerList) = pPeer;
+				PeerAddrs.Remove(pDelete->GetAddr(), pDelete);
 				// delete
 				delete pDelete;
 			}
@@ -1725,12 +1911,36 @@ void C4NetIOTCP::AddConnectWait(SOCKET sock, const addr_t &addr) // (mt-safe)
 	pnWait->sock = sock; pnWait->addr = addr;
 	pnWait->Next = pConnectWaits;
 	pConnectWaits = pnWait;
-#ifndef _WIN32
+#ifdef USE_EPOLL
+	// wait for the socket to become writeable
+	if (!EpollAdd(sock, EPOLLOUT, pnWait))
+	{
+		closesocket(pnWait->sock); pnWait->sock = INVALID_SOCKET;
+		if (pCB) pCB->OnDisconn(addr, this, GetError());
+	}
+#elif !defined(_WIN32)
 	// unblock, so new FD can be realized
 	UnBlock();
 #endif
 }
 
+#ifdef USE_EPOLL
+
+bool C4NetIOTCP::EpollAdd(SOCKET sock, uint32_t iEvents, void *pData)
+{
+	epoll_event event{};
+	event.events = iEvents | EPOLLET;
+	event.data.ptr = pData;
+	if (epoll_ctl(EpollFD, EPOLL_CTL_ADD, sock, &event) != 0)
+	{
+		SetError("could not add socket to epoll instance", true);
+		return false;
+	}
+	return true;
+}
+
+#endif
+
 C4NetIOTCP::ConnectWait *C4NetIOTCP::GetConnectWait(const addr_t &addr) // (mt-safe)
 {
 	CStdShareLock PeerListLock(&PeerListCSec);
@@ -1854,7 +2064,7 @@ bool C4NetIOTCP::Peer::Send() // (mt-safe)
 		// Shrink buffer
 		OBuf.Move(iBytesSent, OBuf.getSize() - iBytesSent);
 		OBuf.Shrink(iBytesSent);
-#ifndef _WIN32
+#if !defined(_WIN32) && !defined(USE_EPOLL)
 		// Unblock parent so the FD-list can be refreshed
 		pParent->UnBlock();
 #endif
@@ -2180,6 +2390,13 @@ bool C4NetIOSimpleUDP::Execute(int iMaxTime)
 	// read packets from socket
 	for (;;)
 	{
+#ifdef __linux__
+		// read as many datagrams as possible per syscall; errors are left to the single datagram path below
+		const BatchResult eBR{ReceiveBatch()};
+		if (eBR == BR_Error) return false;
+		if (eBR == BR_Drained) break;
+		if (eBR == BR_Received) continue;
+#endif
 		// how much can be read?
 #ifdef _WIN32
 		u_long iMaxMsgSize;
@@ -2264,6 +2481,171 @@ bool C4NetIOSimpleUDP::Broadcast(const C4NetIOPacket &rPacket)
 	return C4NetIOSimpleUDP::Send(C4NetIOPacket(rPacket.getRef(), MCAddr));
 }
 
+#ifdef __linux__
+
+namespace
+{
+	constexpr std::size_t C4NetIOMaxBatchReceive{16};
+	constexpr std::size_t C4NetIOMaxBatchSend{64}; // also the maximum number of segments the kernel accepts
+	constexpr std::size_t C4NetIOMaxDatagramSize{65536};
+	constexpr std::size_t C4NetIOMaxSegmentedSize{60000}; // stays below the IP packet size limit including headers
+}
+
+C4NetIOSimpleUDP::BatchResult C4NetIOSimpleUDP::ReceiveBatch()
+{
+	// datagrams might be as large as the protocol allows, so every slot has to be able to hold one
+	if (BatchReceiveBuffer.empty())
+		BatchReceiveBuffer.resize(C4NetIOMaxBatchReceive * C4NetIOMaxDatagramSize);
+
+	mmsghdr Msgs[C4NetIOMaxBatchReceive];
+	iovec Vecs[C4NetIOMaxBatchReceive];
+	addr_t SrcAddrs[C4NetIOMaxBatchReceive];
+	for (std::size_t i = 0; i < C4NetIOMaxBatchReceive; ++i)
+	{
+		Vecs[i] = {BatchReceiveBuffer.data() + i * C4NetIOMaxDatagramSize, C4NetIOMaxDatagramSize};
+		Msgs[i] = {};
+		Msgs[i].msg_hdr.msg_name = static_cast<sockaddr *>(&SrcAddrs[i]);
+		Msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in6);
+		Msgs[i].msg_hdr.msg_iov = &Vecs[i];
+		Msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	const int iCount{::recvmmsg(sock, Msgs, C4NetIOMaxBatchReceive, MSG_DONTWAIT, nullptr)};
+	if (iCount == SOCKET_ERROR)
+		return HaveWouldBlockError() ? BR_Drained : BR_Fallback;
+
+	for (int i = 0; i < iCount; ++i)
+	{
+		const msghdr &Hdr{Msgs[i].msg_hdr};
+		// invalid address?
+		if ((Hdr.msg_namelen != sizeof(sockaddr_in) && Hdr.msg_namelen != sizeof(sockaddr_in6)) || SrcAddrs[i].GetFamily() == addr_t::UnknownFamily)
+		{
+			SetError("recvmmsg returned an invalid address");
+			return BR_Error;
+		}
+		// empty datagrams carry nothing of interest
+		if (!Msgs[i].msg_len) continue;
+		// callback
+		if (pCB) pCB->OnPacket(C4NetIOPacket(Vecs[i].iov_base, Msgs[i].msg_len, true, SrcAddrs[i]), this);
+	}
+
+	// a partially filled batch means the socket has been drained
+	return static_cast<std::size_t>(iCount) < C4NetIOMaxBatchReceive ? BR_Drained : BR_Received;
+}
+
+#endif
+
+bool C4NetIOSimpleUDP::SendBatch(std::span<const C4NetIOPacket> packets) // (mt-safe)
+{
+	if (!fInit) { SetError("not yet initialized"); return false; }
+
+	// a failed message doesn't keep the others from being sent; the first error is reported
+	bool fSuccess{true};
+	StdStrBuf FirstError;
+	const auto sendFailed = [this, &fSuccess, &FirstError]
+	{
+		if (fSuccess) FirstError.Copy(GetError());
+		fSuccess = false;
+	};
+
+#ifdef __linux__
+	while (!packets.empty())
+	{
+		mmsghdr Msgs[C4NetIOMaxBatchSend];
+		iovec Vecs[C4NetIOMaxBatchSend];
+		addr_t Addrs[C4NetIOMaxBatchSend];
+		alignas(cmsghdr) char Control[C4NetIOMaxBatchSend][CMSG_SPACE(sizeof(std::uint16_t))];
+		std::size_t iMsgPackets[C4NetIOMaxBatchSend];
+		std::size_t iMsgSize[C4NetIOMaxBatchSend];
+
+		// one packet per message; with segmentation offload, runs of full-sized packets to the same address
+		// (followed by at most one smaller one) are gathered into a single message and split by the kernel
+		const bool fSegment{fSegmentationOffload.load(std::memory_order_relaxed)};
+		std::size_t iPackets{0}, iMsgs{0};
+		for (; iPackets < packets.size() && iPackets < C4NetIOMaxBatchSend; ++iPackets)
+		{
+			const C4NetIOPacket &Pkt{packets[iPackets]};
+			Vecs[iPackets] = {const_cast<void *>(Pkt.getData()), Pkt.getSize()};
+			if (fSegment && iMsgs)
+			{
+				const std::size_t iLast{iMsgs - 1};
+				const std::size_t iSegmentSize{Vecs[iPackets - iMsgPackets[iLast]].iov_len};
+				if (Pkt.getSize() && Pkt.getSize() <= iSegmentSize && Vecs[iPackets - 1].iov_len == iSegmentSize &&
+					iMsgSize[iLast] + Pkt.getSize() <= C4NetIOMaxSegmentedSize && Pkt.getAddr() == Addrs[iLast])
+				{
+					++iMsgPackets[iLast];
+					iMsgSize[iLast] += Pkt.getSize();
+					continue;
+				}
+			}
+			Addrs[iMsgs] = Pkt.getAddr();
+			iMsgPackets[iMsgs] = 1;
+			iMsgSize[iMsgs] = Pkt.getSize();
+			++iMsgs;
+		}
+
+		for (std::size_t i = 0, iVec = 0; i < iMsgs; iVec += iMsgPackets[i++])
+		{
+			Msgs[i] = {};
+			msghdr &Hdr{Msgs[i].msg_hdr};
+			Hdr.msg_name = static_cast<sockaddr *>(&Addrs[i]);
+			Hdr.msg_namelen = Addrs[i].GetAddrLen();
+			Hdr.msg_iov = &Vecs[iVec];
+			Hdr.msg_iovlen = iMsgPackets[i];
+			if (iMsgPackets[i] > 1)
+			{
+				Hdr.msg_control = Control[i];
+				Hdr.msg_controllen = sizeof(Control[i]);
+				cmsghdr *const pCMsg{CMSG_FIRSTHDR(&Hdr)};
+				pCMsg->cmsg_level = IPPROTO_UDP;
+				pCMsg->cmsg_type = UDP_SEGMENT;
+				pCMsg->cmsg_len = CMSG_LEN(sizeof(std::uint16_t));
+				const auto iSegmentSize = static_cast<std::uint16_t>(Vecs[iVec].iov_len);
+				std::memcpy(CMSG_DATA(pCMsg), &iSegmentSize, sizeof(iSegmentSize));
+			}
+		}
+
+		// send it
+		for (std::size_t iSent = 0, iVec = 0; iSent < iMsgs; )
+		{
+			const int iResult{::sendmmsg(sock, Msgs + iSent, iMsgs - iSent, 0)};
+			if (iResult != SOCKET_ERROR)
+			{
+				for (const std::size_t iEnd{iSent + iResult}; iSent < iEnd; ) iVec += iMsgPackets[iSent++];
+				continue;
+			}
+			if (iMsgPackets[iSent] > 1 && !HaveWouldBlockError())
+			{
+				// segmentation offload isn't available for this socket or route: send this run one by one and don't try again
+				fSegmentationOffload = false;
+				for (std::size_t i = 0; i < iMsgPackets[iSent]; ++i)
+					if (!C4NetIOSimpleUDP::Send(packets[iVec + i])) sendFailed();
+			}
+			else if (!HaveWouldBlockError())
+			{
+				SetError("socket sendmmsg failed", true);
+				sendFailed();
+			}
+			// would block or failed: skip the message, just like Send does
+			iVec += iMsgPackets[iSent++];
+		}
+
+		packets = packets.subspan(iPackets);
+	}
+#else
+	for (const auto &Pkt : packets)
+		if (!C4NetIOSimpleUDP::Send(Pkt)) sendFailed();
+#endif
+
+	if (!fSuccess)
+	{
+		SetError(FirstError.getData());
+		return false;
+	}
+	ResetError();
+	return true;
+}
+
 #ifdef _WIN32
 
 void C4NetIOSimpleUDP::UnBlock() // (mt-safe)
@@ -3238,6 +3620,14 @@ const unsigned int C4NetIOUDP::Peer::iReCheckInterval = 1000; // (ms)
 
 // construction / destruction
 
+void C4NetIOUDP::Peer::SetAltAddr(const C4NetIO::addr_t &naddr2)
+{
+	// keep the parent's index up to date
+	pParent->PeerAltAddrs.Remove(addr2, this);
+	addr2 = naddr2;
+	pParent->PeerAltAddrs.Add(addr2, this);
+}
+
 C4NetIOUDP::Peer::Peer(const addr_t &naddr, C4NetIOUDP *pnParent)
 	: pParent(pnParent), addr(naddr),
 	eStatus(CS_None),
@@ -3603,13 +3993,24 @@ bool C4NetIOUDP::Peer::DoCheck(int iAskCnt, int iMCAskCnt, unsigned int *pAskLis
 bool C4NetIOUDP::Peer::SendDirect(const Packet &rPacket, unsigned int iNr)
 {
 	// send one fragment only?
-	if (iNr + 1)
-		return SendDirect(rPacket.GetFragment(iNr - rPacket.GetNr()));
-	// otherwise: send all fragments
-	bool fSuccess = true;
+	if (iNr + 1 || rPacket.FragmentCnt() == 1)
+		return SendDirect(rPacket.GetFragment(iNr + 1 ? iNr - rPacket.GetNr() : 0));
+	// otherwise: send all fragments at once
+	const C4NetIO::addr_t v6Addr{addr.AsIPv6()};
+	std::vector<C4NetIOPacket> Fragments;
+	Fragments.reserve(rPacket.FragmentCnt());
+	int iSize{0};
 	for (unsigned int i = 0; i < rPacket.FragmentCnt(); i++)
-		fSuccess &= SendDirect(rPacket.GetFragment(i));
-	return fSuccess;
+	{
+		C4NetIOPacket &Fragment{Fragments.emplace_back(rPacket.GetFragment(i))};
+		// insert correct addr
+		if (!(Fragment.getStatus() & 0x80)) Fragment.SetAddr(v6Addr);
+		iSize += Fragment.getSize() + iUDPHeaderSize;
+	}
+	// count outgoing
+	{ CStdLock StatLock(&StatCSec); iORate += iSize; }
+	// forward call
+	return pParent->SendDirect(std::move(Fragments));
 }
 
 bool C4NetIOUDP::Peer::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
@@ -3731,13 +4132,29 @@ bool C4NetIOUDP::BroadcastDirect(const Packet &rPacket, unsigned int iNr) // (mt
 	if (iNr + 1)
 		return SendDirect(rPacket.GetFragment(iNr - rPacket.GetNr(), true));
 	// send all fragments
-	bool fSuccess = true;
+	std::vector<C4NetIOPacket> Fragments;
+	Fragments.reserve(rPacket.FragmentCnt());
 	for (unsigned int iFrgm = 0; iFrgm < rPacket.FragmentCnt(); iFrgm++)
-		fSuccess &= SendDirect(rPacket.GetFragment(iFrgm, true));
-	return fSuccess;
+		Fragments.emplace_back(rPacket.GetFragment(iFrgm, true));
+	return SendDirect(std::move(Fragments));
+}
+
+bool C4NetIOUDP::SendDirect(std::vector<C4NetIOPacket> &&packets) // (mt-safe)
+{
+	if (packets.size() == 1) return SendDirect(std::move(packets.front()));
+	// prepare all packets, then send them at once
+	std::erase_if(packets, [this](C4NetIOPacket &Pkt) { return !PrepareSendDirect(Pkt); });
+	return C4NetIOSimpleUDP::SendBatch(packets);
 }
 
 bool C4NetIOUDP::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
+{
+	if (!PrepareSendDirect(rPacket)) return true;
+	// send it
+	return C4NetIOSimpleUDP::Send(rPacket);
+}
+
+bool C4NetIOUDP::PrepareSendDirect(C4NetIOPacket &rPacket) // (mt-safe)
 {
 	addr_t toaddr = rPacket.getAddr();
 	// packet meant to be broadcasted?
@@ -3757,11 +4174,11 @@ bool C4NetIOUDP::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
 
 #ifdef C4NETIO_SIMULATE_PACKETLOSS
 	if ((rPacket.getStatus() & 0x7F) != IPID_Test)
-		if (SafeRandom(100) < C4NETIO_SIMULATE_PACKETLOSS) return true;
+		if (SafeRandom(100) < C4NETIO_SIMULATE_PACKETLOSS) return false;
 #endif
 
-	// send it
-	return C4NetIOSimpleUDP::Send(C4NetIOPacket(rPacket.getRef(), toaddr));
+	rPacket.SetAddr(toaddr);
+	return true;
 }
 
 bool C4NetIOUDP::DoLoopbackTest()
@@ -3829,6 +4246,7 @@ void C4NetIOUDP::AddPeer(Peer *pPeer)
 	// add
 	pPeer->Next = pPeerList;
 	pPeerList = pPeer;
+	PeerAddrs.Add(pPeer->GetAddr(), pPeer);
 }
 
 void C4NetIOUDP::OnShareFree(CStdCSecEx *pCSec)
@@ -3844,6 +4262,8 @@ void C4NetIOUDP::OnShareFree(CStdCSecEx *pCSec)
 				// unlink
 				Peer *pDelete = pPeer;
 				(pLast ? pLast->Next : pPeerList) = pPeer = pPeer->Next;
+				PeerAddrs.Remove(pDelete->GetAddr(), pDelete);
+				PeerAltAddrs.Remove(pDelete->GetAltAddr(), pDelete);
 				// delete
 				delete pDelete;
 			}
@@ -3860,11 +4280,9 @@ void C4NetIOUDP::OnShareFree(CStdCSecEx *pCSec)
 C4NetIOUDP::Peer *C4NetIOUDP::GetPeer(const addr_t &addr)
 {
 	CStdShareLock PeerListLock(&PeerListCSec);
-	for (Peer *pPeer = pPeerList; pPeer; pPeer = pPeer->Next)
-		if (!pPeer->Closed())
-			if (pPeer->GetAddr() == addr || pPeer->GetAltAddr() == addr)
-				return pPeer;
-	return nullptr;
+	const auto isOpen = [](Peer *pPeer) { return !pPeer->Closed(); };
+	if (Peer *pPeer = PeerAddrs.Find(addr, isOpen)) return pPeer;
+	return PeerAltAddrs.Find(addr, isOpen);
 }
 
 C4NetIOUDP::Peer *C4NetIOUDP::ConnectPeer(const addr_t &PeerAddr, bool fFailCallback) // (mt-safe)
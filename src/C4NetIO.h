@@ -25,7 +25,13 @@
 #include "StdCompiler.h"
 #include "StdScheduler.h"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <unordered_map>
 #include <vector>
 
 #ifdef _WIN32
@@ -186,6 +192,7 @@ public:
 		};
 
 		bool operator==(const EndpointAddress &rhs) const;
+		std::size_t GetHash() const; // consistent with operator==, i.e. IPv4 addresses hash like their IPv6-mapped counterparts
 
 		// Conversions
 		operator sockaddr() const { return gen; }
@@ -280,6 +287,48 @@ public:
 	virtual void SetCallback(CBClass *pnCallback) = 0;
 };
 
+template<>
+struct std::hash<C4NetIO::addr_t>
+{
+	std::size_t operator()(const C4NetIO::addr_t &addr) const noexcept { return addr.GetHash(); }
+};
+
+// address -> peer index for the peer lists of the I/O classes below
+// Several peers may share an address while closed ones haven't been deleted yet.
+// Lookups only need a shared lock, as peers can be added while others are being looked up.
+template<class Peer>
+class C4NetIOPeerMap
+{
+public:
+	void Add(const C4NetIO::addr_t &addr, Peer *pPeer)
+	{
+		const std::unique_lock lock{Mutex};
+		Peers.emplace(addr, pPeer);
+	}
+
+	void Remove(const C4NetIO::addr_t &addr, Peer *pPeer)
+	{
+		const std::unique_lock lock{Mutex};
+		const auto [begin, end] = Peers.equal_range(addr);
+		if (const auto it = std::find_if(begin, end, [pPeer](const auto &entry) { return entry.second == pPeer; }); it != end)
+			Peers.erase(it);
+	}
+
+	// returns a peer with the given address that satisfies the predicate
+	template<typename Pred>
+	Peer *Find(const C4NetIO::addr_t &addr, Pred pred) const
+	{
+		const std::shared_lock lock{Mutex};
+		const auto [begin, end] = Peers.equal_range(addr);
+		const auto it = std::find_if(begin, end, [&pred](const auto &entry) { return pred(entry.second); });
+		return it != end ? it->second : nullptr;
+	}
+
+private:
+	std::unordered_multimap<C4NetIO::addr_t, Peer *> Peers;
+	mutable std::shared_mutex Mutex;
+};
+
 // packet class
 class C4NetIOPacket : public StdBuf
 {
@@ -291,6 +340,11 @@ public:
 	// construct from buffer (takes data, if possible)
 	explicit C4NetIOPacket(const StdBuf &Buf, const C4NetIO::addr_t &naddr = C4NetIO::addr_t());
 
+	C4NetIOPacket(const C4NetIOPacket &) = default;
+	C4NetIOPacket(C4NetIOPacket &&) = default;
+	C4NetIOPacket &operator=(const C4NetIOPacket &) = default;
+	C4NetIOPacket &operator=(C4NetIOPacket &&) = default;
+
 	~C4NetIOPacket();
 
 protected:
@@ -360,6 +414,9 @@ public:
 	virtual HANDLE GetEvent() override;
 #else
 	virtual void GetFDs(fd_set *pSet, int *pMaxFD) override;
+#endif
+#ifdef USE_EPOLL
+	virtual int GetFD() override { return EpollFD; }
 #endif
 	virtual int GetTimeout() override;
 
@@ -445,6 +502,7 @@ protected:
 
 	// peer list
 	Peer *pPeerList;
+	C4NetIOPeerMap<Peer> PeerAddrs;
 
 	// small list for waited-for connections
 	struct ConnectWait
@@ -474,9 +532,22 @@ protected:
 	int Pipe[2];
 #endif
 
+#ifdef USE_EPOLL
+	// epoll instance watching pipe, listener, connect waits and peers (edge-triggered)
+	// lives as long as the object, so it can stay registered with a scheduler across Init/Close
+	int EpollFD;
+#endif
+
 	// *** implementation
 
 	bool Listen(uint16_t inListenPort);
+	void Receive(Peer *pPeer);
+#ifndef _WIN32
+	bool OnConnected(SOCKET sock, const addr_t &addr);
+#endif
+#ifdef USE_EPOLL
+	bool EpollAdd(SOCKET sock, uint32_t iEvents, void *pData);
+#endif
 
 	SOCKET CreateSocket(addr_t::AddressFamily family);
 	bool Connect(const addr_t &addr, SOCKET nsock);
@@ -517,6 +588,10 @@ public:
 
 	virtual bool Send(const C4NetIOPacket &rPacket) override;
 	virtual bool Broadcast(const C4NetIOPacket &rPacket) override;
+	bool SendBatch(std::span<const C4NetIOPacket> packets); // (mt-safe) fewer syscalls than sending one by one where supported
+
+	// let the kernel split runs of equally sized packets to the same address (UDP GSO, Linux only)
+	void SetSegmentationOffload(bool fEnable) { fSegmentationOffload = fEnable; }
 
 	virtual void UnBlock();
 #ifdef _WIN32
@@ -562,6 +637,15 @@ private:
 	// multibind
 	int fAllowReUse;
 
+	// batched I/O
+	std::atomic<bool> fSegmentationOffload{false}; // reset if the kernel rejects it
+#ifdef __linux__
+	std::vector<char> BatchReceiveBuffer; // allocated on first use
+
+	enum BatchResult { BR_Received, BR_Drained, BR_Fallback, BR_Error = -1, };
+	BatchResult ReceiveBatch();
+#endif
+
 protected:
 	// multicast address
 	const addr_t &getMCAddr() const { return MCAddr; }
@@ -611,6 +695,7 @@ public:
 
 	virtual bool Send(const C4NetIOPacket &rPacket) override;
 	bool SendDirect(C4NetIOPacket &&packet); // (mt-safe)
+	bool SendDirect(std::vector<C4NetIOPacket> &&packets); // (mt-safe)
 	virtual bool Broadcast(const C4NetIOPacket &rPacket) override;
 	virtual bool SetBroadcast(const addr_t &addr, bool fSet = true) override;
 
@@ -825,7 +910,7 @@ protected:
 		void SetBroadcast(bool fSet) { fDoBroadcast = fSet; }
 
 		// alternate address
-		void SetAltAddr(const C4NetIO::addr_t &naddr2) { addr2 = naddr2; }
+		void SetAltAddr(const C4NetIO::addr_t &naddr2);
 
 		// statistics
 		int GetIRate() const { return iIRate; }
@@ -871,6 +956,7 @@ protected:
 
 	// peer list
 	Peer *pPeerList;
+	C4NetIOPeerMap<Peer> PeerAddrs, PeerAltAddrs;
 
 	// currently initializing - do not process packets, save them back instead
 	bool fSavePacket;
@@ -898,6 +984,7 @@ protected:
 
 	// sending
 	bool BroadcastDirect(const Packet &rPacket, unsigned int iNr = ~0u); // (mt-safe)
+	bool PrepareSendDirect(C4NetIOPacket &rPacket); // (mt-safe) sets the target address; false if the packet is to be dropped
 
 	// multicast related
 	bool DoLoopbackTest();
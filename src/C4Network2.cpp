@@ -31,6 +31,7 @@
 
 #include <C4Network2Dialogs.h>
 #include <C4League.h>
+#include <C4Thread.h>
 
 #ifndef USE_CONSOLE
 #include "C4Toast.h"
@@ -45,6 +46,8 @@
 #endif
 
 #include <cassert>
+#include <memory>
+#include <string>
 
 // *** C4Network2Status
 
@@ -194,7 +197,8 @@ void C4Network2::ReadyCheckDialog::OnAction(std::string_view action)
 C4Network2::C4Network2()
 	: Clients(&NetIO),
 	fAllowJoin(false),
-	iDynamicTick(-1), fDynamicNeeded(false),
+	iDynamicTick(-1), fDynamicNeeded(false), iDynamicExpiryTick(-1),
+	fDynamicSaveDone(false), fDynamicSaveSuccess(false),
 	fStatusAck(false), fStatusReached(false),
 	fChasing(false),
 	pLobby(nullptr), fLobbyRunning(false), pLobbyCountdown(nullptr),
@@ -681,8 +685,10 @@ void C4Network2::Execute()
 
 	if (isHost())
 	{
+		// dynamic packed in the background?
+		CheckDynamicSave();
 		// remove dynamic
-		if (!ResDynamic.isNull() && Game.Control.ControlTick > iDynamicTick)
+		if (!ResDynamic.isNull() && Game.Control.ControlTick > iDynamicExpiryTick)
 			RemoveDynamic();
 		// Set chase target
 		UpdateChaseTarget();
@@ -739,6 +745,14 @@ void C4Network2::Clear()
 	if (pSec1Timer) pSec1Timer->Release(); pSec1Timer = nullptr;
 	// stop streaming
 	StopStreaming();
+	// wait for dynamic save
+	if (DynamicSaveThread.joinable())
+	{
+		DynamicSaveThread.join();
+		EraseItem(DynamicSaveFilename.c_str());
+	}
+	DynamicSaveFilename.clear(); fDynamicSaveDone = false;
+	DynamicParameters.reset();
 	// clear league
 	if (pLeagueClient)
 	{
@@ -768,7 +782,7 @@ void C4Network2::Clear()
 	sPassword.Clear();
 	// stuff
 	fAllowJoin = false;
-	iDynamicTick = -1; fDynamicNeeded = false;
+	iDynamicTick = iDynamicExpiryTick = -1; fDynamicNeeded = false;
 	iLastActivateRequest = iLastChaseTargetUpdate = iLastReferenceUpdate = iLastLeagueUpdate = 0;
 	fDelayedActivateReq = false;
 	if (Game.pGUI) delete pVoteDialog; pVoteDialog = nullptr;
@@ -1091,21 +1105,28 @@ void C4Network2::OnGameSynchronized()
 	// savegame needed?
 	if (fDynamicNeeded)
 	{
-		// create dynamic
-		bool fSuccess = CreateDynamic(false);
-		// check for clients that still need join-data
-		C4Network2Client *pClient = nullptr;
-		while (pClient = Clients.GetNextClient(pClient))
-			if (!pClient->hasJoinData())
-				if (fSuccess)
-					// now we can provide join data: send it
-					SendJoinData(pClient);
-				else
-					// join data could not be created: emergency kick
-					Game.Clients.CtrlRemove(pClient->getClient(), LoadResStr("IDS_ERR_ERRORWHILECREATINGJOINDAT"));
+		// create dynamic (might be finished in the background)
+		if (!CreateDynamic(false, Config.Network.AsyncDynamic))
+			OnDynamicCreated(false);
+		else if (!DynamicSaveThread.joinable())
+			OnDynamicCreated(true);
 	}
 }
 
+void C4Network2::OnDynamicCreated(bool fSuccess)
+{
+	// check for clients that still need join-data
+	C4Network2Client *pClient = nullptr;
+	while (pClient = Clients.GetNextClient(pClient))
+		if (!pClient->hasJoinData())
+			if (fSuccess)
+				// now we can provide join data: send it
+				SendJoinData(pClient);
+			else
+				// join data could not be created: emergency kick
+				Game.Clients.CtrlRemove(pClient->getClient(), LoadResStr("IDS_ERR_ERRORWHILECREATINGJOINDAT"));
+}
+
 void C4Network2::DrawStatus(C4FacetEx &cgo)
 {
 	if (!isEnabled()) return;
@@ -1793,8 +1814,11 @@ void C4Network2::SendJoinData(C4Network2Client *pClient)
 	if (pClient->hasJoinData()) return;
 	// host only, scenario must be available
 	assert(isHost());
-	// dynamic available?
-	if (ResDynamic.isNull() || iDynamicTick < Game.Control.ControlTick)
+	// dynamic still being packed? Join data is sent once it's done
+	if (DynamicSaveThread.joinable()) return;
+	// dynamic available? Runtime dynamics must already contain the client
+	if (ResDynamic.isNull() || Game.Control.ControlTick > iDynamicExpiryTick ||
+		(DynamicParameters && !DynamicParameters->Clients.getClientByID(pClient->getID())))
 	{
 		fDynamicNeeded = true;
 		// add synchronization control (will callback, see C4Game::Synchronize)
@@ -1806,8 +1830,8 @@ void C4Network2::SendJoinData(C4Network2Client *pClient)
 	JoinData.SetClientID(pClient->getID());
 	// save status into packet
 	JoinData.SetGameStatus(Status);
-	// parameters
-	JoinData.Parameters = Game.Parameters;
+	// parameters (as of the dynamic)
+	JoinData.Parameters = DynamicParameters ? *DynamicParameters : Game.Parameters;
 	// core join data
 	JoinData.SetStartCtrlTick(iDynamicTick);
 	JoinData.SetDynamicCore(ResDynamic);
@@ -1913,7 +1937,7 @@ C4Network2Res::Ref C4Network2::RetrieveRes(const C4Network2ResCore &Core, int32_
 	return nullptr;
 }
 
-bool C4Network2::CreateDynamic(bool fInit)
+bool C4Network2::CreateDynamic(bool fInit, bool fAsync)
 {
 	if (!isHost()) return false;
 	// remove all existing dynamic data
@@ -1926,28 +1950,78 @@ bool C4Network2::CreateDynamic(bool fInit)
 	if (!ResList.FindTempResFileName(szDynamicBase, szDynamicFilename))
 		Log(LoadResStr("IDS_NET_SAVE_ERR_CREATEDYNFILE"));
 	// save dynamic data
-	C4GameSaveNetwork SaveGame(fInit);
-	if (!SaveGame.Save(szDynamicFilename) || !SaveGame.Close())
+	// asynchronously, only the game state is captured here; image encoding and packing are left to Close()
+	// (capturing still writes the text savegame format clients load scenarios from: ~60-90 ms for 5000 objects)
+	auto pSaveGame = std::make_unique<C4GameSaveNetwork>(fInit, fAsync);
+	if (!pSaveGame->Save(szDynamicFilename) || (!fAsync && !pSaveGame->Close()))
 	{
 		Log(LoadResStr("IDS_NET_SAVE_ERR_SAVEDYNFILE")); return false;
 	}
+	iDynamicTick = Game.Control.getNextControlTick();
+	fDynamicNeeded = false;
+	// runtime dynamic: joining clients need the parameters and control as of now
+	if (!fInit)
+	{
+		DynamicParameters.emplace();
+		*DynamicParameters = Game.Parameters;
+		pControl->KeepCtrl(iDynamicTick);
+	}
+	if (fAsync)
+	{
+		// pack in the background; the ressource is added by CheckDynamicSave
+		fDynamicSaveDone = fDynamicSaveSuccess = false;
+		DynamicSaveFilename = szDynamicFilename;
+		DynamicSaveThread = std::thread{[this, pSaveGame = std::move(pSaveGame)]
+		{
+			C4Thread::SetCurrentThreadName("DynamicSave");
+			fDynamicSaveSuccess = pSaveGame->Close();
+			fDynamicSaveDone = true;
+		}};
+		return true;
+	}
 	// add ressource
 	C4Network2Res::Ref pRes = ResList.AddByFile(szDynamicFilename, true, NRT_Dynamic);
-	if (!pRes) { Log(LoadResStr("IDS_NET_SAVE_ERR_ADDDYNDATARES")); return false; }
+	if (!pRes) { Log(LoadResStr("IDS_NET_SAVE_ERR_ADDDYNDATARES")); RemoveDynamic(); return false; }
 	// save
 	ResDynamic = pRes->getCore();
-	iDynamicTick = Game.Control.getNextControlTick();
-	fDynamicNeeded = false;
+	iDynamicExpiryTick = fInit ? iDynamicTick : Game.Control.ControlTick + C4NetDynamicMaxAge;
 	// ok
 	return true;
 }
 
+void C4Network2::CheckDynamicSave()
+{
+	if (!DynamicSaveThread.joinable() || !fDynamicSaveDone) return;
+	DynamicSaveThread.join();
+	// add ressource
+	C4Network2Res::Ref pRes;
+	if (!fDynamicSaveSuccess)
+		Log(LoadResStr("IDS_NET_SAVE_ERR_SAVEDYNFILE"));
+	else if (!(pRes = ResList.AddByFile(DynamicSaveFilename.c_str(), true, NRT_Dynamic)))
+		Log(LoadResStr("IDS_NET_SAVE_ERR_ADDDYNDATARES"));
+	if (pRes)
+	{
+		ResDynamic = pRes->getCore();
+		// offer it for a while, no matter how long packing took
+		iDynamicExpiryTick = Game.Control.ControlTick + C4NetDynamicMaxAge;
+	}
+	else
+	{
+		EraseItem(DynamicSaveFilename.c_str());
+		RemoveDynamic();
+	}
+	DynamicSaveFilename.clear();
+	OnDynamicCreated(!!pRes);
+}
+
 void C4Network2::RemoveDynamic()
 {
 	C4Network2Res::Ref pRes = ResList.getRefRes(ResDynamic.getID());
 	if (pRes) pRes->Remove();
 	ResDynamic.Clear();
-	iDynamicTick = -1;
+	iDynamicTick = iDynamicExpiryTick = -1;
+	DynamicParameters.reset();
+	if (pControl) pControl->KeepCtrl(-1);
 }
 
 bool C4Network2::isFrozen() const
@@ -35,8 +35,11 @@
 #include "C4ToastEventHandler.h"
 #endif
 
+#include <atomic>
 #include <cstdint>
 #include <optional>
+#include <string>
+#include <thread>
 
 // lobby predef - no need to include lobby in header just for the class ptr
 namespace C4GameLobby { class MainDlg; class Countdown; }
@@ -59,6 +62,9 @@ const int C4NetActivationReqInterval = 5000, // (ms)
           C4NetMaxBehind4Activation = 20, // (ticks)
           C4NetDeactivationDelay = 500; // (ticks)
 
+// runtime join data: how long a dynamic is offered once it's ready; joining clients catch up on the control since its tick
+const int32_t C4NetDynamicMaxAge = 100; // (ticks)
+
 // client chase
 const unsigned int C4NetChaseTargetUpdateInterval = 5; // (s)
 
@@ -177,6 +183,14 @@ protected:
 	// ressources
 	int32_t iDynamicTick;
 	bool fDynamicNeeded;
+	int32_t iDynamicExpiryTick; // dynamic is removed after this control tick
+	std::optional<C4GameParameters> DynamicParameters; // parameters at iDynamicTick for runtime dynamics
+
+	// dynamic packed in the background
+	std::thread DynamicSaveThread;
+	std::atomic<bool> fDynamicSaveDone;
+	bool fDynamicSaveSuccess; // set by save thread
+	std::string DynamicSaveFilename;
 
 	// game status flags
 	bool fStatusAck, fStatusReached;
@@ -377,8 +391,10 @@ protected:
 	void SendJoinData(C4Network2Client *pClient);
 
 	// ressource list
-	bool CreateDynamic(bool fInit);
+	bool CreateDynamic(bool fInit, bool fAsync = false);
+	void CheckDynamicSave();
 	void RemoveDynamic();
+	void OnDynamicCreated(bool fSuccess);
 
 	// status changes
 	bool ChangeGameStatus(C4NetGameState enState, int32_t iTargetCtrlTick, int32_t iCtrlMode = -1);
@@ -24,6 +24,7 @@
 #include <C4UserMessages.h>
 #include <C4Log.h>
 #include <C4Game.h>
+#include <C4Profiler.h>
 
 #ifndef _WIN32
 #include <sys/socket.h>
@@ -113,7 +114,9 @@ bool C4Network2IO::Init(const std::uint16_t iPortTCP, const std::uint16_t iPortU
 	}
 
 	// then UDP
-	pNetIO_UDP = CreateNetIO("UDP I/O", new C4NetIOUDP{}, iPortUDP, Thread);
+	auto *const pUDP = new C4NetIOUDP{};
+	pUDP->SetSegmentationOffload(Config.Network.UDPSegmentationOffload);
+	pNetIO_UDP = CreateNetIO("UDP I/O", pUDP, iPortUDP, Thread);
 	if (pNetIO_UDP)
 	{
 		pNetIO_UDP->SetCallback(this);
@@ -810,6 +813,8 @@ bool C4Network2IO::HandlePacket(const C4NetIOPacket &rPacket, C4Network2IOConnec
 		return false;
 	}
 
+	C4ProfilerZone ProfilerZone{"C4Network2IO::HandlePacket", Pkt.getPktName()};
+
 	// dump packet (network thread only)
 #if (C4NET2IO_DUMP_LEVEL > 0)
 	if (fThread && Pkt.getPktType() != PID_Ping && Pkt.getPktType() != PID_Pong && Pkt.getPktType() != PID_NetResData)
@@ -1731,6 +1736,33 @@ void C4PacketResRequest::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iReqChunk), "Chunk", -1));
 }
 
+// *** C4PacketResChunkHashes
+
+C4PacketResChunkHashes::C4PacketResChunkHashes(int32_t iResID, uint32_t iChunkSize)
+	: iResID(iResID), iChunkSize(iChunkSize) {}
+
+void C4PacketResChunkHashes::AddChunk(uint32_t iWeakHash, uint64_t iStrongHash)
+{
+	WeakHashes.push_back(iWeakHash);
+	StrongHashes.push_back(iStrongHash);
+}
+
+void C4PacketResChunkHashes::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(mkNamingAdapt(iResID,     "ResID",     -1));
+	pComp->Value(mkNamingAdapt(iChunkSize, "ChunkSize", 0U));
+	int32_t iChunkCnt = getChunkCnt();
+	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iChunkCnt), "ChunkCnt", 0));
+	if (pComp->isCompiler())
+	{
+		if (iChunkCnt < 0 || iChunkCnt > C4NetResMaxChunkHashes) pComp->excCorrupt("invalid chunk hash count");
+		WeakHashes.resize(iChunkCnt);
+		StrongHashes.resize(iChunkCnt);
+	}
+	pComp->Value(mkNamingAdapt(mkArrayAdaptS(WeakHashes.data(),   iChunkCnt), "WeakHashes"));
+	pComp->Value(mkNamingAdapt(mkArrayAdaptS(StrongHashes.data(), iChunkCnt), "StrongHashes"));
+}
+
 // *** C4PacketControlReq
 
 C4PacketControlReq::C4PacketControlReq(int32_t inCtrlTick)
@@ -23,8 +23,15 @@
 #include <C4Group.h>
 #include <C4Components.h>
 #include <C4Game.h>
+#include <C4Thread.h>
 #include "StdAdaptors.h"
 
+#include <zlib.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+
 #include <fcntl.h>
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -70,6 +77,69 @@ public:
 };
 uint32_t DirSizeHelper::iSize, DirSizeHelper::iMaxSize;
 
+namespace
+{
+	// rsync's rolling checksum: can be moved along the data byte by byte
+	class C4Network2ResRollingChecksum
+	{
+	public:
+		C4Network2ResRollingChecksum(const uint8_t *pData, size_t iLength) : iLength(static_cast<uint32_t>(iLength))
+		{
+			for (size_t i = 0; i < iLength; i++)
+			{
+				a += pData[i];
+				b += static_cast<uint32_t>(iLength - i) * pData[i];
+			}
+		}
+
+		void Roll(uint8_t iOut, uint8_t iIn)
+		{
+			a += iIn - iOut;
+			b += a - iLength * iOut;
+		}
+
+		uint32_t Get() const { return (a & 0xffff) | (b << 16); }
+
+	private:
+		uint32_t a{0}, b{0}, iLength;
+	};
+
+	uint64_t GetChunkStrongHash(StdSha1 &sha1, const uint8_t *pData, size_t iLength)
+	{
+		uint8_t hash[StdSha1::DigestLength];
+		sha1.Reset();
+		sha1.Update(pData, iLength);
+		sha1.GetHash(hash);
+		uint64_t iHash;
+		std::memcpy(&iHash, hash, sizeof(iHash));
+		return iHash;
+	}
+
+	void CollectFolderFingerprint(const char *szPath, size_t iBaseLength, std::vector<std::string> &Items)
+	{
+		for (DirectoryIterator i(szPath); *i; ++i)
+		{
+			const bool fFolder = DirectoryExists(*i);
+			Items.emplace_back(FormatString("%s|%zu|%lld", *i + iBaseLength, fFolder ? 0 : FileSize(*i), static_cast<long long>(FileTime(*i))).getData());
+			if (fFolder) CollectFolderFingerprint(*i, iBaseLength, Items);
+		}
+	}
+
+	// Checksum over the names, sizes and modification times of all files in a folder. The contents checksum
+	// only combines the checksums of the file contents, so renamed or swapped files don't change it.
+	uint32_t GetFolderFingerprint(const char *szPath)
+	{
+		std::vector<std::string> Items;
+		CollectFolderFingerprint(szPath, SLen(szPath), Items);
+		// independent of the order the file system lists them in
+		std::sort(Items.begin(), Items.end());
+		uint32_t iCRC = 0;
+		for (const auto &item : Items)
+			iCRC = crc32(iCRC, reinterpret_cast<const Bytef *>(item.c_str()), checked_cast<uInt>(item.size() + 1));
+		return iCRC;
+	}
+}
+
 // *** C4Network2ResCore
 
 C4Network2ResCore::C4Network2ResCore()
@@ -308,6 +378,14 @@ void C4Network2ResChunkData::GetNegative(C4Network2ResChunkData &Target) const
 	Target.AddChunkRange(iFreeStart, iChunkCnt - iFreeStart);
 }
 
+bool C4Network2ResChunkData::isChunkPresent(int32_t iChunk) const
+{
+	for (ChunkRange *pRange = pChunkRanges; pRange && pRange->Start <= iChunk; pRange = pRange->Next)
+		if (iChunk < pRange->Start + pRange->Length)
+			return true;
+	return false;
+}
+
 int32_t C4Network2ResChunkData::getPresentChunk(int32_t iNr) const
 {
 	for (ChunkRange *pRange = pChunkRanges; pRange; pRange = pRange->Next)
@@ -358,10 +436,11 @@ C4Network2Res::C4Network2Res(C4Network2ResList *pnParent)
 	iLastReqTime(0),
 	fLoading(false),
 	pCChunks(nullptr), iDiscoverStartTime(0), pLoads(nullptr), iLoadCnt(0),
+	iBasisStartTime(0), fHashesRequested(false), fBasisUsed(false), fBasisMatching(false), fBasisMatched(false),
 	pNext(nullptr),
 	pParent(pnParent)
 {
-	szFile[0] = szStandalone[0] = '\0';
+	szFile[0] = szStandalone[0] = szBasis[0] = '\0';
 }
 
 C4Network2Res::~C4Network2Res()
@@ -493,6 +572,24 @@ bool C4Network2Res::SetByCore(const C4Network2ResCore &nCore, bool fSilent, cons
 	return false;
 }
 
+bool C4Network2Res::SetByCache(const C4Network2ResCore &nCore) // by main thread
+{
+	char szCached[_MAX_PATH + 1], szTemp[_MAX_PATH + 1];
+	if (!pParent->Cache.FindByContents(nCore.getContentsCRC(), 0, nCore.getFileName(), szCached))
+		return false;
+	// work on a copy, cache entries might be removed at any time
+	if (!pParent->FindTempResFileName(nCore.getFileName(), szTemp) || !CopyFile(szCached, szTemp, false))
+		return false;
+	// check it like any other local file
+	if (!SetByCore(nCore, true, szTemp, Config.Network.MaxResSearchRecursion))
+	{
+		EraseFile(szTemp);
+		return false;
+	}
+	fTempFile = true;
+	return true;
+}
+
 bool C4Network2Res::SetLoad(const C4Network2ResCore &nCore) // by main thread
 {
 	Clear();
@@ -520,6 +617,11 @@ bool C4Network2Res::SetLoad(const C4Network2ResCore &nCore) // by main thread
 	fLoading = true;
 	// No discovery yet
 	iDiscoverStartTime = 0;
+	// older version in the cache? Wait for the chunk hashes to reuse the unchanged chunks.
+	fHashesRequested = fBasisUsed = fBasisMatching = fBasisMatched = false;
+	iBasisStartTime = time(nullptr);
+	if (Core.getFileSize() < Core.getChunkSize() || !pParent->Cache.FindBasis(Core.getFileName(), szBasis))
+		szBasis[0] = '\0';
 	return true;
 }
 
@@ -548,6 +650,7 @@ bool C4Network2Res::SetDerived(const char *strName, const char *strFilePath, boo
 void C4Network2Res::ChangeID(int32_t inID)
 {
 	Core.SetID(inID);
+	if (pChunkHashes) pChunkHashes->SetResID(inID);
 }
 
 bool C4Network2Res::IsBinaryCompatible()
@@ -586,6 +689,7 @@ bool C4Network2Res::GetStandalone(char *pTo, int32_t iMaxL, bool fSetOfficial, b
 	CStdLock FileLock(&FileCSec);
 
 	// directory?
+	bool fStorePack = false; uint32_t iSourceKey = 0;
 	SCopy(szFile, szStandalone, sizeof(szStandalone) - 1);
 	if (DirectoryExists(szFile))
 	{
@@ -602,8 +706,6 @@ bool C4Network2Res::GetStandalone(char *pTo, int32_t iMaxL, bool fSetOfficial, b
 				if (!fSilent) LogSilentF("Network: %s over size limit, will be marked unloadable!", szFile); szStandalone[0] = '\0'; return false;
 			}
 		}
-		// log - this may take a few seconds
-		if (!fSilent) LogF(LoadResStr("IDS_PRC_NETPACKING"), GetFilename(szFile));
 		// pack inplace?
 		if (!fTempFile)
 		{
@@ -611,14 +713,28 @@ bool C4Network2Res::GetStandalone(char *pTo, int32_t iMaxL, bool fSetOfficial, b
 			{
 				if (!fSilent) Log("GetStandalone: could not find free name for temporary file!"); szStandalone[0] = '\0'; return false;
 			}
-			if (!C4Group_PackDirectoryTo(szFile, szStandalone))
+			// packed in an earlier game? unchanged folders don't need to be packed again
+			char szCached[_MAX_PATH + 1];
+			iSourceKey = GetFolderFingerprint(szFile);
+			if (!pParent->Cache.FindByContents(Core.getContentsCRC(), iSourceKey, Core.getFileName(), szCached) || !CopyFile(szCached, szStandalone, false))
 			{
-				if (!fSilent) Log("GetStandalone: could not pack directory!"); szStandalone[0] = '\0'; return false;
+				// log - this may take a few seconds
+				if (!fSilent) LogF(LoadResStr("IDS_PRC_NETPACKING"), GetFilename(szFile));
+				if (!C4Group_PackDirectoryTo(szFile, szStandalone))
+				{
+					if (!fSilent) Log("GetStandalone: could not pack directory!"); szStandalone[0] = '\0'; return false;
+				}
+				fStorePack = true;
 			}
 		}
-		else if (!C4Group_PackDirectory(szStandalone))
+		else
 		{
-			if (!fSilent) Log("GetStandalone: could not pack directory!"); if (!SEqual(szFile, szStandalone)) EraseDirectory(szStandalone); szStandalone[0] = '\0'; return false;
+			// log - this may take a few seconds
+			if (!fSilent) LogF(LoadResStr("IDS_PRC_NETPACKING"), GetFilename(szFile));
+			if (!C4Group_PackDirectory(szStandalone))
+			{
+				if (!fSilent) Log("GetStandalone: could not pack directory!"); if (!SEqual(szFile, szStandalone)) EraseDirectory(szStandalone); szStandalone[0] = '\0'; return false;
+			}
 		}
 		// make sure directory is packed
 		if (DirectoryExists(szStandalone))
@@ -693,6 +809,9 @@ bool C4Network2Res::GetStandalone(char *pTo, int32_t iMaxL, bool fSetOfficial, b
 	Core.SetLoadable(iSize, iCRC32);
 	// set up chunk data
 	Chunks.SetComplete(Core.getChunkCnt());
+	// keep the pack for the next game
+	if (fStorePack)
+		pParent->Cache.Store(szStandalone, Core.getContentsCRC(), iSourceKey, Core.getFileName());
 	// ok
 	return true;
 }
@@ -864,6 +983,57 @@ bool C4Network2Res::SendChunk(uint32_t iChunk, int32_t iToClient)
 	return fSuccess;
 }
 
+bool C4Network2Res::SendChunkHashes(C4Network2IOConnection *pTo)
+{
+	CStdLock FileLock(&FileCSec);
+	if (fLoading) return false;
+	// save last request time
+	iLastReqTime = time(nullptr);
+	if (pChunkHashes)
+		return pTo->Send(MkC4NetIOPacket(PID_NetResHashes, *pChunkHashes));
+	// hashing reads the whole file: the file worker answers all requests made in the meantime
+	pTo->AddRef();
+	HashRequests.push_back(pTo);
+	if (HashRequests.size() == 1)
+		pParent->AddFileJob([pRes = Ref{this}] { pRes->CalculateChunkHashes(); });
+	return true;
+}
+
+void C4Network2Res::CalculateChunkHashes()
+{
+	// complete resources don't change, so the file is read without holding the lock
+	std::string Standalone;
+	size_t iChunkSize, iFileSize;
+	{
+		CStdLock FileLock(&FileCSec);
+		if (!fLoading && GetStandalone(nullptr, 0, false, false, true))
+			Standalone = szStandalone;
+		iChunkSize = Core.getChunkSize();
+		iFileSize = Core.getFileSize();
+	}
+	std::unique_ptr<C4PacketResChunkHashes> pHashes;
+	StdFileMapping File;
+	if (!Standalone.empty() && File.Open(Standalone.c_str()) && File.getSize() == iFileSize)
+	{
+		const auto *pData = static_cast<const uint8_t *>(File.getData());
+		pHashes = std::make_unique<C4PacketResChunkHashes>(getResID(), iChunkSize);
+		StdSha1 sha1;
+		for (size_t iPos = 0; iPos + iChunkSize <= File.getSize(); iPos += iChunkSize)
+			pHashes->AddChunk(C4Network2ResRollingChecksum{pData + iPos, iChunkSize}.Get(), GetChunkStrongHash(sha1, pData + iPos, iChunkSize));
+		if (pHashes->getChunkCnt() > C4NetResMaxChunkHashes) pHashes.reset();
+	}
+	File.Close();
+	// answer the waiting connections (the requester loads the file completely if there are no hashes)
+	CStdLock FileLock(&FileCSec);
+	if (pHashes && Standalone == szStandalone) pChunkHashes = std::move(pHashes);
+	for (C4Network2IOConnection *pConn : HashRequests)
+	{
+		if (pChunkHashes) pConn->Send(MkC4NetIOPacket(PID_NetResHashes, *pChunkHashes));
+		pConn->DelRef();
+	}
+	HashRequests.clear();
+}
+
 void C4Network2Res::AddRef()
 {
 	++iRefCnt;
@@ -904,6 +1074,13 @@ void C4Network2Res::OnStatus(const C4Network2ResChunkData &rChunkData, C4Network
 	}
 	pChunks->ClientID = pBy->getClientID();
 	pChunks->Chunks = rChunkData;
+	// waiting for chunk hashes? ask the first one who has the whole resource
+	if (fLoading && szBasis[0])
+	{
+		if (!fHashesRequested && rChunkData.isComplete())
+			fHashesRequested = pBy->Send(MkC4NetIOPacket(PID_NetResHashReq, C4PacketResRequest(Core.getID())));
+		return;
+	}
 	// load?
 	if (fLoading) StartLoad(pChunks->ClientID, pChunks->Chunks);
 }
@@ -940,9 +1117,46 @@ void C4Network2Res::OnChunk(const C4Network2ResChunk &rChunk)
 		StartNewLoads();
 }
 
+void C4Network2Res::OnChunkHashes(const C4PacketResChunkHashes &rHashes)
+{
+	CStdLock FileLock(&FileCSec);
+	if (!fLoading || !szBasis[0] || fBasisMatching) return;
+	// take what can be reused; searching reads the whole older version, so it's left to the file worker
+	// and the rest is loaded as usual once it's done (see DoLoad)
+	if (rHashes.getChunkSize() == Core.getChunkSize() && uint32_t(rHashes.getChunkCnt()) == Core.getFileSize() / Core.getChunkSize())
+	{
+		fBasisMatching = true;
+		pParent->AddFileJob([pRes = Ref{this}, pHashes = std::make_shared<const C4PacketResChunkHashes>(rHashes)]
+			{ pRes->AddChunksFromBasis(*pHashes); });
+		return;
+	}
+	szBasis[0] = '\0';
+	StartNewLoads();
+}
+
 bool C4Network2Res::DoLoad()
 {
 	if (!fLoading) return true;
+	{
+		CStdLock FileLock(&FileCSec);
+		// file worker done with the cached version? load the rest
+		if (fBasisMatched)
+		{
+			fBasisMatched = false;
+			if (Chunks.isComplete())
+			{
+				EndLoad();
+				return true;
+			}
+			StartNewLoads();
+		}
+		// chunk hashes didn't arrive in time? load everything
+		else if (szBasis[0] && !fBasisMatching && difftime(time(nullptr), iBasisStartTime) > C4NetResHashTimeout)
+		{
+			szBasis[0] = '\0';
+			StartNewLoads();
+		}
+	}
 	// any loads currently active?
 	if (iLoadCnt)
 	{
@@ -992,9 +1206,13 @@ void C4Network2Res::Clear()
 		if (FileExists(szStandalone))
 			if (remove(szStandalone))
 				LogSilentF("Network: Could not delete temporary resource file (%s)", strerror(errno));
-	szFile[0] = szStandalone[0] = '\0';
+	szFile[0] = szStandalone[0] = szBasis[0] = '\0';
 	fDirty = false;
 	fTempFile = false;
+	fBasisUsed = fBasisMatching = fBasisMatched = false;
+	pChunkHashes.reset();
+	for (C4Network2IOConnection *pConn : HashRequests) pConn->DelRef();
+	HashRequests.clear();
 	Core.Clear();
 	Chunks.Clear();
 	fRemoved = false;
@@ -1112,6 +1330,24 @@ bool C4Network2Res::StartLoad(int32_t iFromClient, const C4Network2ResChunkData
 
 void C4Network2Res::EndLoad()
 {
+	// chunks taken from the cache were only compared by hash: check the result
+	if (fBasisUsed)
+	{
+		fBasisUsed = false;
+		uint32_t iCRC32;
+		if (!C4Group_GetFileCRC(szFile, &iCRC32) || iCRC32 != Core.getFileCRC())
+		{
+			Application.InteractiveThread.ThreadLogSF("Network: %s does not match after reusing cached chunks, loading it completely", Core.getFileName());
+			Chunks.SetIncomplete(Core.getChunkCnt());
+			StartNewLoads();
+			return;
+		}
+	}
+	// keep a copy for later games (dynamic data and players change every time);
+	// copying is left to the file worker, the reference keeps the file until it's done
+	if (getType() != NRT_Dynamic && getType() != NRT_Player)
+		pParent->AddFileJob([pRes = Ref{this}, File = std::string{szFile}, iCRC = Core.getContentsCRC(), Name = std::string{Core.getFileName()}]
+			{ pRes->pParent->Cache.Store(File.c_str(), iCRC, 0, Name.c_str()); });
 	// clear loading data
 	ClearLoad();
 	// set complete
@@ -1165,6 +1401,92 @@ void C4Network2Res::RemoveCChunks(ClientChunks *pChunks)
 	delete pChunks;
 }
 
+void C4Network2Res::AddChunksFromBasis(const C4PacketResChunkHashes &rHashes) // by file worker
+{
+	// index missing chunks by rolling checksum; the bitmap rejects most positions without a lookup
+	std::unordered_multimap<uint32_t, int32_t> Missing;
+	std::vector<bool> WeakFilter(1 << 16);
+	std::string File, BasisFile;
+	size_t iChunkSize;
+	int32_t f;
+	{
+		CStdLock FileLock(&FileCSec);
+		if (!fLoading || !fBasisMatching) return;
+		File = szFile; BasisFile = szBasis;
+		iChunkSize = Core.getChunkSize();
+		for (int32_t i = 0; i < rHashes.getChunkCnt(); i++)
+			if (!Chunks.isChunkPresent(i))
+			{
+				Missing.emplace(rHashes.getWeakHash(i), i);
+				WeakFilter[(rHashes.getWeakHash(i) ^ (rHashes.getWeakHash(i) >> 16)) & 0xffff] = true;
+			}
+		// no loads run while the basis is searched, so the file is only written here
+		f = OpenFileWrite();
+	}
+	// look for the chunks at any offset, as inserted or removed data shifts everything behind it
+	std::vector<int32_t> Found;
+	StdFileMapping Basis;
+	if (f != -1 && !Missing.empty() && Basis.Open(BasisFile.c_str()) && Basis.getSize() >= iChunkSize)
+	{
+		const auto *pData = static_cast<const uint8_t *>(Basis.getData());
+		const size_t iSize = Basis.getSize();
+		StdSha1 sha1;
+		C4Network2ResRollingChecksum Checksum{pData, iChunkSize};
+		for (size_t iPos = 0; iPos + iChunkSize <= iSize && !Missing.empty(); )
+		{
+			bool fMatched = false;
+			const uint32_t iWeak = Checksum.Get();
+			if (WeakFilter[(iWeak ^ (iWeak >> 16)) & 0xffff])
+			{
+				auto [it, end] = Missing.equal_range(iWeak);
+				if (it != end)
+				{
+					const uint64_t iStrong = GetChunkStrongHash(sha1, pData + iPos, iChunkSize);
+					while (it != end)
+						if (rHashes.getStrongHash(it->second) == iStrong)
+						{
+							const int32_t iOffset = it->second * int32_t(iChunkSize);
+							if (lseek(f, iOffset, SEEK_SET) == iOffset && write(f, pData + iPos, iChunkSize) == int32_t(iChunkSize))
+								Found.push_back(it->second);
+							it = Missing.erase(it);
+							fMatched = true;
+						}
+						else
+							++it;
+				}
+			}
+			// continue behind the match or move on by one byte
+			if (fMatched)
+			{
+				iPos += iChunkSize;
+				if (iPos + iChunkSize <= iSize)
+					Checksum = C4Network2ResRollingChecksum{pData + iPos, iChunkSize};
+			}
+			else
+			{
+				if (iPos + iChunkSize < iSize)
+					Checksum.Roll(pData[iPos], pData[iPos + iChunkSize]);
+				iPos++;
+			}
+		}
+	}
+	Basis.Close();
+	if (f != -1) close(f);
+	// the resource might have been cleared or loaded anew meanwhile
+	CStdLock FileLock(&FileCSec);
+	if (!fLoading || !fBasisMatching || File != szFile) return;
+	for (const int32_t iChunk : Found)
+		Chunks.AddChunk(iChunk);
+	if (!Found.empty())
+	{
+		Application.InteractiveThread.ThreadLogSF("Network: %d of %d chunks of %s taken from the resource cache", static_cast<int32_t>(Found.size()), Chunks.getChunkCnt(), Core.getFileName());
+		fBasisUsed = fDirty = true;
+	}
+	szBasis[0] = '\0';
+	fBasisMatching = false;
+	fBasisMatched = true;
+}
+
 bool C4Network2Res::OptimizeStandalone(bool fSilent)
 {
 	CStdLock FileLock(&FileCSec);
@@ -1349,6 +1671,8 @@ bool C4Network2ResList::Init(int32_t inClientID, C4Network2IO *pIOClass) // by m
 	SetLocalID(inClientID);
 	// create network path
 	if (!CreateNetworkFolder()) return false;
+	// the cache is optional
+	Cache.Init();
 	// ok
 	return true;
 }
@@ -1473,14 +1797,17 @@ C4Network2Res::Ref C4Network2ResList::AddByCore(const C4Network2ResCore &Core, b
 	// create new
 	pRes = new C4Network2Res(this);
 	// try set by core
-	if (!pRes->SetByCore(Core, true))
+	if (pRes->SetByCore(Core, true))
+		Application.InteractiveThread.ThreadLogSF("Network: Found identical %s. Not loading.", pRes->getCore().getFileName());
+	// try the cache
+	else if (pRes->SetByCache(Core))
+		Application.InteractiveThread.ThreadLogSF("Network: Found %s in resource cache. Not loading.", pRes->getCore().getFileName());
+	else
 	{
 		pRes.Clear();
 		// try load (if specified)
 		return fLoad ? AddLoad(Core) : nullptr;
 	}
-	// log
-	Application.InteractiveThread.ThreadLogSF("Network: Found identical %s. Not loading.", pRes->getCore().getFileName());
 	// add to list
 	Add(pRes);
 	// ok
@@ -1517,6 +1844,8 @@ void C4Network2ResList::RemoveAtClient(int32_t iClientID) // by main thread
 
 void C4Network2ResList::Clear()
 {
+	// jobs of this game must not outlive it
+	StopFileJobs();
 	CStdShareLock ResListLock(&ResListCSec);
 	for (C4Network2Res *pRes = pFirst; pRes; pRes = pRes->pNext)
 	{
@@ -1604,6 +1933,28 @@ void C4Network2ResList::HandlePacket(char cStatus, const C4PacketBase *pPacket,
 		if (pRes) pRes->OnChunk(Chunk);
 	}
 	break;
+
+	case PID_NetResHashReq: // chunk hashes request
+	{
+		GETPKT(C4PacketResRequest, Pkt);
+		// find ressource
+		CStdShareLock ResListLock(&ResListCSec);
+		C4Network2Res *pRes = getRes(Pkt.getReqID());
+		// send hashes
+		if (pRes && pRes->IsBinaryCompatible()) pRes->SendChunkHashes(pConn);
+	}
+	break;
+
+	case PID_NetResHashes: // chunk hashes are coming in
+	{
+		GETPKT(C4PacketResChunkHashes, Hashes);
+		// find ressource
+		CStdShareLock ResListLock(&ResListCSec);
+		C4Network2Res *pRes = getRes(Hashes.getResID());
+		// reuse cached chunks
+		if (pRes) pRes->OnChunkHashes(Hashes);
+	}
+	break;
 	}
 #undef GETPKT
 }
@@ -1696,6 +2047,54 @@ void C4Network2ResList::OnResComplete(C4Network2Res *pRes)
 	Game.Control.Network.OnResComplete(pRes);
 }
 
+void C4Network2ResList::AddFileJob(std::function<void()> Job)
+{
+	{
+		const std::lock_guard<std::mutex> lock{FileJobMutex};
+		if (fFileJobsStopping) return;
+		FileJobs.emplace_back(std::move(Job));
+		// started on first use
+		if (!FileJobThread.joinable())
+			FileJobThread = std::thread{[this] { ExecuteFileJobs(); }};
+	}
+	FileJobWake.notify_one();
+}
+
+void C4Network2ResList::StopFileJobs()
+{
+	{
+		const std::lock_guard<std::mutex> lock{FileJobMutex};
+		fFileJobsStopping = true;
+	}
+	FileJobWake.notify_all();
+	// waits for the running job
+	if (FileJobThread.joinable()) FileJobThread.join();
+	// pending jobs only release their references; new ones may be added for the next game
+	std::deque<std::function<void()>> PendingJobs;
+	{
+		const std::lock_guard<std::mutex> lock{FileJobMutex};
+		PendingJobs.swap(FileJobs);
+		fFileJobsStopping = false;
+	}
+}
+
+void C4Network2ResList::ExecuteFileJobs()
+{
+	C4Thread::SetCurrentThreadName("NetResFiles");
+	for (;;)
+	{
+		std::function<void()> Job;
+		{
+			std::unique_lock<std::mutex> lock{FileJobMutex};
+			FileJobWake.wait(lock, [this] { return fFileJobsStopping || !FileJobs.empty(); });
+			if (fFileJobsStopping) return;
+			Job = std::move(FileJobs.front());
+			FileJobs.pop_front();
+		}
+		Job();
+	}
+}
+
 bool C4Network2ResList::CreateNetworkFolder()
 {
 	// get network path without trailing backslash
@@ -19,10 +19,18 @@
 #pragma once
 
 #include "C4ForwardDeclarations.h"
+#include "C4Network2ResCache.h"
 #include <StdSha1.h>
 #include <StdSync.h>
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 const uint32_t C4NetResChunkSize = 100U * 1024U;
 
@@ -33,7 +41,9 @@ const int32_t C4NetResDiscoverTimeout = 10, // (s)
               C4NetResMaxLoad = 20,
               C4NetResLoadTimeout = 60, // (s)
               C4NetResDeleteTime = 60, // (s)
-              C4NetResMaxBigicon = 20; // maximum size, in KB, of bigicon
+              C4NetResHashTimeout = 10, // (s) how long to wait for chunk hashes before loading without cached basis
+              C4NetResMaxBigicon = 20, // maximum size, in KB, of bigicon
+              C4NetResMaxChunkHashes = 65536;
 
 const int32_t C4NetResIDAnonymous = -2;
 
@@ -53,6 +63,7 @@ enum C4Network2ResType
 #include "C4Network2IO.h"
 class C4Network2ResList;
 class C4Network2ResChunk;
+class C4PacketResChunkHashes;
 
 // classes
 class C4Network2ResCore : public C4PacketBase
@@ -142,6 +153,7 @@ public:
 	int32_t getPresentChunkCnt() const { return iPresentChunkCnt; }
 	int32_t getPresentPercent()  const { return iPresentChunkCnt * 100 / iChunkCnt; }
 	bool    isComplete()         const { return iPresentChunkCnt == iChunkCnt; }
+	bool    isChunkPresent(int32_t iChunk) const;
 
 	void SetIncomplete(int32_t iChunkCnt);
 	void SetComplete(int32_t iChunkCnt);
@@ -224,6 +236,16 @@ protected:
 	C4Network2ResLoad *pLoads;
 	int32_t iLoadCnt;
 
+	// older cached version to take unchanged chunks from (only set while waiting for the chunk hashes
+	// and while the file worker searches it for them)
+	char szBasis[_MAX_PATH + 1];
+	time_t iBasisStartTime;
+	bool fHashesRequested, fBasisUsed, fBasisMatching, fBasisMatched;
+
+	// chunk hashes of the standalone, calculated by the file worker on first request
+	std::unique_ptr<C4PacketResChunkHashes> pChunkHashes;
+	std::vector<C4Network2IOConnection *> HashRequests; // referenced; answered once the hashes are ready
+
 	// list (C4Network2ResList)
 	C4Network2Res *pNext;
 	C4Network2ResList *pParent;
@@ -246,6 +268,7 @@ public:
 	bool SetByFile(const char *strFilePath, bool fTemp, C4Network2ResType eType, int32_t iResID, const char *szResName = nullptr, bool fSilent = false);
 	bool SetByGroup(C4Group *pGrp, bool fTemp, C4Network2ResType eType, int32_t iResID, const char *szResName = nullptr, bool fSilent = false);
 	bool SetByCore(const C4Network2ResCore &nCore, bool fSilent = false, const char *szAsFilename = nullptr, int32_t iRecursion = 0);
+	bool SetByCache(const C4Network2ResCore &nCore);
 	bool SetLoad(const C4Network2ResCore &nCore);
 
 	bool SetDerived(const char *strName, const char *strFilePath, bool fTemp, C4Network2ResType eType, int32_t iDResID);
@@ -262,6 +285,7 @@ public:
 
 	bool SendStatus(C4Network2IOConnection *pTo = nullptr);
 	bool SendChunk(uint32_t iChunk, int32_t iToClient);
+	bool SendChunkHashes(C4Network2IOConnection *pTo);
 
 	// references
 	void AddRef(); void DelRef();
@@ -270,6 +294,7 @@ public:
 	void OnDiscover(C4Network2IOConnection *pBy);
 	void OnStatus(const C4Network2ResChunkData &rChunkData, C4Network2IOConnection *pBy);
 	void OnChunk(const C4Network2ResChunk &rChunk);
+	void OnChunkHashes(const C4PacketResChunkHashes &rHashes);
 	bool DoLoad();
 
 	bool NeedsDiscover();
@@ -290,6 +315,9 @@ protected:
 	void RemoveLoad(C4Network2ResLoad *pLoad);
 	void RemoveCChunks(ClientChunks *pChunks);
 
+	void AddChunksFromBasis(const C4PacketResChunkHashes &rHashes); // by file worker
+	void CalculateChunkHashes(); // by file worker
+
 	bool OptimizeStandalone(bool fSilent);
 };
 
@@ -337,6 +365,16 @@ protected:
 	// object used for network i/o
 	C4Network2IO *pIO;
 
+	// complete resources of earlier games
+	C4Network2ResCache Cache;
+
+	// reads and copies whole files, so the network thread doesn't have to wait for them
+	std::mutex FileJobMutex;
+	std::condition_variable FileJobWake;
+	std::deque<std::function<void()>> FileJobs;
+	bool fFileJobsStopping{false};
+	std::thread FileJobThread;
+
 public:
 	// initialization
 	bool Init(int32_t iClientID, C4Network2IO *pIOClass); // by main thread
@@ -380,6 +418,11 @@ public:
 protected:
 	void OnResComplete(C4Network2Res *pRes);
 
+	// file worker
+	void AddFileJob(std::function<void()> Job); // by both
+	void StopFileJobs();
+	void ExecuteFileJobs();
+
 	// misc
 	bool CreateNetworkFolder();
 	bool FindTempResFileName(const char *szFilename, char *pTarget);
@@ -435,3 +478,29 @@ public:
 
 	virtual void CompileFunc(StdCompiler *pComp) override;
 };
+
+// rsync-style hashes of all complete chunks of a resource: a rolling checksum, to find the chunks
+// at any offset of an older version, and the start of the chunk's SHA1 to make sure they match
+class C4PacketResChunkHashes : public C4PacketBase
+{
+public:
+	C4PacketResChunkHashes(int32_t iResID = -1, uint32_t iChunkSize = 0);
+
+protected:
+	int32_t iResID;
+	uint32_t iChunkSize;
+	std::vector<uint32_t> WeakHashes;
+	std::vector<uint64_t> StrongHashes;
+
+public:
+	int32_t  getResID()                      const { return iResID; }
+	uint32_t getChunkSize()                  const { return iChunkSize; }
+	int32_t  getChunkCnt()                   const { return static_cast<int32_t>(WeakHashes.size()); }
+	uint32_t getWeakHash(int32_t iChunk)     const { return WeakHashes[iChunk]; }
+	uint64_t getStrongHash(int32_t iChunk)   const { return StrongHashes[iChunk]; }
+
+	void SetResID(int32_t inResID) { iResID = inResID; }
+	void AddChunk(uint32_t iWeakHash, uint64_t iStrongHash);
+
+	virtual void CompileFunc(StdCompiler *pComp) override;
+};
@@ -0,0 +1,155 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Persistent cache of network resource files */
+
+#include <C4Include.h>
+#include <C4Network2ResCache.h>
+
+#include <C4Config.h>
+#include <C4Log.h>
+
+#ifdef _WIN32
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+
+// Entries are named <contents crc><source key>_<file name>, e.g. 1a2b3c4d00000000_Castle.c4s
+static constexpr size_t C4NetResCacheKeyLength = 16;
+
+C4Network2ResCache::C4Network2ResCache()
+	: fEnabled(false)
+{
+	szPath[0] = '\0';
+}
+
+bool C4Network2ResCache::Init()
+{
+	CStdLock CacheLock(&CacheCSec);
+	fEnabled = false;
+	// disabled?
+	if (Config.Network.MaxResCacheSize <= 0) return true;
+	SCopy(Config.AtNetworkPath("Cache"), szPath, _MAX_PATH);
+	if (!DirectoryExists(szPath) && !CreateDirectory(szPath, nullptr))
+	{
+		LogF("Network: could not create resource cache folder %s!", szPath); return false;
+	}
+	AppendBackslash(szPath);
+	fEnabled = true;
+	// the limit might have been lowered
+	Trim();
+	return true;
+}
+
+bool C4Network2ResCache::FindByContents(uint32_t iContentsCRC, uint32_t iSourceKey, const char *szResName, char *pTo)
+{
+	CStdLock CacheLock(&CacheCSec);
+	if (!fEnabled) return false;
+	char szEntry[_MAX_PATH + 1];
+	GetEntryName(iContentsCRC, iSourceKey, szResName, szEntry);
+	if (!FileExists(szEntry)) return false;
+	// used again: Trim removes the entries that weren't used for the longest time
+#ifdef _WIN32
+	_utime(szEntry, nullptr);
+#else
+	utime(szEntry, nullptr);
+#endif
+	SCopy(szEntry, pTo, _MAX_PATH);
+	return true;
+}
+
+bool C4Network2ResCache::FindBasis(const char *szResName, char *pTo)
+{
+	CStdLock CacheLock(&CacheCSec);
+	if (!fEnabled) return false;
+	// any entry with matching name will do; the newest is most likely to be similar
+	char szEntry[_MAX_PATH + 1];
+	GetEntryName(0, 0, szResName, szEntry);
+	const char *szName = GetFilename(szEntry) + C4NetResCacheKeyLength;
+	time_t iBestTime = 0; bool fFound = false;
+	for (DirectoryIterator i(szPath); *i; ++i)
+	{
+		const char *szFilename = GetFilename(*i);
+		if (SLen(szFilename) <= C4NetResCacheKeyLength || !SEqual(szFilename + C4NetResCacheKeyLength, szName))
+			continue;
+		const time_t iTime = FileTime(*i);
+		if (fFound && iTime <= iBestTime) continue;
+		SCopy(*i, pTo, _MAX_PATH);
+		iBestTime = iTime; fFound = true;
+	}
+	return fFound;
+}
+
+bool C4Network2ResCache::Store(const char *szFile, uint32_t iContentsCRC, uint32_t iSourceKey, const char *szResName)
+{
+	CStdLock CacheLock(&CacheCSec);
+	if (!fEnabled) return false;
+	char szEntry[_MAX_PATH + 1];
+	GetEntryName(iContentsCRC, iSourceKey, szResName, szEntry);
+	// already there?
+	if (FileExists(szEntry)) return true;
+	// would push everything else out?
+	if (FileSize(szFile) > static_cast<size_t>(Config.Network.MaxResCacheSize)) return false;
+	// copy under a temporary name first, so an interrupted copy is never taken for a valid entry
+	char szTemp[_MAX_PATH + 1];
+	SCopy(szEntry, szTemp, _MAX_PATH - 4);
+	SAppend(".tmp", szTemp, _MAX_PATH);
+	if (!CopyFile(szFile, szTemp, false) || !RenameFile(szTemp, szEntry))
+	{
+		EraseFile(szTemp);
+		LogSilentF("Network: could not store %s in resource cache!", GetFilename(szResName));
+		return false;
+	}
+	Trim();
+	return true;
+}
+
+void C4Network2ResCache::GetEntryName(uint32_t iContentsCRC, uint32_t iSourceKey, const char *szResName, char *pTo) const
+{
+	// only keep characters that are safe on all file systems
+	char szName[_MAX_PATH + 1];
+	SCopy(GetFilename(szResName), szName, _MAX_PATH);
+	for (char *pPos = szName; *pPos; ++pPos)
+		if (!std::isalnum(static_cast<unsigned char>(*pPos)) && *pPos != '.')
+			*pPos = '_';
+	snprintf(pTo, _MAX_PATH + 1, "%s%08x%08x_%s", szPath, iContentsCRC, iSourceKey, szName);
+}
+
+void C4Network2ResCache::Trim()
+{
+	struct Entry { std::string Path; time_t Time; size_t Size; };
+	std::vector<Entry> Entries;
+	uint64_t iTotalSize = 0;
+	for (DirectoryIterator i(szPath); *i; ++i)
+		if (!DirectoryExists(*i))
+		{
+			Entries.push_back({*i, FileTime(*i), FileSize(*i)});
+			iTotalSize += Entries.back().Size;
+		}
+	// remove least recently used entries first (hits touch their entry)
+	std::sort(Entries.begin(), Entries.end(), [](const Entry &a, const Entry &b) { return a.Time < b.Time; });
+	for (const auto &entry : Entries)
+	{
+		if (iTotalSize <= static_cast<uint64_t>(Config.Network.MaxResCacheSize)) break;
+		if (EraseFile(entry.Path.c_str()))
+			iTotalSize -= entry.Size;
+	}
+}
@@ -0,0 +1,55 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Persistent cache of network resource files */
+
+#pragma once
+
+#include <StdFile.h>
+#include <StdSync.h>
+
+#include <cstdint>
+
+// Keeps complete resource standalones across games, keyed by contents checksum, source key and name.
+// Hosts take packed folders from here instead of packing them again, clients use entries
+// as complete copies or as basis for reusing unchanged chunks of a newer version.
+// The folder is kept below Config.Network.MaxResCacheSize by removing the least recently used entries.
+class C4Network2ResCache
+{
+public:
+	C4Network2ResCache();
+
+protected:
+	char szPath[_MAX_PATH + 1];
+	bool fEnabled;
+	CStdCSec CacheCSec; // stored to by both threads
+
+public:
+	bool Init(); // by main thread
+
+	bool isEnabled() const { return fEnabled; }
+
+	// entry with exactly these contents; the source key tells apart sources with equal contents checksums
+	// (hosts use a fingerprint of the packed folder, clients check the file checksum of downloads instead)
+	bool FindByContents(uint32_t iContentsCRC, uint32_t iSourceKey, const char *szResName, char *pTo);
+	// newest entry of the resource, whatever its contents
+	bool FindBasis(const char *szResName, char *pTo);
+
+	bool Store(const char *szFile, uint32_t iContentsCRC, uint32_t iSourceKey, const char *szResName);
+
+protected:
+	void GetEntryName(uint32_t iContentsCRC, uint32_t iSourceKey, const char *szResName, char *pTo) const;
+	void Trim();
+};
@@ -131,7 +131,7 @@ void C4Object::Default()
 	Menu = nullptr;
 	PhysicalTemporary = false;
 	TemporaryPhysical.Default();
-	MaterialContents.fill(0);
+	MaterialContents.Clear();
 	Visibility = VIS_All;
 	LocalNamed.Reset();
 	Marker = 0;
@@ -912,7 +912,7 @@ bool C4Object::ExecLife()
 				// Take breath
 				int32_t takebreath = GetPhysical()->Breath - Breath;
 				if (takebreath > GetPhysical()->Breath / 2)
-					Call(PSF_DeepBreath);
+					Call(C4AulCallback::DeepBreath);
 				Breath += takebreath;
 			}
 		}
@@ -1196,6 +1196,7 @@ bool C4Object::ChangeDef(C4ID idNew)
 	Def = pDef;
 	id = pDef->id;
 	Def->Count++;
+	C4ObjectList::InvalidateSummaries();
 	LocalNamed.SetNameList(&pDef->Script.LocalNamed);
 	// new def: Needs to be resorted
 	Unsorted = true;
@@ -1284,7 +1285,7 @@ void C4Object::DoDamage(int32_t iChange, int32_t iCausedBy, int32_t iCause)
 	// Change value
 	Damage = std::max<int32_t>(Damage + iChange, 0);
 	// Engine script call
-	Call(PSF_Damage, {C4VInt(iChange), C4VInt(iCausedBy)});
+	Call(C4AulCallback::Damage, {C4VInt(iChange), C4VInt(iCausedBy)});
 }
 
 // returns x * y, but returns std::numeric_limits<T>::min() or std::numeric_limits<T>::max() in case of a negative or positive overflow respectively
@@ -1529,8 +1530,8 @@ bool C4Object::Exit(int32_t iX, int32_t iY, int32_t iR, C4Fixed iXDir, C4Fixed i
 	UpdateFace(true);
 	SetOCF();
 	// Engine calls
-	if (fCalls) pContainer->Call(PSF_Ejection, {C4VObj(this)});
-	if (fCalls) Call(PSF_Departure, {C4VObj(pContainer)});
+	if (fCalls) pContainer->Call(C4AulCallback::Ejection, {C4VObj(this)});
+	if (fCalls) Call(C4AulCallback::Departure, {C4VObj(pContainer)});
 	// Success (if the obj wasn't "re-entered" by script)
 	return !Contained;
 }
@@ -1547,14 +1548,14 @@ bool C4Object::Enter(C4Object *pTarget, bool fCalls, bool fCopyMotion, bool *pfR
 	// No target or target is self
 	if (!pTarget || (pTarget == this)) return false;
 	// check if entrance is allowed
-	if (Call(PSF_RejectEntrance, {C4VObj(pTarget)})) return false;
+	if (Call(C4AulCallback::RejectEntrance, {C4VObj(pTarget)})) return false;
 	// check if we end up in an endless container-recursion
 	for (C4Object *pCnt = pTarget->Contained; pCnt; pCnt = pCnt->Contained)
 		if (pCnt == this) return false;
 	// Check RejectCollect, if desired
 	if (pfRejectCollect)
 	{
-		if (pTarget->Call(PSF_RejectCollection, {C4VID(Def->id), C4VObj(this)}))
+		if (pTarget->Call(C4AulCallback::RejectCollection, {C4VID(Def->id), C4VObj(this)}))
 		{
 			*pfRejectCollect = true;
 			return false;
@@ -1595,10 +1596,10 @@ bool C4Object::Enter(C4Object *pTarget, bool fCalls, bool fCopyMotion, bool *pfR
 	Contained->UpdateMass();
 	Contained->SetOCF();
 	// Collection call
-	if (fCalls) pTarget->Call(PSF_Collection2, {C4VObj(this)});
+	if (fCalls) pTarget->Call(C4AulCallback::Collection2, {C4VObj(this)});
 	if (!Contained || !Contained->Status || !pTarget->Status) return true;
 	// Entrance call
-	if (fCalls) Call(PSF_Entrance, {C4VObj(Contained)});
+	if (fCalls) Call(C4AulCallback::Entrance, {C4VObj(Contained)});
 	if (!Contained || !Contained->Status || !pTarget->Status) return true;
 	// Base auto sell contents
 	if (ValidPlr(Contained->Base))
@@ -1800,7 +1801,7 @@ bool C4Object::Push(C4Fixed txdir, C4Fixed dforce, bool fStraighten)
 		if (ContactCheck(x, y)) // Resets t_contact
 		{
 			GameMsgObject(FormatString(LoadResStr("IDS_OBJ_STUCK"), GetName()).getData(), this);
-			Call(PSF_Stuck);
+			Call(C4AulCallback::Stuck);
 		}
 
 	return true;
@@ -1830,7 +1831,7 @@ bool C4Object::Lift(C4Fixed tydir, C4Fixed dforce)
 		if (ContactCheck(x, y)) // Resets t_contact
 		{
 			GameMsgObject(FormatString(LoadResStr("IDS_OBJ_STUCK"), GetName()).getData(), this);
-			Call(PSF_Stuck);
+			Call(C4AulCallback::Stuck);
 		}
 	return true;
 }
@@ -2198,6 +2199,14 @@ C4Value C4Object::Call(const char *szFunctionCall, const C4AulParSet &pPars, boo
 	return Def->Script.ObjectCall(this, this, szFunctionCall, pPars, fPassError, convertNilToIntBool);
 }
 
+C4Value C4Object::Call(C4AulCallback callback, const C4AulParSet &pPars, bool fPassError, bool convertNilToIntBool)
+{
+	if (!Status || !Def) return C4VNull;
+	C4AulScriptFunc *const func{Def->Script.GetCallback(callback)};
+	if (!func) return C4VNull;
+	return func->Exec(this, pPars, fPassError, true, convertNilToIntBool);
+}
+
 bool C4Object::SetPhase(int32_t iPhase)
 {
 	if (Action.Act <= ActIdle) return false;
@@ -2719,13 +2728,13 @@ void C4Object::CompileFunc(StdCompiler *pComp)
 
 	// Write the name only if the object has an individual name, use def name as default for reading.
 	// (Info may overwrite later, see C4Player::MakeCrewMember)
-	if (pComp->isCompiler())
+	// Binary compilers can't skip values, so they always get the name.
+	if (pComp->isCompiler() || !pComp->hasNaming())
 	{
 		pComp->Value(mkNamingAdapt(CustomName, "Name", std::string{}));
 	}
 	else if (!CustomName.empty())
 		// Write the name only if the object has an individual name
-		// 2do: And what about binary compilers?
 		pComp->Value(mkNamingAdapt(CustomName, "Name"));
 
 	pComp->Value(mkNamingAdapt(Number,                                  "Number",             -1));
@@ -2821,8 +2830,11 @@ void C4Object::CompileFunc(StdCompiler *pComp)
 			for (int i = 1; pCmd; i++, pCmd = pCmd->Next)
 			{
 				StdStrBuf Naming = FormatString("Command%d", i);
-				pComp->Value(mkNamingAdapt(*pCmd, Naming.getData()));
+				pComp->Value(mkNamingPtrAdapt(pCmd, Naming.getData()));
 			}
+			// binary compilers read up to a null command
+			if (!pComp->hasNaming())
+				pComp->Value(mkNamingPtrAdapt(pCmd, "Command"));
 		}
 
 	// Compiling? Do initialization.
@@ -3188,7 +3200,7 @@ void C4Object::Clear()
 	if (BackParticles)   BackParticles.Clear();
 	delete pSolidMaskData;   pSolidMaskData   = nullptr;
 	delete Menu;             Menu             = nullptr;
-	MaterialContents.fill(0);
+	MaterialContents.Clear();
 	// clear commands!
 	C4Command *pCom, *pNext;
 	for (pCom = Command; pCom; pCom = pNext)
@@ -3213,7 +3225,7 @@ bool C4Object::ContainedControl(uint8_t byCom)
 			if (Contained->Category & C4D_Structure)
 				return false; // or true? Currently it doesn't matter.
 	// get script function if defined
-	C4AulFunc *sf = Contained->Def->Script.GetSFunc(FormatString(PSF_ContainedControl, ComName(byCom)).getData());
+	C4AulFunc *sf = Contained->Def->Script.GetContainedControlCallback(byCom);
 	// in old versions, do hardcoded actions first (until gwe3)
 	// new objects may overload them
 	C4Def *pCDef = Contained->Def;
@@ -3228,7 +3240,7 @@ bool C4Object::ContainedControl(uint8_t byCom)
 		if (Contained && !(byCom & (COM_Single | COM_Double)) && pPlr->ControlStyle)
 		{
 			int32_t PressedComs = pPlr->PressedComs;
-			Contained->Call(PSF_ContainedControlUpdate, {C4VObj(this), C4VInt(Coms2ComDir(PressedComs)),
+			Contained->Call(C4AulCallback::ContainedControlUpdate, {C4VObj(this), C4VInt(Coms2ComDir(PressedComs)),
 				C4VBool(!!(PressedComs & (1 << COM_Dig))), C4VBool(!!(PressedComs & (1 << COM_Throw)))});
 		}
 	}
@@ -3242,7 +3254,7 @@ bool C4Object::ContainedControl(uint8_t byCom)
 		break;
 	case COM_Throw_D:
 		// avoid breaking objects with non-default behavior on ContainedThrow
-		if (Contained->Def->Script.GetSFunc(FormatString(PSF_ContainedControl, ComName(COM_Throw)).getData()))
+		if (Contained->Def->Script.GetContainedControlCallback(COM_Throw))
 		{
 			break;
 		}
@@ -3270,7 +3282,7 @@ bool C4Object::ContainedControl(uint8_t byCom)
 		if (Contained && !(byCom & (COM_Single | COM_Double)) && pPlr->ControlStyle)
 		{
 			int32_t PressedComs = pPlr->PressedComs;
-			Contained->Call(PSF_ContainedControlUpdate, {C4VObj(this), C4VInt(Coms2ComDir(PressedComs)),
+			Contained->Call(C4AulCallback::ContainedControlUpdate, {C4VObj(this), C4VInt(Coms2ComDir(PressedComs)),
 				C4VBool(!!(PressedComs & (1 << COM_Dig))), C4VBool(!!(PressedComs & (1 << COM_Throw)))});
 		}
 	}
@@ -3292,13 +3304,14 @@ bool C4Object::CallControl(C4Player *pPlr, uint8_t byCom, const C4AulParSet &pPa
 {
 	assert(pPlr);
 
-	bool result = static_cast<bool>(Call(FormatString(PSF_Control, ComName(byCom)).getData(), pPars));
+	C4AulScriptFunc *const sf{Status ? Def->Script.GetControlCallback(byCom) : nullptr};
+	bool result = sf && static_cast<bool>(sf->Exec(this, pPars, false, true));
 
 	// Call ControlUpdate when using Jump'n'Run control
 	if (pPlr->ControlStyle)
 	{
 		int32_t PressedComs = pPlr->PressedComs;
-		Call(PSF_ControlUpdate, {pPars[0]._getBool() ? pPars[0] : C4VObj(this),
+		Call(C4AulCallback::ControlUpdate, {pPars[0]._getBool() ? pPars[0] : C4VObj(this),
 			C4VInt(Coms2ComDir(PressedComs)),
 			C4VBool(!!(PressedComs & (1 << COM_Dig))),
 			C4VBool(!!(PressedComs & (1 << COM_Throw))),
@@ -3522,7 +3535,7 @@ void C4Object::DirectCom(uint8_t byCom, int32_t iData) // By player ObjectCom
 		case COM_Down_D: ObjectComUnGrab(this); break;
 		case COM_Throw_D:
 			// avoid breaking objects with non-default behavior on ControlThrow
-			if (!fGrabControlOverload || !Action.Target || Action.Target->Def->Script.GetSFunc(FormatString(PSF_Control, ComName(COM_Throw)).getData()))
+			if (!fGrabControlOverload || !Action.Target || Action.Target->Def->Script.GetControlCallback(COM_Throw))
 			{
 				break;
 			}
@@ -3693,7 +3706,7 @@ void C4Object::AutoStopDirectCom(uint8_t byCom, int32_t iData) // By DirecCom
 		case COM_Down_D:  ObjectComUnGrab(this); break;
 		case COM_Throw_D:
 			// avoid breaking objects with non-default behavior on ControlThrow
-			if (!fGrabControlOverload || !Action.Target || Action.Target->Def->Script.GetSFunc(FormatString(PSF_Control, ComName(COM_Throw)).getData()))
+			if (!fGrabControlOverload || !Action.Target || Action.Target->Def->Script.GetControlCallback(COM_Throw))
 			{
 				break;
 			}
@@ -3812,7 +3825,7 @@ void C4Object::SyncClearance()
 	// Menu
 	CloseMenu(true);
 	// Material contents
-	MaterialContents.fill(0);
+	MaterialContents.Clear();
 	// reset speed of staticback-objects
 	if (Category & C4D_StaticBack)
 	{
@@ -3917,7 +3930,7 @@ void C4Object::SetCommand(int32_t iCommand, C4Object *pTarget, C4Value iTx, int3
 		if (!CloseMenu(false)) return;
 	// Script overload
 	if (fControl)
-		if (Call(PSF_ControlCommand, {C4VString(CommandName(iCommand)),
+		if (Call(C4AulCallback::ControlCommand, {C4VString(CommandName(iCommand)),
 			C4VObj(pTarget),
 			iTx,
 			C4VInt(iTy),
@@ -3929,7 +3942,7 @@ void C4Object::SetCommand(int32_t iCommand, C4Object *pTarget, C4Value iTx, int3
 		if (Contained->Def->VehicleControl & C4D_VehicleControl_Inside)
 		{
 			Contained->Controller = Controller;
-			if (Contained->Call(PSF_ControlCommand, {C4VString(CommandName(iCommand)),
+			if (Contained->Call(C4AulCallback::ControlCommand, {C4VString(CommandName(iCommand)),
 				C4VObj(pTarget),
 				iTx,
 				C4VInt(iTy),
@@ -3943,7 +3956,7 @@ void C4Object::SetCommand(int32_t iCommand, C4Object *pTarget, C4Value iTx, int3
 		if (Action.Target) if (Action.Target->Def->VehicleControl & C4D_VehicleControl_Outside)
 		{
 			Action.Target->Controller = Controller;
-			if (Action.Target->Call(PSF_ControlCommand, {C4VString(CommandName(iCommand)),
+			if (Action.Target->Call(C4AulCallback::ControlCommand, {C4VString(CommandName(iCommand)),
 				C4VObj(pTarget),
 				iTx,
 				C4VInt(iTy),
@@ -3981,22 +3994,21 @@ void C4Object::AddMaterialContents(int32_t iMaterial, int32_t iAmount)
 {
 	// Add amount
 	if (!Inside<int32_t>(iMaterial, 0, C4MaxMaterial)) return;
-	MaterialContents[iMaterial] += iAmount;
+	MaterialContents.Add(iMaterial, iAmount);
 }
 
 void C4Object::DigOutMaterialCast(bool fRequest)
 {
-	// Check material contents for sufficient object cast amounts
-	for (int32_t iMaterial = 0; iMaterial < Game.Material.Num; iMaterial++)
-		if (MaterialContents[iMaterial])
-			if (Game.Material.Map[iMaterial].Dig2Object != C4ID_None)
-				if (Game.Material.Map[iMaterial].Dig2ObjectRatio != 0)
-					if (fRequest || !Game.Material.Map[iMaterial].Dig2ObjectOnRequestOnly)
-						if (MaterialContents[iMaterial] >= Game.Material.Map[iMaterial].Dig2ObjectRatio)
-						{
-							Game.CreateObject(Game.Material.Map[iMaterial].Dig2Object, this, NO_OWNER, x, y + Shape.y + Shape.Hgt, Random(360));
-							MaterialContents[iMaterial] = 0;
-						}
+	// Check material contents for sufficient object cast amounts (ascending material order)
+	for (int32_t iMaterial = MaterialContents.NextMaterial(-1); Inside<int32_t>(iMaterial, 0, Game.Material.Num - 1); iMaterial = MaterialContents.NextMaterial(iMaterial))
+		if (Game.Material.Map[iMaterial].Dig2Object != C4ID_None)
+			if (Game.Material.Map[iMaterial].Dig2ObjectRatio != 0)
+				if (fRequest || !Game.Material.Map[iMaterial].Dig2ObjectOnRequestOnly)
+					if (MaterialContents.Get(iMaterial) >= Game.Material.Map[iMaterial].Dig2ObjectRatio)
+					{
+						Game.CreateObject(Game.Material.Map[iMaterial].Dig2Object, this, NO_OWNER, x, y + Shape.y + Shape.Hgt, Random(360));
+						MaterialContents.Reset(iMaterial);
+					}
 }
 
 void C4Object::DrawCommand(C4Facet &cgoBar, int32_t iAlign, const char *szFunctionFormat,
@@ -5257,7 +5269,7 @@ void C4Object::ExecAction()
 		if (Def->LiftTop)
 			if (Action.Target->y <= (y + Def->LiftTop))
 				if (Action.ComDir == COMD_Up)
-					Call(PSF_LiftTop);
+					Call(C4AulCallback::LiftTop);
 		// General
 		DoGravity(this);
 		break;
@@ -5293,7 +5305,7 @@ void C4Object::ExecAction()
 			if (Status)
 			{
 				SetAction(ActIdle);
-				Call(PSF_AttachTargetLost);
+				Call(C4AulCallback::AttachTargetLost);
 			}
 			return;
 		}
@@ -5318,7 +5330,7 @@ void C4Object::ExecAction()
 				if (Status)
 				{
 					SetAction(ActIdle);
-					Call(PSF_AttachTargetLost);
+					Call(C4AulCallback::AttachTargetLost);
 				}
 				return;
 			}
@@ -5344,7 +5356,7 @@ void C4Object::ExecAction()
 		if (!Action.Target2 || (Action.Target2->Con < FullCon)) fBroke = true;
 		if (fBroke)
 		{
-			Call(PSF_LineBreak, {C4VBool(true)});
+			Call(C4AulCallback::LineBreak, {C4VBool(true)});
 			AssignRemoval();
 			return;
 		}
@@ -5409,7 +5421,7 @@ void C4Object::ExecAction()
 		// Line fBroke
 		if (fBroke)
 		{
-			Call(PSF_LineBreak);
+			Call(C4AulCallback::LineBreak);
 			AssignRemoval();
 			return;
 		}
@@ -5679,11 +5691,11 @@ bool C4Object::Collect(C4Object *pObj)
 	// Cancel attach (hacky)
 	ObjectComCancelAttach(pObj);
 	// Container Collection call
-	Call(PSF_Collection, {C4VObj(pObj)});
+	Call(C4AulCallback::Collection, {C4VObj(pObj)});
 	// Object Hit call
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed1) pObj->Call(PSF_Hit);
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed2) pObj->Call(PSF_Hit2);
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed3) pObj->Call(PSF_Hit3);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed1) pObj->Call(C4AulCallback::Hit);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed2) pObj->Call(C4AulCallback::Hit2);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed3) pObj->Call(C4AulCallback::Hit3);
 	// post-copy the motion of the new container
 	if (pObj->Contained == this) pObj->CopyMotion(this);
 	// done, success
@@ -5953,7 +5965,7 @@ bool C4Object::StatusActivate()
 	UpdateGraphics(false);
 	UpdateFace(true);
 	UpdatePos();
-	Call(PSF_UpdateTransferZone);
+	Call(C4AulCallback::UpdateTransferZone);
 	// done, success
 	return true;
 }
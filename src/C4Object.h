@@ -24,9 +24,11 @@
 #include "C4Facet.h"
 #include "C4Id.h"
 #include "C4Landscape.h"
+#include "C4MaterialContents.h"
 #include "C4ObjectInfo.h"
 #include "C4Particles.h"
 #include "C4Player.h"
+#include "C4Script.h"
 #include "C4Sector.h"
 #include "C4Value.h"
 #include "C4ValueList.h"
@@ -179,7 +181,7 @@ public:
 	C4IDList Component;
 	C4Rect PictureRect;
 	C4NotifyingObjectList Contents;
-	std::array<int32_t, C4MaxMaterial> MaterialContents; // SyncClearance-NoSave //
+	C4MaterialContents MaterialContents; // SyncClearance-NoSave //
 	C4DefGraphics *pGraphics; // currently set object graphics
 	C4Effect *pEffects; // linked list of effects
 	C4ParticleList FrontParticles, BackParticles; // lists of object local particles
@@ -238,6 +240,7 @@ public:
 
 	bool CallControl(C4Player *pPlr, uint8_t byCom, const C4AulParSet &pPars = C4AulParSet{});
 	C4Value Call(const char *szFunctionCall, const C4AulParSet &pPars = C4AulParSet{}, bool fPassError = false, bool convertNilToIntBool = true);
+	C4Value Call(C4AulCallback callback, const C4AulParSet &pPars = C4AulParSet{}, bool fPassError = false, bool convertNilToIntBool = true); // no name lookup; uses the callback table of the def script
 
 	bool ContainedControl(uint8_t byCom);
 
@@ -308,7 +311,7 @@ public:
 	bool SetAction(int32_t iAct, C4Object *pTarget = nullptr, C4Object *pTarget2 = nullptr, int32_t iCalls = SAC_StartCall | SAC_AbortCall, bool fForce = false);
 	bool SetActionByName(const char *szActName, C4Object *pTarget = nullptr, C4Object *pTarget2 = nullptr, int32_t iCalls = SAC_StartCall | SAC_AbortCall, bool fForce = false);
 	void SetDir(int32_t tdir);
-	void SetCategory(int32_t Category) { this->Category = Category; Resort(); SetOCF(); }
+	void SetCategory(int32_t Category) { this->Category = Category; C4ObjectList::InvalidateSummaries(); Resort(); SetOCF(); }
 	int32_t GetProcedure();
 	bool Enter(C4Object *pTarget, bool fCalls = true, bool fCopyMotion = true, bool *pfRejectCollect = nullptr);
 	bool Exit(int32_t iX = 0, int32_t iY = 0, int32_t iR = 0, C4Fixed iXDir = Fix0, C4Fixed iYDir = Fix0, C4Fixed iRDir = Fix0, bool fCalls = true);
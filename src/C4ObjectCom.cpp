@@ -617,7 +617,7 @@ bool ObjectComPut(C4Object *cObj, C4Object *pTarget, C4Object *pThing)
 	// Put call to object script
 	cObj->Call(PSF_Put);
 	// Target collection call
-	pTarget->Call(PSF_Collection, {C4VObj(pThing), C4VBool(true)});
+	pTarget->Call(C4AulCallback::Collection, {C4VObj(pThing), C4VBool(true)});
 	// Success
 	return true;
 }
@@ -739,7 +739,7 @@ bool ObjectComPunch(C4Object *cObj, C4Object *pTarget, int32_t punch)
 		if (pTarget->GetPhysical()->Fight)
 			punch = BoundBy<int32_t>(5 * cObj->GetPhysical()->Fight / pTarget->GetPhysical()->Fight, 0, 10);
 	if (!punch) return true;
-	bool fBlowStopped = static_cast<bool>(pTarget->Call(PSF_QueryCatchBlow, {C4VObj(cObj)}));
+	bool fBlowStopped = static_cast<bool>(pTarget->Call(C4AulCallback::QueryCatchBlow, {C4VObj(cObj)}));
 	if (fBlowStopped && punch > 1) punch = punch / 2; // half damage for caught blow, so shield+armor help in fistfight and vs monsters
 	pTarget->DoEnergy(-punch, false, C4FxCall_EngGetPunched, cObj->Controller);
 	int32_t tdir = +1; if (cObj->Action.Dir == DIR_Left) tdir = -1;
@@ -751,7 +751,7 @@ bool ObjectComPunch(C4Object *cObj, C4Object *pTarget, int32_t punch)
 		if (ObjectActionTumble(pTarget, pTarget->Action.Dir, FIXED100(150) * tdir, itofix(-2)))
 		{
 			pTarget->LastEnergyLossCausePlayer = cObj->Controller; // for kill tracing when pushing enemies off a cliff
-			pTarget->Call(PSF_CatchBlow, {C4VInt(punch), C4VObj(cObj)});
+			pTarget->Call(C4AulCallback::CatchBlow, {C4VInt(punch), C4VObj(cObj)});
 			return true;
 		}
 
@@ -759,7 +759,7 @@ bool ObjectComPunch(C4Object *cObj, C4Object *pTarget, int32_t punch)
 	if (ObjectActionGetPunched(pTarget, FIXED100(250) * tdir, Fix0))
 	{
 		pTarget->LastEnergyLossCausePlayer = cObj->Controller; // for kill tracing when pushing enemies off a cliff
-		pTarget->Call(PSF_CatchBlow, {C4VInt(punch), C4VObj(cObj)});
+		pTarget->Call(C4AulCallback::CatchBlow, {C4VInt(punch), C4VObj(cObj)});
 		return true;
 	}
 
@@ -23,6 +23,67 @@
 #include <C4Wrappers.h>
 #include <C4Application.h>
 
+#include <new>
+
+namespace
+{
+	// Fixed-size block allocator for object links; freed links are kept in a free list for reuse.
+	// Object lists are only touched by the main thread, so no locking is done.
+	class C4ObjectLinkPool
+	{
+		static constexpr std::size_t BlockSize{4096};
+
+		struct FreeLink { FreeLink *Next; };
+		static_assert(sizeof(FreeLink) <= sizeof(C4ObjectLink));
+
+		std::vector<std::unique_ptr<std::byte[]>> Blocks;
+		FreeLink *FirstFree{nullptr};
+
+	public:
+		void *Allocate()
+		{
+			if (!FirstFree) Grow();
+			FreeLink *pLink = FirstFree;
+			FirstFree = pLink->Next;
+			return pLink;
+		}
+
+		void Free(void *ptr)
+		{
+			FirstFree = new (ptr) FreeLink{FirstFree};
+		}
+
+	private:
+		void Grow()
+		{
+			std::byte *pBlock = Blocks.emplace_back(new std::byte[BlockSize * sizeof(C4ObjectLink)]).get();
+			// chain the new links so they are handed out in address order
+			for (std::size_t i = BlockSize; i--; )
+				Free(pBlock + i * sizeof(C4ObjectLink));
+		}
+	};
+
+	C4ObjectLinkPool &GetLinkPool()
+	{
+		// never destroyed, as global object lists may be cleared during static destruction
+		static auto *const pPool = new C4ObjectLinkPool;
+		return *pPool;
+	}
+}
+
+void *C4ObjectLink::operator new(std::size_t size)
+{
+	assert(size == sizeof(C4ObjectLink));
+	return GetLinkPool().Allocate();
+}
+
+void C4ObjectLink::operator delete(void *ptr) noexcept
+{
+	if (ptr) GetLinkPool().Free(ptr);
+}
+
+uint32_t C4ObjectList::iCurrentSummaryGeneration = 0;
+
 C4ObjectList::C4ObjectList() : FirstIter(nullptr)
 {
 	Default();
@@ -48,6 +109,9 @@ void C4ObjectList::Clear()
 	}
 	First = Last = nullptr;
 	pEnumerated.reset();
+	pSortHints.reset();
+	dwSummaryCategory = 0; dwSummaryIDs = 0;
+	iSummaryGeneration = iCurrentSummaryGeneration;
 }
 
 const int MaxTempListID = 500;
@@ -146,28 +210,29 @@ bool C4ObjectList::Add(C4Object *nObj, SortType eSort, C4ObjectList *pLstSorted)
 		bool fUnsorted = nObj->Unsorted || nObj->Def->Line;
 		if (!fUnsorted)
 		{
+			const int32_t iCategory = nObj->Category & C4D_SortLimit;
+			// Find successor by relative category
+			cLnk = FindSortPosition(iCategory);
+			cPrev = cLnk ? cLnk->Prev : Last;
+			while (cPrev && !(cPrev->Obj->Status && !cPrev->Obj->Unsorted)) cPrev = cPrev->Prev;
+
 			// Find successor by matching category / id
 			// Sort by matching category/id is necessary for inventory shifting.
 			// It is not done for static back to allow multiobject outside structure.
 			// Unsorted objects are ignored in comparison.
+			// Sorted links are ordered by descending category, so the only candidates follow the category position.
 			if (!(nObj->Category & C4D_StaticBack))
-				for (cPrev = nullptr, cLnk = First; cLnk; cLnk = cLnk->Next)
+				for (C4ObjectLink *cPrev2 = cPrev; cLnk; cLnk = cLnk->Next)
 					if (cLnk->Obj->Status && !cLnk->Obj->Unsorted)
 					{
-						if ((cLnk->Obj->Category & C4D_SortLimit) == (nObj->Category & C4D_SortLimit))
-							if (cLnk->Obj->id == nObj->id)
-								break;
-						cPrev = cLnk;
-					}
-
-			// Find successor by relative category
-			if (!cLnk)
-				for (cPrev = nullptr, cLnk = First; cLnk; cLnk = cLnk->Next)
-					if (cLnk->Obj->Status && !cLnk->Obj->Unsorted)
-					{
-						if ((cLnk->Obj->Category & C4D_SortLimit) <= (nObj->Category & C4D_SortLimit))
+						if ((cLnk->Obj->Category & C4D_SortLimit) != iCategory)
 							break;
-						cPrev = cLnk;
+						if (cLnk->Obj->id == nObj->id)
+						{
+							cPrev = cPrev2;
+							break;
+						}
+						cPrev2 = cLnk;
 					}
 
 			cLnk = cPrev ? cPrev->Next : First;
@@ -232,9 +297,46 @@ bool C4ObjectList::Add(C4Object *nObj, SortType eSort, C4ObjectList *pLstSorted)
 	// Add mass
 	Mass += nObj->Mass;
 
+	// Update summary
+	dwSummaryCategory |= nObj->Category;
+	dwSummaryIDs |= GetSummaryIDBit(nObj->id);
+
 	return true;
 }
 
+C4ObjectLink *C4ObjectList::FindSortPosition(int32_t iCategory)
+{
+	const auto IsSorted = [](C4ObjectLink *pLnk) { return pLnk->Obj->Status && !pLnk->Obj->Unsorted; };
+	const auto IsAtOrBelow = [&](C4ObjectLink *pLnk) { return IsSorted(pLnk) && (pLnk->Obj->Category & C4D_SortLimit) <= iCategory; };
+
+	// Short lists are just searched from the start
+	C4ObjectLink *cLnk = First;
+	if (!pSortHints)
+	{
+		int32_t iSteps = 0;
+		for (; cLnk && !IsAtOrBelow(cLnk); cLnk = cLnk->Next) ++iSteps;
+		if (iSteps < 64) return cLnk;
+		pSortHints = std::make_unique<std::array<C4ObjectLink *, C4D_SortLimit + 1>>();
+		pSortHints->fill(nullptr);
+		(*pSortHints)[iCategory] = cLnk ? cLnk : Last;
+		return cLnk;
+	}
+
+	// Long lists: Start at the hint, which stays a member of this list, but may be out of date.
+	// Seek forward to a link of the category or below, then back over preceding links that are in range, too.
+	// The result is the same as that of a full search as long as the list is sorted (see CheckCategorySort).
+	if (C4ObjectLink *pHint = (*pSortHints)[iCategory]) cLnk = pHint;
+	while (cLnk && !IsAtOrBelow(cLnk)) cLnk = cLnk->Next;
+	for (C4ObjectLink *cPrev = cLnk ? cLnk->Prev : Last; cPrev; cPrev = cPrev->Prev)
+		if (IsSorted(cPrev))
+		{
+			if (!IsAtOrBelow(cPrev)) break;
+			cLnk = cPrev;
+		}
+	(*pSortHints)[iCategory] = cLnk ? cLnk : Last;
+	return cLnk;
+}
+
 bool C4ObjectList::Remove(C4Object *pObj)
 {
 	C4ObjectLink *cLnk;
@@ -259,6 +361,13 @@ bool C4ObjectList::Remove(C4Object *pObj)
 	// Remove mass
 	Mass -= pObj->Mass; if (Mass < 0) Mass = 0;
 
+	// Reset summary
+	if (!First)
+	{
+		dwSummaryCategory = 0; dwSummaryIDs = 0;
+		iSummaryGeneration = iCurrentSummaryGeneration;
+	}
+
 #ifndef NDEBUG
 	if (GetLink(pObj)) BREAKPOINT_HERE;
 #endif
@@ -305,6 +414,30 @@ C4Object *C4ObjectList::GetObject(int Index)
 	return nullptr;
 }
 
+void C4ObjectList::UpdateSummary() const
+{
+	if (iSummaryGeneration == iCurrentSummaryGeneration) return;
+	dwSummaryCategory = 0; dwSummaryIDs = 0;
+	for (C4ObjectLink *cLnk = First; cLnk; cLnk = cLnk->Next)
+	{
+		dwSummaryCategory |= cLnk->Obj->Category;
+		dwSummaryIDs |= GetSummaryIDBit(cLnk->Obj->id);
+	}
+	iSummaryGeneration = iCurrentSummaryGeneration;
+}
+
+bool C4ObjectList::MayContainCategory(uint32_t dwCategory) const
+{
+	UpdateSummary();
+	return !!(dwSummaryCategory & dwCategory);
+}
+
+bool C4ObjectList::MayContainID(C4ID id) const
+{
+	UpdateSummary();
+	return !!(dwSummaryIDs & GetSummaryIDBit(id));
+}
+
 C4ObjectLink *C4ObjectList::GetLink(C4Object *pObj)
 {
 	if (!pObj) return nullptr;
@@ -526,6 +659,8 @@ void C4ObjectList::CompileFunc(StdCompiler *pComp, bool fSaveRefs, bool fSkipPla
 				}
 				catch (const StdCompiler::Exception &e)
 				{
+					// binary data can't be resynchronized after a broken object
+					if (!pComp->hasNaming()) throw;
 					// Failsafe object loading: If an error occurs during object loading, just skip that object and load the next one
 					if (!e.Pos.getLength())
 						LogF("ERROR: Object loading: %s", e.what());
@@ -540,6 +675,8 @@ void C4ObjectList::CompileFunc(StdCompiler *pComp, bool fSaveRefs, bool fSkipPla
 C4Object *C4ObjectList::ObjectPointer(int32_t iNumber)
 {
 	C4ObjectLink *cLnk;
+	// no object: denumerating null pointers shouldn't search all objects
+	if (!iNumber) return nullptr;
 	for (cLnk = First; cLnk; cLnk = cLnk->Next)
 		if (cLnk->Obj->Number == iNumber)
 			return cLnk->Obj;
@@ -609,6 +746,10 @@ void C4ObjectList::ClearInfo(C4ObjectInfo *pInfo)
 
 void C4ObjectList::RemoveLink(C4ObjectLink *pLnk)
 {
+	// Move sort hints off the link
+	if (pSortHints)
+		for (auto &pHint : *pSortHints)
+			if (pHint == pLnk) pHint = pLnk->Next ? pLnk->Next : pLnk->Prev;
 	if (pLnk->Prev) pLnk->Prev->Next = pLnk->Next; else First = pLnk->Next;
 	if (pLnk->Next) pLnk->Next->Prev = pLnk->Prev; else Last = pLnk->Prev;
 }
@@ -725,13 +866,16 @@ void C4ObjectList::Default()
 	First = Last = nullptr;
 	Mass = 0;
 	pEnumerated.reset();
+	pSortHints.reset();
+	dwSummaryCategory = 0; dwSummaryIDs = 0;
+	iSummaryGeneration = iCurrentSummaryGeneration;
 }
 
 void C4ObjectList::UpdateTransferZones()
 {
 	C4Object *cobj; C4ObjectLink *clnk;
 	for (clnk = First; clnk && (cobj = clnk->Obj); clnk = clnk->Next)
-		cobj->Call(PSF_UpdateTransferZone);
+		cobj->Call(C4AulCallback::UpdateTransferZone);
 }
 
 void C4ObjectList::ResetAudibility()
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -38,12 +40,31 @@ class C4ObjectLink
 public:
 	C4Object *Obj;
 	C4ObjectLink *Prev, *Next;
+
+	// links are allocated from a shared pool, because objects move between sector lists all the time
+	static void *operator new(std::size_t size);
+	static void operator delete(void *ptr) noexcept;
 };
 
 class C4ObjectList
 {
 	std::unique_ptr<std::vector<int32_t>> pEnumerated;
 
+	// per sort category: a link at or near the first sorted link of that or a lower category
+	// only allocated for long lists, see FindSortPosition
+	std::unique_ptr<std::array<C4ObjectLink *, C4D_SortLimit + 1>> pSortHints;
+
+	C4ObjectLink *FindSortPosition(int32_t iCategory);
+
+	// Conservative summary of the listed objects: every listed object's category and id bit is set, but
+	// bits of removed objects may remain. Rebuilt lazily after InvalidateSummaries.
+	mutable uint32_t dwSummaryCategory;
+	mutable uint64_t dwSummaryIDs;
+	mutable uint32_t iSummaryGeneration;
+	static uint32_t iCurrentSummaryGeneration;
+	void UpdateSummary() const;
+	static uint64_t GetSummaryIDBit(C4ID id) { return uint64_t{1} << ((static_cast<uint32_t>(id) * 0x9e3779b1u) >> 26); }
+
 public:
 	C4ObjectList();
 	C4ObjectList(const C4ObjectList &List);
@@ -125,6 +146,10 @@ public:
 
 	C4ObjectLink *GetLink(C4Object *pObj);
 
+	static void InvalidateSummaries() { ++iCurrentSummaryGeneration; } // call when category or id of a listed object changes
+	bool MayContainCategory(uint32_t dwCategory) const; // false if no listed object has any of the category bits
+	bool MayContainID(C4ID id) const; // false if no listed object has the id
+
 	C4ID GetListID(int32_t dwCategory, int Index);
 
 	bool OrderObjectBefore(C4Object *pObj1, C4Object *pObj2); // order pObj1 before pObj2
@@ -143,6 +168,7 @@ protected:
 	virtual void InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore);
 	virtual void InsertLink(C4ObjectLink *pLink, C4ObjectLink *pAfter);
 	virtual void RemoveLink(C4ObjectLink *pLnk);
+	void ResetSortHints() { pSortHints.reset(); } // must be called when links are moved without RemoveLink
 	iterator *FirstIter;
 	iterator *AddIter(iterator *iter);
 	void RemoveIter(iterator *iter);
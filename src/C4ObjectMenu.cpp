@@ -300,7 +300,7 @@ bool C4ObjectMenu::DoRefillInternal(bool &rfRefilled)
 				if (Identification == C4MN_Contents)
 				{
 					if (Object && Object->Def->CollectionLimit && (Object->Contents.ObjectCount() >= Object->Def->CollectionLimit)) fGet = false; // collection limit reached
-					if (Object && Object->Call(PSF_RejectCollection, {C4VID(pObj->Def->id), C4VObj(pObj)})) fGet = false; // collection rejected
+					if (Object && Object->Call(C4AulCallback::RejectCollection, {C4VID(pObj->Def->id), C4VObj(pObj)})) fGet = false; // collection rejected
 				}
 				if (!(pTarget->OCF & OCF_Entrance)) fGet = true; // target object has no entrance: cannot activate - force get
 				// Caption
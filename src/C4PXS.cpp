@@ -21,16 +21,23 @@
 
 #include <C4Physics.h>
 #include <C4Random.h>
+#include <C4SyncHash.h>
 #include <C4Wrappers.h>
 
+#include <algorithm>
+#include <functional>
+
 static const C4Fixed WindDrift_Factor = itofix(1, 800);
 
-void C4PXS::Execute()
+void C4PXSSystem::Execute(size_t slot)
 {
+	// work on copies; material reactions may change them by reference or create new PXS, growing the arrays
+	int32_t iMat = Mat[slot];
+	C4Fixed x = X[slot], y = Y[slot], xdir = XDir[slot], ydir = YDir[slot];
 #ifdef DEBUGREC_PXS
 	{
 		C4RCExecPXS rc;
-		rc.x = x; rc.y = y; rc.iMat = Mat;
+		rc.x = x; rc.y = y; rc.iMat = iMat;
 		rc.pos = 0;
 		AddDbgRec(RCT_ExecPXS, &rc, sizeof(rc));
 	}
@@ -38,30 +45,30 @@ void C4PXS::Execute()
 	int32_t inmat;
 
 	// Safety
-	if (!MatValid(Mat))
+	if (!MatValid(iMat))
 	{
-		Deactivate(); return;
+		Deactivate(slot); return;
 	}
 
 	// Out of bounds
 	if ((x < 0) || (x >= GBackWdt) || (y < -10) || (y >= GBackHgt))
 	{
-		Deactivate(); return;
+		Deactivate(slot); return;
 	}
 
 	// Material conversion
 	int32_t iX = fixtoi(x), iY = fixtoi(y);
 	inmat = GBackMat(iX, iY);
-	C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(Mat, inmat);
-	if (pReact && (*pReact->pFunc)(pReact, iX, iY, iX, iY, xdir, ydir, Mat, inmat, meePXSPos, nullptr))
+	C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(iMat, inmat);
+	if (pReact && (*pReact->pFunc)(pReact, iX, iY, iX, iY, xdir, ydir, iMat, inmat, meePXSPos, nullptr))
 	{
-		Deactivate(); return;
+		Deactivate(slot); return;
 	}
 
 	// Gravity
 	ydir += GravAccel;
 
-	if (GBackDensity(iX, iY + 1) < Game.Material.Map[Mat].Density)
+	if (GBackDensity(iX, iY + 1) < Game.Material.Map[iMat].Density)
 	{
 		// Air speed: Wind plus some random
 		int32_t iWind = GBackWind(iX, iY);
@@ -69,7 +76,7 @@ void C4PXS::Execute()
 		C4Fixed tydir = FIXED256(Random(1200) - 600);
 
 		// Air friction, based on WindDrift. MaxSpeed is ignored.
-		int32_t iWindDrift = (std::max)(Game.Material.Map[Mat].WindDrift - 20, 0);
+		int32_t iWindDrift = (std::max)(Game.Material.Map[iMat].WindDrift - 20, 0);
 		xdir += ((txdir - xdir) * iWindDrift) * WindDrift_Factor;
 		ydir += ((tydir - ydir) * iWindDrift) * WindDrift_Factor;
 	}
@@ -84,7 +91,9 @@ void C4PXS::Execute()
 		// Check path
 		if (Game.Landscape._PathFree(iX, iY, iToX, iToY))
 		{
-			x = ctcox; y = ctcoy;
+			X[slot] = ctcox; Y[slot] = ctcoy;
+			XDir[slot] = xdir; YDir[slot] = ydir;
+			Mat[slot] = iMat;
 			return;
 		}
 
@@ -96,12 +105,12 @@ void C4PXS::Execute()
 		int32_t inX = iX + Sign(iToX - iX), inY = iY + Sign(iToY - iY);
 		// Contact?
 		inmat = GBackMat(inX, inY);
-		C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(Mat, inmat);
+		C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(iMat, inmat);
 		if (pReact)
-			if ((*pReact->pFunc)(pReact, iX, iY, inX, inY, xdir, ydir, Mat, inmat, meePXSMove, &fStopMovement))
+			if ((*pReact->pFunc)(pReact, iX, iY, inX, inY, xdir, ydir, iMat, inmat, meePXSMove, &fStopMovement))
 			{
 				// destructive contact
-				Deactivate();
+				Deactivate(slot);
 				return;
 			}
 			else
@@ -109,7 +118,9 @@ void C4PXS::Execute()
 				// no destructive contact, but speed or position changed: Stop moving for now
 				if (fStopMovement)
 				{
-					x = itofix(iX); y = itofix(iY);
+					X[slot] = itofix(iX); Y[slot] = itofix(iY);
+					XDir[slot] = xdir; YDir[slot] = ydir;
+					Mat[slot] = iMat;
 					return;
 				}
 				// there was a reaction func, but it didn't do anything - continue movement
@@ -118,11 +129,13 @@ void C4PXS::Execute()
 	} while (iX != iToX || iY != iToY);
 
 	// No contact? Free movement
-	x = ctcox; y = ctcoy;
+	X[slot] = ctcox; Y[slot] = ctcoy;
+	XDir[slot] = xdir; YDir[slot] = ydir;
+	Mat[slot] = iMat;
 #ifdef DEBUGREC_PXS
 	{
 		C4RCExecPXS rc;
-		rc.x = x; rc.y = y; rc.iMat = Mat;
+		rc.x = ctcox; rc.y = ctcoy; rc.iMat = iMat;
 		rc.pos = 1;
 		AddDbgRec(RCT_ExecPXS, &rc, sizeof(rc));
 	}
@@ -130,16 +143,18 @@ void C4PXS::Execute()
 	return;
 }
 
-void C4PXS::Deactivate()
+void C4PXSSystem::Deactivate(size_t slot)
 {
 #ifdef DEBUGREC_PXS
 	C4RCExecPXS rc;
-	rc.x = x; rc.y = y; rc.iMat = Mat;
+	rc.x = X[slot]; rc.y = Y[slot]; rc.iMat = Mat[slot];
 	rc.pos = 2;
 	AddDbgRec(RCT_ExecPXS, &rc, sizeof(rc));
 #endif
-	Mat = MNone;
-	Game.PXS.Delete(this);
+	Mat[slot] = MNone;
+	--Live;
+	FreeSlots.push_back(slot);
+	std::push_heap(FreeSlots.begin(), FreeSlots.end(), std::greater<>{});
 }
 
 C4PXSSystem::C4PXSSystem()
@@ -155,119 +170,124 @@ C4PXSSystem::~C4PXSSystem()
 void C4PXSSystem::Default()
 {
 	Count = 0;
-	for (unsigned int cnt = 0; cnt < PXSMaxChunk; cnt++)
-	{
-		Chunk[cnt] = nullptr;
-		iChunkPXS[cnt] = 0;
-	}
+	Live = 0;
 }
 
 void C4PXSSystem::Clear()
 {
-	for (unsigned int cnt = 0; cnt < PXSMaxChunk; cnt++)
-	{
-		delete[] Chunk[cnt];
-		Chunk[cnt] = nullptr;
-		iChunkPXS[cnt] = 0;
-	}
+	Mat.clear();
+	X.clear(); Y.clear();
+	XDir.clear(); YDir.clear();
+	FreeSlots.clear();
+	Live = 0;
+}
+
+size_t C4PXSSystem::GetCapacity() const
+{
+	return static_cast<size_t>(std::max<int32_t>(Game.C4S.Landscape.MaxPXS, 0));
 }
 
-C4PXS *C4PXSSystem::New()
+bool C4PXSSystem::New(size_t &slot)
 {
-	unsigned int cnt, cnt2;
-	C4PXS *pxp;
-	// Check chunks for available space
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
+	// Reuse the lowest dead slot, so new PXS take the same place in execution order on all clients
+	if (!FreeSlots.empty())
 	{
-		// Create new chunk if necessary
-		if (!Chunk[cnt])
-		{
-			Chunk[cnt] = new C4PXS[PXSChunkSize];
-			iChunkPXS[cnt] = 0;
-		}
-		// Check this chunk for space
-		if (iChunkPXS[cnt] < PXSChunkSize)
-			for (cnt2 = 0, pxp = Chunk[cnt]; cnt2 < PXSChunkSize; cnt2++, pxp++)
-				if (pxp->Mat == MNone)
-				{
-					// count theam
-					iChunkPXS[cnt]++;
-					return pxp;
-				}
+		std::pop_heap(FreeSlots.begin(), FreeSlots.end(), std::greater<>{});
+		slot = FreeSlots.back();
+		FreeSlots.pop_back();
+		++Live;
+		return true;
 	}
-	return nullptr;
+	// Append otherwise
+	if (Mat.size() >= GetCapacity()) return false;
+	slot = Mat.size();
+	Mat.push_back(MNone);
+	X.emplace_back(Fix0); Y.emplace_back(Fix0);
+	XDir.emplace_back(Fix0); YDir.emplace_back(Fix0);
+	++Live;
+	return true;
 }
 
 bool C4PXSSystem::Create(int32_t mat, C4Fixed ix, C4Fixed iy, C4Fixed ixdir, C4Fixed iydir)
 {
-	C4PXS *pxp;
+	size_t slot;
 	if (!MatValid(mat)) return false;
-	if (!(pxp = New())) return false;
-	pxp->Mat = mat;
-	pxp->x = ix; pxp->y = iy;
-	pxp->xdir = ixdir; pxp->ydir = iydir;
+	if (!New(slot)) return false;
+	Mat[slot] = mat;
+	X[slot] = ix; Y[slot] = iy;
+	XDir[slot] = ixdir; YDir[slot] = iydir;
 	return true;
 }
 
 void C4PXSSystem::Execute()
 {
-	// Execute all chunks
+	// Execute all live PXS in slot order
+	// PXS created during execution are appended and thus executed in this frame as well
 	Count = 0;
-	for (unsigned int cchunk = 0; cchunk < PXSMaxChunk; cchunk++)
-		if (Chunk[cchunk])
-			// empty chunk?
-			if (!iChunkPXS[cchunk])
-			{
-				delete[] Chunk[cchunk]; Chunk[cchunk] = nullptr;
-			}
-			else
+	for (size_t slot = 0; slot < Mat.size(); ++slot)
+		if (Mat[slot] != MNone)
+		{
+			Execute(slot);
+			Count++;
+		}
+	// Drop dead slots once they make up most of the arrays
+	if (FreeSlots.size() > std::max(Live, PXSChunkSize))
+		Compact();
+}
+
+void C4PXSSystem::Compact()
+{
+	// Stable compaction: live PXS keep their relative execution order
+	size_t dest = 0;
+	for (size_t slot = 0; slot < Mat.size(); ++slot)
+		if (Mat[slot] != MNone)
+		{
+			if (dest != slot)
 			{
-				// Execute chunk pxs, check for empty
-				C4PXS *pxp = Chunk[cchunk];
-				for (unsigned int cnt2 = 0; cnt2 < PXSChunkSize; cnt2++, pxp++)
-					if (pxp->Mat != MNone)
-					{
-						pxp->Execute();
-						Count++;
-					}
+				Mat[dest] = Mat[slot];
+				X[dest] = X[slot]; Y[dest] = Y[slot];
+				XDir[dest] = XDir[slot]; YDir[dest] = YDir[slot];
 			}
+			++dest;
+		}
+	Mat.resize(dest);
+	X.resize(dest); Y.resize(dest);
+	XDir.resize(dest); YDir.resize(dest);
+	FreeSlots.clear();
 }
 
 void C4PXSSystem::Draw(C4FacetEx &cgo)
 {
+	if (!Live) return;
+
 	// Draw PXS in this region
 	C4Rect VisibleRect(cgo.TargetX, cgo.TargetY, cgo.Wdt, cgo.Hgt);
 	VisibleRect.Enlarge(20);
 
 	// First pass: draw old-style PXS (lines/pixels)
 	int32_t cgox = cgo.X - cgo.TargetX, cgoy = cgo.Y - cgo.TargetY;
-	unsigned int cnt;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
+	for (size_t slot = 0; slot < Mat.size(); ++slot)
+		if (Mat[slot] != MNone && VisibleRect.Contains(fixtoi(X[slot]), fixtoi(Y[slot])))
 		{
-			C4PXS *pxp = Chunk[cnt];
-			for (unsigned int cnt2 = 0; cnt2 < PXSChunkSize; cnt2++, pxp++)
-				if (pxp->Mat != MNone && VisibleRect.Contains(fixtoi(pxp->x), fixtoi(pxp->y)))
-				{
-					C4Material *pMat = &Game.Material.Map[pxp->Mat];
-					if (pMat->PXSFace.Surface && Config.Graphics.PXSGfx)
-						continue;
-					// old-style: unicolored pixels or lines
-					uint32_t dwMatClr = Game.Landscape.GetPal()->GetClr(Mat2PixColDefault(pxp->Mat));
-					if (fixtoi(pxp->xdir) || fixtoi(pxp->ydir))
-					{
-						// lines for stuff that goes whooosh!
-						int len = fixtoi(Abs(pxp->xdir) + Abs(pxp->ydir));
-						dwMatClr = uint32_t(std::max<int>(dwMatClr >> 24, 195 - (195 - (dwMatClr >> 24)) / len)) << 24 | (dwMatClr & 0xffffff);
-						Application.DDraw->DrawLineDw(cgo.Surface,
-							fixtof(pxp->x - pxp->xdir) + cgox, fixtof(pxp->y - pxp->ydir) + cgoy,
-							fixtof(pxp->x) + cgox, fixtof(pxp->y) + cgoy,
-							dwMatClr);
-					}
-					else
-						// single pixels for slow stuff
-						Application.DDraw->DrawPix(cgo.Surface, fixtof(pxp->x) + cgox, fixtof(pxp->y) + cgoy, dwMatClr);
-				}
+			C4Material *pMat = &Game.Material.Map[Mat[slot]];
+			if (pMat->PXSFace.Surface && Config.Graphics.PXSGfx)
+				continue;
+			const C4Fixed x = X[slot], y = Y[slot], xdir = XDir[slot], ydir = YDir[slot];
+			// old-style: unicolored pixels or lines
+			uint32_t dwMatClr = Game.Landscape.GetPal()->GetClr(Mat2PixColDefault(Mat[slot]));
+			if (fixtoi(xdir) || fixtoi(ydir))
+			{
+				// lines for stuff that goes whooosh!
+				int len = fixtoi(Abs(xdir) + Abs(ydir));
+				dwMatClr = uint32_t(std::max<int>(dwMatClr >> 24, 195 - (195 - (dwMatClr >> 24)) / len)) << 24 | (dwMatClr & 0xffffff);
+				Application.DDraw->DrawLineDw(cgo.Surface,
+					fixtof(x - xdir) + cgox, fixtof(y - ydir) + cgoy,
+					fixtof(x) + cgox, fixtof(y) + cgoy,
+					dwMatClr);
+			}
+			else
+				// single pixels for slow stuff
+				Application.DDraw->DrawPix(cgo.Surface, fixtof(x) + cgox, fixtof(y) + cgoy, dwMatClr);
 		}
 
 	// PXS graphics disabled?
@@ -275,28 +295,24 @@ void C4PXSSystem::Draw(C4FacetEx &cgo)
 		return;
 
 	// Second pass: draw new-style PXS (graphics)
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
+	for (size_t slot = 0; slot < Mat.size(); ++slot)
+		if (Mat[slot] != MNone && VisibleRect.Contains(fixtoi(X[slot]), fixtoi(Y[slot])))
 		{
-			C4PXS *pxp = Chunk[cnt];
-			for (unsigned int cnt2 = 0; cnt2 < PXSChunkSize; cnt2++, pxp++)
-				if (pxp->Mat != MNone && VisibleRect.Contains(fixtoi(pxp->x), fixtoi(pxp->y)))
-				{
-					C4Material *pMat = &Game.Material.Map[pxp->Mat];
-					if (!pMat->PXSFace.Surface)
-						continue;
-					// new-style: graphics
-					int32_t pnx, pny;
-					pMat->PXSFace.GetPhaseNum(pnx, pny);
-					int32_t fcWdt = pMat->PXSFace.Wdt; int32_t fcWdtH = (std::max)(fcWdt / 3, 1);
-					// calculate draw width and tile to use (random-ish)
-					int32_t z = 1 + ((cnt2 / std::max<int32_t>(pnx * pny, 1)) ^ 341) % pMat->PXSGfxSize;
-					pny = (cnt2 / pnx) % pny; pnx = cnt2 % pnx;
-					// draw
-					Application.DDraw->ActivateBlitModulation((std::min)((fcWdtH - z) * 16, 255) << 24 | 0xffffff);
-					pMat->PXSFace.DrawX(cgo.Surface, fixtoi(pxp->x) + cgox + z * pMat->PXSGfxRt.tx / fcWdt, fixtoi(pxp->y) + cgoy + z * pMat->PXSGfxRt.ty / fcWdt, z, z * pMat->PXSFace.Hgt / fcWdt, pnx, pny);
-					Application.DDraw->DeactivateBlitModulation();
-				}
+			C4Material *pMat = &Game.Material.Map[Mat[slot]];
+			if (!pMat->PXSFace.Surface)
+				continue;
+			// new-style: graphics
+			const int32_t cnt2 = static_cast<int32_t>(slot % PXSChunkSize);
+			int32_t pnx, pny;
+			pMat->PXSFace.GetPhaseNum(pnx, pny);
+			int32_t fcWdt = pMat->PXSFace.Wdt; int32_t fcWdtH = (std::max)(fcWdt / 3, 1);
+			// calculate draw width and tile to use (random-ish)
+			int32_t z = 1 + ((cnt2 / std::max<int32_t>(pnx * pny, 1)) ^ 341) % pMat->PXSGfxSize;
+			pny = (cnt2 / pnx) % pny; pnx = cnt2 % pnx;
+			// draw
+			Application.DDraw->ActivateBlitModulation((std::min)((fcWdtH - z) * 16, 255) << 24 | 0xffffff);
+			pMat->PXSFace.DrawX(cgo.Surface, fixtoi(X[slot]) + cgox + z * pMat->PXSGfxRt.tx / fcWdt, fixtoi(Y[slot]) + cgoy + z * pMat->PXSGfxRt.ty / fcWdt, z, z * pMat->PXSFace.Hgt / fcWdt, pnx, pny);
+			Application.DDraw->DeactivateBlitModulation();
 		}
 }
 
@@ -317,14 +333,8 @@ void C4PXSSystem::Cast(int32_t mat, int32_t num, int32_t tx, int32_t ty, int32_t
 
 bool C4PXSSystem::Save(C4Group &hGroup)
 {
-	unsigned int cnt;
-
-	// Check used chunk count
-	int32_t iChunks = 0;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
-			iChunks++;
-	if (!iChunks)
+	// Nothing to save?
+	if (!Live)
 	{
 		hGroup.Delete(C4CFN_PXS);
 		return true;
@@ -337,10 +347,22 @@ bool C4PXSSystem::Save(C4Group &hGroup)
 	int32_t iNumFormat = 1;
 	if (!hTempFile.Write(&iNumFormat, sizeof(iNumFormat)))
 		return false;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt]) // must save all chunks in order to keep order consistent on all clients
-			if (!hTempFile.Write(Chunk[cnt], PXSChunkSize * sizeof(C4PXS)))
-				return false;
+	// must save all slots (padded to full chunks) in order to keep order consistent on all clients
+	const size_t iChunkNum = (Mat.size() + PXSChunkSize - 1) / PXSChunkSize;
+	std::vector<C4PXS> Chunk(PXSChunkSize);
+	for (size_t cnt = 0; cnt < iChunkNum; cnt++)
+	{
+		for (size_t cnt2 = 0; cnt2 < PXSChunkSize; cnt2++)
+		{
+			const size_t slot = cnt * PXSChunkSize + cnt2;
+			if (slot < Mat.size())
+				Chunk[cnt2] = {Mat[slot], X[slot], Y[slot], XDir[slot], YDir[slot]};
+			else
+				Chunk[cnt2] = {MNone, Fix0, Fix0, Fix0, Fix0};
+		}
+		if (!hTempFile.Write(Chunk.data(), PXSChunkSize * sizeof(C4PXS)))
+			return false;
+	}
 
 	if (!hTempFile.Close())
 		return false;
@@ -356,7 +378,7 @@ bool C4PXSSystem::Save(C4Group &hGroup)
 bool C4PXSSystem::Load(C4Group &hGroup)
 {
 	// load new
-	size_t iBinSize, iChunkNum, cnt2;
+	size_t iBinSize, iChunkNum;
 	size_t iChunkSize = PXSChunkSize * sizeof(C4PXS);
 	if (!hGroup.AccessEntry(C4CFN_PXS, &iBinSize)) return false;
 	// clear previous
@@ -373,59 +395,89 @@ bool C4PXSSystem::Load(C4Group &hGroup)
 	else if (iBinSize % iChunkSize != 0) return false;
 	// calc chunk count
 	iChunkNum = iBinSize / iChunkSize;
-	if (iChunkNum > PXSMaxChunk) return false;
-	for (uint32_t cnt = 0; cnt < iChunkNum; cnt++)
+	if (iChunkNum * PXSChunkSize > std::max(GetCapacity(), PXSChunkSize * 20)) return false;
+	std::vector<C4PXS> Chunk(PXSChunkSize);
+	for (size_t cnt = 0; cnt < iChunkNum; cnt++)
 	{
-		Chunk[cnt] = new C4PXS[PXSChunkSize];
-		if (!hGroup.Read(Chunk[cnt], iChunkSize)) return false;
-		// count the PXS, Peter!
-		// convert num format, if neccessary
-		C4PXS *pxp; iChunkPXS[cnt] = 0;
-		for (cnt2 = 0, pxp = Chunk[cnt]; cnt2 < PXSChunkSize; cnt2++, pxp++)
-			if (pxp->Mat != MNone)
+		if (!hGroup.Read(Chunk.data(), iChunkSize)) return false;
+		for (const C4PXS &pxs : Chunk)
+		{
+			C4PXS rec = pxs;
+			if (rec.Mat != MNone)
 			{
-				++iChunkPXS[cnt];
+				++Live;
 				// convert number format
-				if (iNumForm == 2) { FLOAT_TO_FIXED(&pxp->x); FLOAT_TO_FIXED(&pxp->y); FLOAT_TO_FIXED(&pxp->xdir); FLOAT_TO_FIXED(&pxp->ydir); }
+				if (iNumForm == 2) { FLOAT_TO_FIXED(&rec.x); FLOAT_TO_FIXED(&rec.y); FLOAT_TO_FIXED(&rec.xdir); FLOAT_TO_FIXED(&rec.ydir); }
 			}
+			else
+				// ascending order is a valid min-heap already
+				FreeSlots.push_back(Mat.size());
+			Mat.push_back(rec.Mat);
+			X.push_back(rec.x); Y.push_back(rec.y);
+			XDir.push_back(rec.xdir); YDir.push_back(rec.ydir);
+		}
+	}
+	// drop the padding of the last chunk: the saving side had no such slots,
+	// and counting them as free would make Execute compact on a different frame
+	while (!Mat.empty() && Mat.back() == MNone)
+	{
+		Mat.pop_back();
+		X.pop_back(); Y.pop_back();
+		XDir.pop_back(); YDir.pop_back();
 	}
+	// free slots are ascending, so the dropped ones are at the end
+	while (!FreeSlots.empty() && FreeSlots.back() >= Mat.size())
+		FreeSlots.pop_back();
 	return true;
 }
 
-void C4PXSSystem::Synchronize()
+void C4PXSSystem::CompileFunc(StdCompiler *pComp)
 {
-	Count = 0;
+	// dead slots are kept, so execution order and slot reuse stay the same
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(Mat), "Mat"));
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(X), "X"));
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(Y), "Y"));
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(XDir), "XDir"));
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(YDir), "YDir"));
+	if (!pComp->isCompiler()) return;
+	if (X.size() != Mat.size() || Y.size() != Mat.size() || XDir.size() != Mat.size() || YDir.size() != Mat.size())
+	{
+		Clear();
+		pComp->excCorrupt("PXS: slot count mismatch");
+		return;
+	}
+	Live = 0;
+	FreeSlots.clear();
+	for (size_t slot = 0; slot < Mat.size(); ++slot)
+		if (Mat[slot] != MNone)
+			++Live;
+		else
+			// ascending order is a valid min-heap already
+			FreeSlots.push_back(slot);
 }
 
-void C4PXSSystem::SyncClearance()
+uint32_t C4PXSSystem::GetSyncHash() const
 {
-	// consolidate chunks; remove empty chunks
-	C4PXS **pDestChunk = Chunk;
-	int32_t iDestChunk = 0;
-	for (unsigned int cnt = 0; cnt < PXSMaxChunk; cnt++)
-	{
-		if (Chunk[cnt] && iChunkPXS[cnt])
-		{
-			*pDestChunk++ = Chunk[cnt];
-			iChunkPXS[iDestChunk++] = iChunkPXS[cnt];
-		}
-		else
+	uint32_t iHash = 0;
+	for (size_t slot = 0; slot < Mat.size(); ++slot)
+		if (Mat[slot] != MNone)
 		{
-			delete[] Chunk[cnt];
-			Chunk[cnt] = nullptr;
+			iHash = SyncHashAdd(iHash, Mat[slot]);
+			iHash = SyncHashAdd(iHash, X[slot].val);
+			iHash = SyncHashAdd(iHash, Y[slot].val);
+			iHash = SyncHashAdd(iHash, XDir[slot].val);
+			iHash = SyncHashAdd(iHash, YDir[slot].val);
 		}
-	}
+	return iHash;
 }
 
-void C4PXSSystem::Delete(C4PXS *pPXS)
+void C4PXSSystem::Synchronize()
+{
+	Count = 0;
+}
+
+void C4PXSSystem::SyncClearance()
 {
-	// find chunk
-	unsigned int cnt;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
-			if (pPXS >= Chunk[cnt] && pPXS < Chunk[cnt] + PXSChunkSize)
-				break;
-	// decrease pxs counter
-	if (cnt < PXSMaxChunk)
-		iChunkPXS[cnt]--;
+	// consolidate slots; remove dead ones
+	Compact();
 }
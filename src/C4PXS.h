@@ -22,22 +22,18 @@
 #include <C4Material.h>
 #include "Fixed.h"
 
-class C4PXS
-{
-	C4PXS() : Mat(MNone), x(Fix0), y(Fix0), xdir(Fix0), ydir(Fix0) {}
-
-	friend class C4PXSSystem;
+#include <vector>
 
-protected:
+// On-disk record of a single pixel sprite; PXS.c4b holds chunks of PXSChunkSize of these
+struct C4PXS
+{
 	int32_t Mat;
 	C4Fixed x, y, xdir, ydir;
-
-protected:
-	void Execute();
-	void Deactivate();
 };
 
-const size_t PXSChunkSize = 500, PXSMaxChunk = 20;
+static_assert(sizeof(C4PXS) == 5 * sizeof(int32_t), "PXS.c4b record layout changed");
+
+const size_t PXSChunkSize = 500;
 
 class C4PXSSystem
 {
@@ -49,11 +45,13 @@ public:
 	int32_t Count;
 
 protected:
-	C4PXS *Chunk[PXSMaxChunk];
-	size_t iChunkPXS[PXSMaxChunk];
+	// Structure of arrays: slot index is execution order, dead slots have Mat == MNone
+	std::vector<int32_t> Mat;
+	std::vector<C4Fixed> X, Y, XDir, YDir;
+	size_t Live; // number of slots with Mat != MNone
+	std::vector<size_t> FreeSlots; // dead slots, kept as min-heap so New() reuses the lowest one
 
 public:
-	void Delete(C4PXS *pPXS);
 	void Default();
 	void Clear();
 	void Execute();
@@ -64,7 +62,13 @@ public:
 	bool Create(int32_t mat, C4Fixed ix, C4Fixed iy, C4Fixed ixdir = Fix0, C4Fixed iydir = Fix0);
 	bool Load(C4Group &hGroup);
 	bool Save(C4Group &hGroup);
+	void CompileFunc(StdCompiler *pComp); // all slots, unlike Save
+	size_t GetCapacity() const;
+	uint32_t GetSyncHash() const;
 
 protected:
-	C4PXS *New();
+	bool New(size_t &slot);
+	void Execute(size_t slot);
+	void Deactivate(size_t slot);
+	void Compact();
 };
@@ -90,6 +90,8 @@ const C4PktHandlingData PktHandlingData[] =
 	{ PID_NetResDerive,       PC_Network, "Resource Derive",             false, true,  PH_C4Network2ResList,    PKT_UNPACK(C4Network2ResCore) },
 	{ PID_NetResReq,          PC_Network, "Resource Request",            false, true,  PH_C4Network2ResList,    PKT_UNPACK(C4PacketResRequest) },
 	{ PID_NetResData,         PC_Network, "Resource Data",               false, true,  PH_C4Network2ResList,    PKT_UNPACK(C4Network2ResChunk) },
+	{ PID_NetResHashReq,      PC_Network, "Resource Chunk Hash Request", false, true,  PH_C4Network2ResList,    PKT_UNPACK(C4PacketResRequest) },
+	{ PID_NetResHashes,       PC_Network, "Resource Chunk Hashes",       false, true,  PH_C4Network2ResList,    PKT_UNPACK(C4PacketResChunkHashes) },
 
 	// C4GameControlNetwork (network thread)
 	{ PID_Control,            PC_Network, "Control",                     false, true,  PH_C4GameControlNetwork, PKT_UNPACK(C4GameControlPacket) },
@@ -129,11 +129,13 @@ enum C4PacketType
 	PID_ReadyCheck     = 0x21,
 
 	// * ressources
-	PID_NetResDis    = 0x30,
-	PID_NetResStat   = 0x31,
-	PID_NetResDerive = 0x32,
-	PID_NetResReq    = 0x33,
-	PID_NetResData   = 0x34,
+	PID_NetResDis     = 0x30,
+	PID_NetResStat    = 0x31,
+	PID_NetResDerive  = 0x32,
+	PID_NetResReq     = 0x33,
+	PID_NetResData    = 0x34,
+	PID_NetResHashReq = 0x35,
+	PID_NetResHashes  = 0x36,
 
 	// * control
 	PID_Control      = 0x40,
@@ -1587,9 +1587,9 @@ void C4Player::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(SelectCount,              "SelectCount",       0));
 	pComp->Value(mkNamingAdapt(SelectFlash,              "SelectFlash",       0));
 	pComp->Value(mkNamingAdapt(CursorFlash,              "CursorFlash",       0));
-	pComp->Value(mkNamingAdapt(reinterpret_cast<int32_t &>(Cursor),        "Cursor",            0));
-	pComp->Value(mkNamingAdapt(reinterpret_cast<int32_t &>(ViewCursor),    "ViewCursor",        0));
-	pComp->Value(mkNamingAdapt(reinterpret_cast<int32_t &>(Captain),       "Captain",           0));
+	pComp->Value(mkNamingAdapt(Cursor,                   "Cursor",            C4EnumeratedObjectPtr{}));
+	pComp->Value(mkNamingAdapt(ViewCursor,               "ViewCursor",        C4EnumeratedObjectPtr{}));
+	pComp->Value(mkNamingAdapt(Captain,                  "Captain",           C4EnumeratedObjectPtr{}));
 	pComp->Value(mkNamingAdapt(LastCom,                  "LastCom",           0));
 	pComp->Value(mkNamingAdapt(LastComDelay,             "LastComDel",        0));
 	pComp->Value(mkNamingAdapt(PressedComs,              "PressedComs",       0));
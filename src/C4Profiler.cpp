@@ -0,0 +1,306 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Low-overhead frame profiler with trace export */
+
+#include "C4Profiler.h"
+
+#include "C4Strings.h"
+#include "CStdFile.h"
+#include "StdBuf.h"
+#include "StdFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/* Binary format (little endian):
+ *   char[4] "C4PF", uint32 version (1)
+ *   uint32 string count, per string: uint16 length, chars (not terminated)
+ *   uint32 thread count, per thread:
+ *     uint32 name string index, uint32 event count, per event:
+ *       uint64 start (ns), uint64 duration (ns), uint32 zone string index, uint32 detail string index (0xffffffff: none)
+ */
+
+std::atomic<bool> C4Profiler::fEnabled{false};
+
+namespace
+{
+	struct C4ProfilerEvent
+	{
+		const char *szZone;
+		std::uint64_t iStart;
+		std::uint64_t iEnd;
+		char szDetail[C4Profiler::MaxDetailLength + 1];
+	};
+
+	// Only the owning thread writes iWritten and the events. Start() just advances the epoch;
+	// each thread resets its buffer itself on the first event recorded in the new epoch.
+	struct C4ProfilerThreadBuffer
+	{
+		std::string Name; // guarded by the state mutex
+		std::atomic<std::uint32_t> iEpoch{0};
+		std::atomic<std::uint64_t> iWritten{0};
+		std::unique_ptr<C4ProfilerEvent[]> Events{new C4ProfilerEvent[C4Profiler::ThreadBufferSize]};
+		// once the thread has exited, its events are kept here and the ring is freed (guarded by the state mutex)
+		bool fThreadExited{false};
+		std::vector<C4ProfilerEvent> ExitedEvents;
+	};
+
+	// buffers of exited threads kept for export; older ones are dropped
+	constexpr std::size_t MaxExitedThreadBuffers{16};
+
+	struct C4ProfilerState
+	{
+		std::mutex Mutex;
+		std::vector<std::unique_ptr<C4ProfilerThreadBuffer>> Buffers;
+	};
+
+	std::atomic<std::uint32_t> CurrentEpoch{1};
+
+	// leaked intentionally: threads may still record during static destruction
+	C4ProfilerState &GetState()
+	{
+		static auto *const pState = new C4ProfilerState;
+		return *pState;
+	}
+
+	const auto Epoch = std::chrono::steady_clock::now();
+
+	thread_local std::string ThreadName;
+
+	void OnThreadExit(C4ProfilerThreadBuffer &buffer);
+
+	// set once the buffer is released, so zones ending in later thread-local destructors aren't recorded
+	thread_local bool fThreadBufferReleased{false};
+
+	struct C4ProfilerThreadBufferRef
+	{
+		C4ProfilerThreadBuffer *pBuffer{nullptr};
+		~C4ProfilerThreadBufferRef()
+		{
+			fThreadBufferReleased = true;
+			if (pBuffer) OnThreadExit(*pBuffer);
+		}
+	};
+
+	thread_local C4ProfilerThreadBufferRef ThreadBuffer;
+
+	C4ProfilerThreadBuffer &GetThreadBuffer()
+	{
+		if (!ThreadBuffer.pBuffer) [[unlikely]]
+		{
+			auto &state = GetState();
+			const std::lock_guard lock{state.Mutex};
+			auto &buffer = state.Buffers.emplace_back(std::make_unique<C4ProfilerThreadBuffer>());
+			buffer->Name = ThreadName.empty() ? FormatString("Thread %zu", state.Buffers.size()).getData() : ThreadName;
+			ThreadBuffer.pBuffer = buffer.get();
+		}
+		return *ThreadBuffer.pBuffer;
+	}
+
+	void AppendJSONString(StdStrBuf &out, const char *szString)
+	{
+		out.AppendChar('"');
+		for (; *szString; ++szString)
+		{
+			const auto c = static_cast<unsigned char>(*szString);
+			if (c == '"' || c == '\\')
+			{
+				out.AppendChar('\\');
+				out.AppendChar(*szString);
+			}
+			else if (c < 0x20)
+				out.AppendFormat("\\u%04x", static_cast<unsigned int>(c));
+			else if (c >= 0x80)
+				// engine strings are Windows-1252; only ASCII is passed through verbatim
+				out.AppendChar('?');
+			else
+				out.AppendChar(*szString);
+		}
+		out.AppendChar('"');
+	}
+
+	// copies the still available events of a buffer in recording order; state mutex must be held
+	std::vector<C4ProfilerEvent> GetEvents(const C4ProfilerThreadBuffer &buffer)
+	{
+		if (buffer.fThreadExited) return buffer.ExitedEvents;
+		// nothing recorded since the last start?
+		if (buffer.iEpoch.load(std::memory_order_acquire) != CurrentEpoch.load(std::memory_order_relaxed)) return {};
+		// events up to the acquired count are complete
+		const std::uint64_t iWritten{buffer.iWritten.load(std::memory_order_acquire)};
+		const std::uint64_t iCount{std::min<std::uint64_t>(iWritten, C4Profiler::ThreadBufferSize)};
+		const std::uint64_t iFirst{iWritten - iCount};
+		std::vector<C4ProfilerEvent> events;
+		events.reserve(static_cast<std::size_t>(iCount));
+		for (std::uint64_t i = iFirst; i < iWritten; ++i)
+			events.push_back(buffer.Events[i % C4Profiler::ThreadBufferSize]);
+		// the thread may have recorded meanwhile: drop the oldest events, whose slots it may have overwritten
+		const std::uint64_t iWrittenAfter{buffer.iWritten.load(std::memory_order_acquire)};
+		const std::uint64_t iFirstValid{iWrittenAfter + 1 > C4Profiler::ThreadBufferSize ? iWrittenAfter + 1 - C4Profiler::ThreadBufferSize : 0};
+		if (iFirstValid > iFirst)
+			events.erase(events.begin(), events.begin() + static_cast<std::ptrdiff_t>(std::min(iFirstValid - iFirst, iCount)));
+		return events;
+	}
+
+	void OnThreadExit(C4ProfilerThreadBuffer &buffer)
+	{
+		auto &state = GetState();
+		const std::lock_guard lock{state.Mutex};
+		// keep only what was recorded, the ring is large
+		buffer.ExitedEvents = GetEvents(buffer);
+		buffer.fThreadExited = true;
+		buffer.Events.reset();
+		const auto isExited = [](const auto &other) { return other->fThreadExited; };
+		if (static_cast<std::size_t>(std::count_if(state.Buffers.begin(), state.Buffers.end(), isExited)) > MaxExitedThreadBuffers)
+			state.Buffers.erase(std::find_if(state.Buffers.begin(), state.Buffers.end(), isExited));
+	}
+
+	bool ExportJSON(CStdFile &file, C4ProfilerState &state)
+	{
+		StdStrBuf out;
+		out.Append("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+		bool fFirst{true};
+		for (std::size_t iThread = 0; iThread < state.Buffers.size(); ++iThread)
+		{
+			const auto &buffer = *state.Buffers[iThread];
+			out.AppendFormat("%s\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%zu,\"args\":{\"name\":", fFirst ? "" : ",", iThread + 1);
+			AppendJSONString(out, buffer.Name.c_str());
+			out.Append("}}");
+			fFirst = false;
+			for (const auto &event : GetEvents(buffer))
+			{
+				out.Append(",\n{\"ph\":\"X\",\"name\":");
+				AppendJSONString(out, *event.szDetail ? event.szDetail : event.szZone);
+				out.Append(",\"cat\":");
+				AppendJSONString(out, event.szZone);
+				out.AppendFormat(",\"pid\":1,\"tid\":%zu,\"ts\":%.3f,\"dur\":%.3f}", iThread + 1, event.iStart / 1000.0, (event.iEnd - event.iStart) / 1000.0);
+			}
+			// flush regularly to keep the buffer small
+			if (!file.Write(out.getData(), out.getLength())) return false;
+			out.Clear();
+		}
+		out.Append("\n]}\n");
+		return file.Write(out.getData(), out.getLength());
+	}
+
+	bool ExportBinary(CStdFile &file, C4ProfilerState &state)
+	{
+		std::vector<std::string> strings;
+		std::unordered_map<std::string, std::uint32_t> stringIndices;
+		const auto getStringIndex = [&](const std::string &string)
+		{
+			const auto [it, fInserted] = stringIndices.try_emplace(string.substr(0, UINT16_MAX), static_cast<std::uint32_t>(strings.size()));
+			if (fInserted) strings.push_back(it->first);
+			return it->second;
+		};
+
+		StdBuf threads;
+		const auto write = [](StdBuf &buf, const auto value) { buf.Append(&value, sizeof(value)); };
+		write(threads, static_cast<std::uint32_t>(state.Buffers.size()));
+		for (const auto &buffer : state.Buffers)
+		{
+			const auto events = GetEvents(*buffer);
+			write(threads, getStringIndex(buffer->Name));
+			write(threads, static_cast<std::uint32_t>(events.size()));
+			for (const auto &event : events)
+			{
+				write(threads, event.iStart);
+				write(threads, event.iEnd - event.iStart);
+				write(threads, getStringIndex(event.szZone));
+				write(threads, *event.szDetail ? getStringIndex(event.szDetail) : UINT32_MAX);
+			}
+		}
+
+		StdBuf header;
+		header.Append("C4PF", 4);
+		write(header, std::uint32_t{1});
+		write(header, static_cast<std::uint32_t>(strings.size()));
+		for (const auto &string : strings)
+		{
+			write(header, static_cast<std::uint16_t>(string.size()));
+			header.Append(string.data(), string.size());
+		}
+		return file.Write(header.getData(), header.getSize()) && file.Write(threads.getData(), threads.getSize());
+	}
+}
+
+void C4Profiler::Start()
+{
+	auto &state = GetState();
+	{
+		const std::lock_guard lock{state.Mutex};
+		// drop buffers of threads that are gone; the others are reset by their threads
+		std::erase_if(state.Buffers, [](const auto &buffer) { return buffer->fThreadExited; });
+		CurrentEpoch.fetch_add(1, std::memory_order_release);
+	}
+	fEnabled.store(true, std::memory_order_release);
+}
+
+void C4Profiler::Stop()
+{
+	fEnabled.store(false, std::memory_order_release);
+}
+
+std::uint64_t C4Profiler::Now()
+{
+	return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Epoch).count());
+}
+
+void C4Profiler::Record(const char *szZone, const char *szDetail, std::uint64_t iStart, std::uint64_t iEnd)
+{
+	if (fThreadBufferReleased) [[unlikely]] return;
+	auto &buffer = GetThreadBuffer();
+	// restarted since the last event? discard the old ones
+	const std::uint32_t iEpoch{CurrentEpoch.load(std::memory_order_acquire)};
+	if (buffer.iEpoch.load(std::memory_order_relaxed) != iEpoch) [[unlikely]]
+	{
+		buffer.iWritten.store(0, std::memory_order_relaxed);
+		buffer.iEpoch.store(iEpoch, std::memory_order_release);
+	}
+	// only this thread writes, so a plain load/store pair is sufficient
+	const std::uint64_t iWritten{buffer.iWritten.load(std::memory_order_relaxed)};
+	auto &event = buffer.Events[iWritten % ThreadBufferSize];
+	event.szZone = szZone;
+	event.iStart = iStart;
+	event.iEnd = iEnd;
+	SCopy(szDetail ? szDetail : "", event.szDetail, MaxDetailLength);
+	buffer.iWritten.store(iWritten + 1, std::memory_order_release);
+}
+
+void C4Profiler::SetCurrentThreadName(const std::string_view name)
+{
+	ThreadName = name;
+	if (ThreadBuffer.pBuffer)
+	{
+		const std::lock_guard lock{GetState().Mutex};
+		ThreadBuffer.pBuffer->Name = ThreadName;
+	}
+}
+
+bool C4Profiler::Export(const char *szFilename)
+{
+	auto &state = GetState();
+	const std::lock_guard lock{state.Mutex};
+	CStdFile file;
+	if (!file.Create(szFilename)) return false;
+	const bool fSuccess{SEqualNoCase(GetExtension(szFilename), "json") ? ExportJSON(file, state) : ExportBinary(file, state)};
+	return file.Close() && fSuccess;
+}
@@ -0,0 +1,101 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Low-overhead frame profiler with trace export */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+// Records timed zones into per-thread ring buffers while enabled at runtime.
+// When disabled, a zone costs a single relaxed atomic load.
+// Zone names must be string literals (or otherwise outlive the profiler data);
+// details are copied (and truncated) when the zone is recorded.
+class C4Profiler
+{
+public:
+	static constexpr std::size_t MaxDetailLength{31};
+	static constexpr std::size_t ThreadBufferSize{1 << 16}; // events per thread; older events are overwritten
+
+	static bool IsEnabled() { return fEnabled.load(std::memory_order_relaxed); }
+	static void Start(); // discards all previously recorded events
+	static void Stop();
+
+	static std::uint64_t Now(); // nanoseconds since process start
+	static void Record(const char *szZone, const char *szDetail, std::uint64_t iStart, std::uint64_t iEnd);
+
+	static void SetCurrentThreadName(std::string_view name);
+
+	// Writes all recorded events. Files ending with .json are written in the Chrome trace event format
+	// (chrome://tracing, Perfetto), everything else in the compact binary format described in C4Profiler.cpp.
+	// Threads that are still recording are exported up to the events they had completed.
+	static bool Export(const char *szFilename);
+
+private:
+	static std::atomic<bool> fEnabled;
+};
+
+// Times the enclosing scope
+class C4ProfilerZone
+{
+public:
+	explicit C4ProfilerZone(const char *szZone, const char *szDetail = nullptr)
+		: szZone(szZone), szDetail(szDetail), iStart(C4Profiler::IsEnabled() ? C4Profiler::Now() : 0) {}
+
+	~C4ProfilerZone()
+	{
+		if (iStart && C4Profiler::IsEnabled()) [[unlikely]]
+			C4Profiler::Record(szZone, szDetail, iStart, C4Profiler::Now());
+	}
+
+	C4ProfilerZone(const C4ProfilerZone &) = delete;
+	C4ProfilerZone &operator=(const C4ProfilerZone &) = delete;
+
+private:
+	const char *szZone;
+	const char *szDetail;
+	std::uint64_t iStart;
+};
+
+// Zone with separate start and stop calls; nested starts are counted and only the outermost pair is recorded
+// Not thread-safe; used for the C4ST_* checkpoints
+class C4ProfilerStat
+{
+public:
+	explicit C4ProfilerStat(const char *szName) : szName(szName) {}
+
+	void Start()
+	{
+		if (!iStartCalled++ && C4Profiler::IsEnabled()) [[unlikely]]
+			iStart = C4Profiler::Now();
+	}
+
+	void Stop()
+	{
+		if (!--iStartCalled && iStart) [[unlikely]]
+		{
+			if (C4Profiler::IsEnabled())
+				C4Profiler::Record(szName, nullptr, iStart, C4Profiler::Now());
+			iStart = 0;
+		}
+	}
+
+private:
+	const char *szName;
+	std::uint64_t iStart{0};
+	unsigned int iStartCalled{0};
+};
@@ -21,8 +21,6 @@
 
 // Random3
 
-const int FRndRes = 500;
-
 int32_t FRndBuf3[FRndRes];
 int32_t FRndPtr3;
 
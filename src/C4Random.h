@@ -74,5 +74,9 @@ inline int SafeRandom(int range)
 	return rand() % range;
 }
 
+const int FRndRes = 500;
+extern int32_t FRndBuf3[FRndRes];
+extern int32_t FRndPtr3;
+
 void Randomize3();
 int Rnd3();
@@ -318,6 +318,12 @@ public:
 	void Strip();
 	bool ExecuteControl(C4Control *pCtrl, int iFrame); // assign control
 	void Clear();
+
+	// seeking; positions stay valid while all chunks are kept in memory
+	using Position = chunks_t::iterator;
+	bool CanSeek() const { return !fLoadSequential; }
+	Position GetPosition() const { return currChunk; }
+	void SetPosition(Position Pos) { currChunk = Pos; Finished = false; }
 #ifdef DEBUGREC
 	void Check(C4RecordChunkType eType, const uint8_t *pData, int iSize); // compare with debugrec
 	void DebugRecError(const char *szError);
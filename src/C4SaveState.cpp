@@ -0,0 +1,281 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* In-memory binary snapshots of the running round (/quicksave, /quickload) */
+
+#include <C4Include.h>
+#include <C4SaveState.h>
+
+#include <C4Application.h>
+#include <C4Console.h>
+#include <C4Game.h>
+#include <C4Log.h>
+#include <C4Object.h>
+#include <C4ObjectInfo.h>
+#include <C4Player.h>
+#include <C4Random.h>
+
+#include <chrono>
+#include <cstring>
+
+void C4SaveState::Header::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(mkNamingAdapt(iMagic, "Magic", 0u));
+	if (iMagic != Magic)
+	{
+		pComp->excCorrupt("SaveState: not a save state");
+		return;
+	}
+	pComp->Value(mkNamingAdapt(iVersion, "Version", 0));
+	if (iVersion != Version)
+	{
+		pComp->excCorrupt("SaveState: version %d is not supported", static_cast<int>(iVersion));
+		return;
+	}
+	pComp->Value(mkNamingAdapt(iFrame, "Frame", 0));
+	pComp->Value(mkNamingAdapt(iLandscapeWdt, "LandscapeWdt", 0));
+	pComp->Value(mkNamingAdapt(iLandscapeHgt, "LandscapeHgt", 0));
+	pComp->Value(mkNamingAdapt(Section, "Section", std::string{}));
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(PlayerIDs), "PlayerIDs", std::vector<int32_t>{}));
+}
+
+C4SaveState::Header C4SaveState::GetCurrentHeader()
+{
+	Header header;
+	header.iFrame = Game.FrameCounter;
+	header.iLandscapeWdt = Game.Landscape.Width;
+	header.iLandscapeHgt = Game.Landscape.Height;
+	header.Section = Game.CurrentScenarioSection;
+	for (C4Player *pPlr = Game.Players.First; pPlr; pPlr = pPlr->Next)
+		header.PlayerIDs.push_back(pPlr->ID);
+	return header;
+}
+
+void C4SaveState::CompileFunc(StdCompiler *pComp)
+{
+	// checked by Restore before anything is compiled
+	Header header = GetCurrentHeader();
+	pComp->Value(mkNamingAdapt(header, "Header"));
+	// random generators
+	pComp->Value(mkNamingAdapt(RandomCount, "RandomCount", 0));
+	pComp->Value(mkNamingAdapt(RandomHold, "RandomHold", 0u));
+	pComp->Value(mkNamingAdapt(FRndPtr3, "Random3Ptr", 0));
+	pComp->Value(mkNamingAdapt(mkArrayAdapt(FRndBuf3), "Random3"));
+	// strings first, values refer to them by enumeration ID
+	pComp->Value(mkNamingAdapt(Game.ScriptEngine.Strings, "Strings"));
+	Game.Landscape.CompilePixels(pComp);
+	pComp->Value(mkNamingAdapt(Game.PXS, "PXS"));
+	pComp->Value(mkNamingAdapt(Game.MassMover, "MassMover"));
+	pComp->Value(mkNamingAdapt(mkParAdapt(Game.Objects, false), "Objects"));
+	pComp->Value(mkNamingAdapt(mkParAdapt(Game.Objects.InactiveObjects, false), "InactiveObjects"));
+	// game data, global effects and players last, so they can refer to all objects
+	Game.CompileSaveState(pComp);
+}
+
+void C4SaveState::EnumeratePointers()
+{
+	Game.Objects.Enumerate();
+	Game.Objects.InactiveObjects.Enumerate();
+	Game.ScriptEngine.Strings.EnumStrings();
+	Game.Players.EnumeratePointers();
+	if (Game.pGlobalEffects) Game.pGlobalEffects->EnumeratePointers();
+}
+
+void C4SaveState::DenumeratePointers()
+{
+	Game.Objects.InactiveObjects.Denumerate();
+	Game.Objects.Denumerate();
+	Game.ScriptEngine.DenumerateVariablePointers();
+	Game.Players.DenumeratePointers();
+	if (Game.pGlobalEffects) Game.pGlobalEffects->DenumeratePointers();
+}
+
+bool C4SaveState::Capture()
+{
+	if (!Game.IsRunning || !Game.PointersDenumerated) return false;
+	// solid masks are restored from the objects
+	Game.Objects.RemoveSolidMasks();
+	EnumeratePointers();
+	bool fSuccess = true;
+	try
+	{
+		Data.Take(DecompileToBuf<StdCompilerBinWrite>(*this));
+	}
+	catch (const StdCompiler::Exception &e)
+	{
+		LogF("SaveState: capture failed: %s", e.what());
+		Data.Clear();
+		fSuccess = false;
+	}
+	DenumeratePointers();
+	Game.Objects.PutSolidMasks();
+	return fSuccess;
+}
+
+void C4SaveState::RemoveObjects()
+{
+	Game.Objects.RemoveSolidMasks();
+	// the cursor is replaced anyway, so C4Player::ClearPointers must not select another one
+	for (C4Player *pPlr = Game.Players.First; pPlr; pPlr = pPlr->Next)
+		pPlr->Cursor = nullptr;
+	// only pointers from outside the restored data; the objects are deleted without removal calls
+	for (C4ObjectList *pList : {static_cast<C4ObjectList *>(&Game.Objects), &Game.Objects.InactiveObjects})
+		for (C4ObjectLink *pLnk = pList->First; pLnk; pLnk = pLnk->Next)
+		{
+			C4Object *pObj = pLnk->Obj;
+			// the crew info is assigned again by name
+			if (pObj->Info)
+			{
+				pObj->Info->Retire();
+				pObj->ClearInfo(pObj->Info);
+			}
+			Game.Messages.ClearPointers(pObj);
+			Game.Players.ClearPointers(pObj);
+			Game.GraphicsSystem.ClearPointers(pObj);
+			Game.MessageInput.ClearPointers(pObj);
+			Console.ClearPointers(pObj);
+			Game.MouseControl.ClearPointers(pObj);
+			Application.SoundSystem->ClearPointers(pObj);
+		}
+	Game.DeleteObjects(true);
+	Game.Particles.ClearParticles();
+}
+
+void C4SaveState::PostRestore()
+{
+	// like loading a savegame, but object numbers can't collide
+	Game.Objects.PostLoad(false);
+	Game.Objects.InactiveObjects.Denumerate();
+	Game.ScriptEngine.DenumerateVariablePointers();
+	Game.Players.DenumeratePointers();
+	if (Game.pGlobalEffects) Game.pGlobalEffects->DenumeratePointers();
+	Game.Objects.PutSolidMasks();
+	Game.Objects.AssignInfo();
+	Game.Objects.AssignPlrViewRange();
+	Game.TransferZones.Synchronize();
+}
+
+bool C4SaveState::Restore()
+{
+	if (!Data.getSize() || !Game.IsRunning || !Game.PointersDenumerated) return false;
+	// check the header first, so a state of another round leaves the game untouched
+	Header Saved, Current = GetCurrentHeader();
+	try
+	{
+		CompileFromBuf<StdCompilerBinRead>(Saved, Data);
+	}
+	catch (const StdCompiler::Exception &e)
+	{
+		LogF("SaveState: %s", e.what());
+		return false;
+	}
+	if (Saved.Section != Current.Section)
+	{
+		LogF("SaveState: captured in section \"%s\", but \"%s\" is running", Saved.Section.c_str(), Current.Section.c_str()); return false;
+	}
+	if (Saved.iLandscapeWdt != Current.iLandscapeWdt || Saved.iLandscapeHgt != Current.iLandscapeHgt)
+	{
+		Log("SaveState: landscape size changed"); return false;
+	}
+	if (Saved.PlayerIDs != Current.PlayerIDs)
+	{
+		Log("SaveState: players joined or left since capture"); return false;
+	}
+	// keep the running round to go back to if the state can't be read completely
+	C4SaveState Fallback;
+	if (!Fallback.Capture()) return false;
+	// replace everything
+	RemoveObjects();
+	if (Apply())
+	{
+		PostRestore();
+		return true;
+	}
+	// objects read so far aren't referenced from outside yet
+	RemoveObjects();
+	if (!Fallback.Apply())
+		Game.DeleteObjects(true);
+	PostRestore();
+	return false;
+}
+
+bool C4SaveState::Apply()
+{
+	try
+	{
+		CompileFromBuf<StdCompilerBinRead>(*this, Data);
+		return true;
+	}
+	catch (const StdCompiler::Exception &e)
+	{
+		LogF("SaveState: restore failed: %s", e.what());
+		return false;
+	}
+}
+
+void C4SaveState::Benchmark()
+{
+	using Clock = std::chrono::steady_clock;
+	const auto ms = [](Clock::duration Time) { return std::chrono::duration<double, std::milli>(Time).count(); };
+
+	C4SaveState State;
+	Clock::time_point Start = Clock::now();
+	if (!State.Capture()) return;
+	const Clock::duration CaptureTime = Clock::now() - Start;
+
+	// text format as written to savegames, without landscape and PXS files
+	Start = Clock::now();
+	StdStrBuf GameText, ObjectsText, InactiveObjectsText;
+	EnumeratePointers();
+	Game.Decompile(GameText, false, true);
+	ObjectsText.Take(DecompileToBuf<StdCompilerINIWrite>(mkParAdapt(Game.Objects, false)));
+	InactiveObjectsText.Take(DecompileToBuf<StdCompilerINIWrite>(mkParAdapt(Game.Objects.InactiveObjects, false)));
+	DenumeratePointers();
+	const Clock::duration TextTime = Clock::now() - Start;
+
+	// reading the objects back, into a list of their own that is never denumerated
+	Start = Clock::now();
+	C4ObjectList TextObjects;
+	bool fTextRead = true;
+	try
+	{
+		CompileFromBuf<StdCompilerINIRead>(mkParAdapt(TextObjects, false), ObjectsText);
+	}
+	catch (const StdCompiler::Exception &e)
+	{
+		LogF("SaveState: reading text failed: %s", e.what());
+		fTextRead = false;
+	}
+	const Clock::duration TextReadTime = Clock::now() - Start;
+	TextObjects.DeleteObjects();
+
+	Start = Clock::now();
+	if (!State.Restore()) return;
+	const Clock::duration RestoreTime = Clock::now() - Start;
+
+	// restoring must not change anything
+	C4SaveState Check;
+	const bool fIdentical = Check.Capture() && Check.Data.getSize() == State.Data.getSize() &&
+		!std::memcmp(Check.Data.getData(), State.Data.getData(), State.Data.getSize());
+
+	LogF("SaveState: Frame %d, %d objects", static_cast<int>(Game.FrameCounter), static_cast<int>(Game.Objects.ObjectCount()));
+	LogF("SaveState:   binary capture %10.3f ms %10zu bytes", ms(CaptureTime), State.GetSize());
+	LogF("SaveState:   binary restore %10.3f ms", ms(RestoreTime));
+	LogF("SaveState:   text write     %10.3f ms %10zu bytes (objects and game data only)", ms(TextTime),
+		static_cast<size_t>(GameText.getLength() + ObjectsText.getLength() + InactiveObjectsText.getLength()));
+	if (fTextRead)
+		LogF("SaveState:   text read      %10.3f ms (objects only, without denumerating)", ms(TextReadTime));
+	LogF("SaveState:   state after restore %s", fIdentical ? "identical" : "DIFFERS");
+}
@@ -0,0 +1,70 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* In-memory binary snapshots of the running round (/quicksave, /quickload) */
+
+#pragma once
+
+#include <StdBuf.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class StdCompiler;
+
+// Holds the complete synchronized game state as written by StdCompilerBinWrite:
+// landscape pixels, PXS, mass movers, objects, effects, script globals and strings.
+// Unlike savegames, definitions, scripts and materials are not stored, so a state
+// can only be restored into the round it was captured in, with the same players.
+// Runtime join data doesn't use it: joining clients start from the text savegame format.
+class C4SaveState
+{
+public:
+	static constexpr uint32_t Magic = 0x53533443; // "C4SS"
+	static constexpr int32_t Version = 1;
+
+	struct Header
+	{
+		uint32_t iMagic{Magic};
+		int32_t iVersion{Version};
+		int32_t iFrame{0};
+		int32_t iLandscapeWdt{0}, iLandscapeHgt{0};
+		std::string Section;
+		std::vector<int32_t> PlayerIDs; // in list order
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+private:
+	StdBuf Data;
+
+public:
+	bool Capture(); // running game only, between frames
+	bool Restore(); // no script callbacks for the replaced objects; the round is left as it was if the state doesn't fit
+
+	size_t GetSize() const { return Data.getSize(); }
+	void CompileFunc(StdCompiler *pComp);
+
+	static void Benchmark(); // compares capture and restore with the text savegame format
+
+private:
+	static Header GetCurrentHeader();
+	static void EnumeratePointers();
+	static void DenumeratePointers();
+	bool Apply(); // compiles the state over the current round
+	static void RemoveObjects();
+	static void PostRestore();
+};
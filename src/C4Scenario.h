@@ -191,6 +191,14 @@ const int32_t C4S_NoGoal      = 0,
 
 const int32_t C4S_MaxMapPlayerExtend = 4;
 
+// Default maximum number of concurrent pixel sprites; the fixed limit of earlier versions
+
+const int32_t C4S_DefaultMaxPXS = 10000;
+
+// Default maximum number of concurrent mass movers; the fixed limit of earlier versions
+
+const int32_t C4S_DefaultMaxMassMovers = 10000;
+
 class C4SPlrStart
 {
 public:
@@ -242,6 +250,8 @@ public:
 	int32_t NewStyleLandscape; // if set to 2, the landscape uses up to 125 mat/texture pairs
 	int32_t FoWRes; // chunk size of FoGOfWar
 	bool ShadeMaterials;
+	int32_t MaxPXS; // maximum number of concurrent pixel sprites
+	int32_t MaxMassMovers; // maximum number of concurrent mass movers
 
 public:
 	void Default();
@@ -132,3 +132,34 @@ void InitFunctionMap(C4AulScriptEngine *pEngine); // add functions to engine
 // an additional callback for Construct.
 #define PSF_ControlCommandAcquire      "~ControlCommandAcquire" // C4Object *pTarget (unused), int iRangeX, int iRangeY, C4Object *pExcludeContainer, C4ID idAcquireDef
 #define PSF_ControlCommandConstruction "~ControlCommandConstruction" // C4Object *pTarget (unused), int iRangeX, int iRangeY, C4Object *pTarget2 (unused), C4ID idConstructDef
+
+// Engine callbacks that are issued often enough to be resolved once per link (see C4DefScriptHost::AfterLink)
+// instead of being looked up by name on every call; see C4Object::Call(C4AulCallback, ...)
+enum class C4AulCallback
+{
+	RejectFight,
+	QueryCatchBlow,
+	CatchBlow,
+	Hit,
+	Hit2,
+	Hit3,
+	Stuck,
+	DeepBreath,
+	Damage,
+	LiftTop,
+	LineBreak,
+	AttachTargetLost,
+	RejectEntrance,
+	RejectCollection,
+	Collection,
+	Collection2,
+	Entrance,
+	Departure,
+	Ejection,
+	ControlUpdate,
+	ContainedControlUpdate,
+	ControlCommand,
+	UpdateTransferZone,
+
+	Num
+};
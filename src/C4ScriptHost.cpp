@@ -169,11 +169,51 @@ const char *C4ScriptHost::GetControlDesc(const char *szFunctionFormat, int32_t i
 
 // C4DefScriptHost
 
+namespace
+{
+	// function names of C4AulCallback, in enum order
+	constexpr auto CallbackNames = std::to_array<const char *>(
+	{
+		PSF_RejectFight,
+		PSF_QueryCatchBlow,
+		PSF_CatchBlow,
+		PSF_Hit,
+		PSF_Hit2,
+		PSF_Hit3,
+		PSF_Stuck,
+		PSF_DeepBreath,
+		PSF_Damage,
+		PSF_LiftTop,
+		PSF_LineBreak,
+		PSF_AttachTargetLost,
+		PSF_RejectEntrance,
+		PSF_RejectCollection,
+		PSF_Collection,
+		PSF_Collection2,
+		PSF_Entrance,
+		PSF_Departure,
+		PSF_Ejection,
+		PSF_ControlUpdate,
+		PSF_ContainedControlUpdate,
+		PSF_ControlCommand,
+		PSF_UpdateTransferZone
+	});
+	static_assert(CallbackNames.size() == static_cast<std::size_t>(C4AulCallback::Num), "CallbackNames must list every C4AulCallback");
+}
+
 void C4DefScriptHost::Default()
 {
 	C4ScriptHost::Default();
 	SFn_CalcValue = SFn_SellTo = SFn_ControlTransfer = SFn_CustomComponents = nullptr;
 	ControlMethod[0] = ControlMethod[1] = ContainedControlMethod[0] = ContainedControlMethod[1] = ActivationControlMethod[0] = ActivationControlMethod[1] = 0;
+	ClearCallbacks();
+}
+
+void C4DefScriptHost::ClearCallbacks()
+{
+	Callbacks.fill(nullptr);
+	ControlCallbacks.fill(nullptr);
+	ContainedControlCallbacks.fill(nullptr);
 }
 
 void C4DefScriptHost::AfterLink()
@@ -198,6 +238,19 @@ void C4DefScriptHost::AfterLink()
 		}
 		Def->TimerCall = GetSFuncWarn(Def->STimerCall, CallAccess, "TimerCall");
 	}
+	// Resolve frequent engine callbacks; the function map is only touched again on the next relink
+	ClearCallbacks();
+	for (std::size_t i = 0; i < CallbackNames.size(); ++i)
+	{
+		Callbacks[i] = GetSFunc(CallbackNames[i]);
+	}
+	for (std::size_t com = 0; com < ControlCallbacks.size(); ++com)
+	{
+		const char *const comName{ComName(static_cast<int32_t>(com))};
+		if (SEqual(comName, "Undefined")) continue;
+		ControlCallbacks[com] = GetSFunc(FormatString(PSF_Control, comName).getData());
+		ContainedControlCallbacks[com] = GetSFunc(FormatString(PSF_ContainedControl, comName).getData());
+	}
 	// Check if there are any Control/Contained/Activation script functions
 	GetControlMethodMask(PSF_Control,                    ControlMethod[0],           ControlMethod[1]);
 	GetControlMethodMask(PSF_ContainedControl,  ContainedControlMethod[0],  ContainedControlMethod[1]);
@@ -21,6 +21,11 @@
 #include <C4ComponentHost.h>
 
 #include <C4Aul.h>
+#include <C4Script.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
 
 // generic script host for objects
 class C4ScriptHost : public C4AulScript, public C4ComponentHost
@@ -71,13 +76,23 @@ public:
 
 protected:
 	void AfterLink() override; // get common funcs
+	void ClearCallbacks();
 
 public:
+	C4AulScriptFunc *GetCallback(C4AulCallback callback) const { return Callbacks[static_cast<std::size_t>(callback)]; }
+	C4AulScriptFunc *GetControlCallback(std::uint8_t com) const { return ControlCallbacks[com]; } // PSF_Control
+	C4AulScriptFunc *GetContainedControlCallback(std::uint8_t com) const { return ContainedControlCallbacks[com]; } // PSF_ContainedControl
+
 	C4AulScriptFunc *SFn_CalcValue; // get object value
 	C4AulScriptFunc *SFn_SellTo; // player par(0) sold the object
 	C4AulScriptFunc *SFn_ControlTransfer; // object par(0) tries to get to par(1)/par(2)
 	C4AulScriptFunc *SFn_CustomComponents; // PSF_GetCustomComponents
 	int32_t ControlMethod[2], ContainedControlMethod[2], ActivationControlMethod[2];
+
+private:
+	// resolved in AfterLink; nullptr if the script doesn't define the function
+	std::array<C4AulScriptFunc *, static_cast<std::size_t>(C4AulCallback::Num)> Callbacks;
+	std::array<C4AulScriptFunc *, 256> ControlCallbacks, ContainedControlCallbacks; // indexed by COM
 };
 
 // script host for scenario scripts
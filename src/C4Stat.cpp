@@ -204,7 +204,7 @@ void C4MainStat::CloseStatFile()
 // ** implemetation of C4Stat
 
 C4Stat::C4Stat(const char *strnName)
-	: strName(strnName)
+	: strName(strnName), ProfilerStat(strnName)
 {
 	Reset();
 	getMainStat()->RegisterStat(this);
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "C4Profiler.h"
 #include "Standard.h"
 
 #include <cassert>
@@ -73,12 +74,14 @@ public:
 		iCount++;
 		iCountPart++;
 		iStartCalled++;
+		ProfilerStat.Start();
 	}
 
 	inline void Stop()
 	{
 		assert(iStartCalled);
 		iStartCalled--;
+		ProfilerStat.Stop();
 		if (!iStartCalled && iCount >= 100)
 		{
 			unsigned int iTime = timeGetTime() - iStartTick;
@@ -122,6 +125,9 @@ protected:
 
 	// name of statistic
 	const char *strName;
+
+	// frame profiler zone
+	C4ProfilerStat ProfilerStat;
 };
 
 // *** some directives
@@ -153,10 +159,11 @@ protected:
 
 #else
 
-#define C4ST_STARTNEW(StatName, strName)
-#define C4ST_NEW(StatName, strName)
-#define C4ST_START(StatName)
-#define C4ST_STOP(StatName)
+// without USE_STAT, the checkpoints are frame profiler zones only
+#define C4ST_STARTNEW(StatName, strName) static C4ProfilerStat StatName(strName); StatName.Start();
+#define C4ST_NEW(StatName, strName) C4ProfilerStat StatName(strName);
+#define C4ST_START(StatName) StatName.Start();
+#define C4ST_STOP(StatName) StatName.Stop();
 #define C4ST_SHOWSTAT
 #define C4ST_SHOWPARTSTAT
 #define C4ST_RESET
@@ -23,6 +23,8 @@
 #include <C4Components.h>
 #include <C4Aul.h>
 
+#include <algorithm>
+
 // *** C4String
 
 C4String::C4String(StdStrBuf &&strString, C4StringTable *pnTable)
@@ -79,12 +81,15 @@ void C4String::Reg(C4StringTable *pnTable)
 	pnTable->Last = this;
 
 	pTable = pnTable;
+	pTable->AddToIndex(this);
 }
 
 void C4String::UnReg()
 {
 	if (!pTable) return;
 
+	pTable->RemoveFromIndex(this);
+
 	if (Next)
 		Next->Prev = Prev;
 	else
@@ -116,19 +121,53 @@ C4StringTable::~C4StringTable()
 
 void C4StringTable::Clear()
 {
-	bool bContinue;
-	do
+	// unreg all hold strings; UnReg only ever deletes the string itself,
+	// so the successor stays valid
+	for (C4String *pAct = First, *pNext; pAct; pAct = pNext)
 	{
-		bContinue = false;
-		// find string to delete / unreg
-		for (C4String *pAct = First; pAct; pAct = pAct->Next)
-			if (pAct->Hold)
-			{
-				pAct->UnReg();
-				bContinue = true;
-				break;
-			}
-	} while (bContinue);
+		pNext = pAct->Next;
+		if (pAct->Hold)
+			pAct->UnReg();
+	}
+}
+
+void C4StringTable::AddToIndex(C4String *pString)
+{
+	// strings are always appended to the list, so this keeps list order
+	// strings without data never compare equal to anything (see SEqual)
+	if (pString->Data.getData()) StringsByContent[pString->Data.getData()].push_back(pString);
+	RegisteredStrings.insert(pString);
+	if (pString->iEnumID > -1) EnumIDsDirty = true;
+}
+
+void C4StringTable::RemoveFromIndex(C4String *pString)
+{
+	if (const char *const data{pString->Data.getData()}; data)
+	{
+		const auto it = StringsByContent.find(std::string_view{data});
+		if (it != StringsByContent.end())
+		{
+			auto &strings = it->second;
+			strings.erase(std::find(strings.begin(), strings.end(), pString));
+			if (strings.empty()) StringsByContent.erase(it);
+		}
+	}
+	RegisteredStrings.erase(pString);
+	if (pString->iEnumID > -1) EnumIDsDirty = true;
+}
+
+void C4StringTable::UpdateEnumIDIndex()
+{
+	if (!EnumIDsDirty) return;
+	StringsByEnumID.clear();
+	for (C4String *pAct = First; pAct; pAct = pAct->Next)
+	{
+		if (pAct->iEnumID < 0) continue;
+		const auto index = static_cast<std::size_t>(pAct->iEnumID);
+		if (index >= StringsByEnumID.size()) StringsByEnumID.resize(index + 1, nullptr);
+		if (!StringsByEnumID[index]) StringsByEnumID[index] = pAct;
+	}
+	EnumIDsDirty = false;
 }
 
 int C4StringTable::EnumStrings()
@@ -153,6 +192,7 @@ int C4StringTable::EnumStrings()
 			pAct->iEnumID = -1;
 		}
 	}
+	EnumIDsDirty = true;
 	return iCurrID;
 }
 
@@ -163,33 +203,33 @@ C4String *C4StringTable::RegString(const char *strString)
 
 C4String *C4StringTable::FindString(const char *strString)
 {
-	for (C4String *pAct = First; pAct; pAct = pAct->Next)
-		if (SEqual(pAct->Data.getData(), strString))
-			return pAct;
-	return nullptr;
+	if (!strString) return nullptr;
+	const auto it = StringsByContent.find(std::string_view{strString});
+	return it != StringsByContent.end() ? it->second.front() : nullptr;
 }
 
 C4String *C4StringTable::FindString(C4String *pString)
 {
-	for (C4String *pAct = First; pAct; pAct = pAct->Next)
-		if (pAct == pString)
-			return pAct;
-	return nullptr;
+	// pString may be any pointer-sized value (see C4Value::GuessType), so it must not be dereferenced
+	return RegisteredStrings.contains(pString) ? pString : nullptr;
 }
 
 C4String *C4StringTable::FindString(int iEnumID)
 {
-	for (C4String *pAct = First; pAct; pAct = pAct->Next)
-		if (pAct->iEnumID == iEnumID)
-			return pAct;
-	return nullptr;
+	if (iEnumID < 0) return nullptr;
+	UpdateEnumIDIndex();
+	return static_cast<std::size_t>(iEnumID) < StringsByEnumID.size() ? StringsByEnumID[iEnumID] : nullptr;
 }
 
 C4String *C4StringTable::FindSaveString(C4String *pString)
 {
-	for (C4String *pAct = First; pAct; pAct = pAct->Next)
+	if (!pString->Data.getData()) return nullptr;
+	const auto it = StringsByContent.find(std::string_view{pString->Data.getData()});
+	if (it == StringsByContent.end()) return nullptr;
+
+	for (C4String *pAct : it->second)
 	{
-		if (SEqual(pAct->Data.getData(), pString->Data.getData()) && (!pAct->Hold || pAct->iRefCnt))
+		if (!pAct->Hold || pAct->iRefCnt)
 		{
 			return pAct;
 		}
@@ -215,6 +255,7 @@ bool C4StringTable::Load(C4Group &ParentGroup)
 			pnString = RegString(strBuf);
 		pnString->iEnumID = i;
 	}
+	EnumIDsDirty = true;
 	// delete data
 	delete[] pData;
 	return true;
@@ -263,3 +304,28 @@ bool C4StringTable::Save(C4Group &ParentGroup)
 	// write in group
 	return !!ParentGroup.Add(C4CFN_Strings, pData, iTableSize - 1, false, true);
 }
+
+void C4StringTable::CompileFunc(StdCompiler *pComp)
+{
+	// saved strings get ascending IDs in list order, see EnumStrings
+	std::vector<std::string> Strings;
+	if (pComp->isDecompiler())
+		for (C4String *pAct = First; pAct; pAct = pAct->Next)
+			if (pAct->iEnumID > -1 && FindSaveString(pAct) == pAct)
+				Strings.emplace_back(pAct->Data.getData());
+	pComp->Value(mkSTLContainerAdapt(Strings));
+	if (pComp->isCompiler())
+	{
+		// previous IDs must not be found anymore
+		for (C4String *pAct = First; pAct; pAct = pAct->Next)
+			pAct->iEnumID = -1;
+		for (size_t i = 0; i < Strings.size(); i++)
+		{
+			C4String *pString;
+			if (!(pString = FindString(Strings[i].c_str())))
+				pString = RegString(Strings[i].c_str());
+			pString->iEnumID = static_cast<int>(i);
+		}
+		EnumIDsDirty = true;
+	}
+}
@@ -20,8 +20,17 @@
 
 #include "StdBuf.h"
 
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 class C4StringTable;
 class C4Group;
+class StdCompiler;
 
 class C4String
 {
@@ -66,6 +75,26 @@ public:
 
 	bool Load(C4Group &ParentGroup);
 	bool Save(C4Group &ParentGroup);
+	void CompileFunc(StdCompiler *pComp); // strings enumerated by EnumStrings; compiling sets their IDs like Load
 
 	C4String *First, *Last; // string list
+
+private:
+	struct StringHash
+	{
+		using is_transparent = void;
+		std::size_t operator()(std::string_view str) const noexcept { return std::hash<std::string_view>{}(str); }
+	};
+
+	// lookup indices, kept in sync by C4String::Reg/UnReg
+	std::unordered_map<std::string, std::vector<C4String *>, StringHash, std::equal_to<>> StringsByContent; // registered strings per content, in list order
+	std::unordered_set<const C4String *> RegisteredStrings;
+	std::vector<C4String *> StringsByEnumID; // first string in list order per enum ID; rebuilt on demand
+	bool EnumIDsDirty{false};
+
+	void AddToIndex(C4String *pString);
+	void RemoveFromIndex(C4String *pString);
+	void UpdateEnumIDIndex();
+
+	friend class C4String;
 };
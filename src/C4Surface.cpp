@@ -409,9 +409,15 @@ bool C4Surface::Read(CStdStream &hGroup, bool fOwnPal)
 }
 
 bool C4Surface::SavePNG(const char *szFilename, bool fSaveAlpha, bool fApplyGamma, bool fSaveOverlayOnly, float scale)
+{
+	const auto bmp = GetBitmap(fSaveAlpha, fApplyGamma, fSaveOverlayOnly, scale);
+	return bmp && SavePNG(*bmp, szFilename);
+}
+
+std::unique_ptr<StdBitmap> C4Surface::GetBitmap(bool fSaveAlpha, bool fApplyGamma, bool fSaveOverlayOnly, float scale)
 {
 	// Lock - WARNING - maybe locking primary surface here...
-	if (!Lock()) return false;
+	if (!Lock()) return nullptr;
 
 	if (lpDDraw->Gamma.GetSize() == 0)
 		fApplyGamma = false;
@@ -420,7 +426,7 @@ bool C4Surface::SavePNG(const char *szFilename, bool fSaveAlpha, bool fApplyGamm
 	int realHgt = static_cast<int32_t>(ceilf(Hgt * scale));
 
 	// Create bitmap
-	StdBitmap bmp(realWdt, realHgt, fSaveAlpha);
+	auto bmp = std::make_unique<StdBitmap>(realWdt, realHgt, fSaveAlpha);
 
 	// reset overlay if desired
 	C4Surface *pMainSfcBackup;
@@ -431,7 +437,7 @@ bool C4Surface::SavePNG(const char *szFilename, bool fSaveAlpha, bool fApplyGamm
 	{
 		// Take shortcut. FIXME: Check Endian
 		for (int y = 0; y < realHgt; ++y)
-			glReadPixels(0, realHgt - y, realWdt, 1, fSaveAlpha ? GL_BGRA : GL_BGR, GL_UNSIGNED_BYTE, bmp.GetPixelAddr(0, y));
+			glReadPixels(0, realHgt - y, realWdt, 1, fSaveAlpha ? GL_BGRA : GL_BGR, GL_UNSIGNED_BYTE, bmp->GetPixelAddr(0, y));
 	}
 	else
 #endif
@@ -442,7 +448,7 @@ bool C4Surface::SavePNG(const char *szFilename, bool fSaveAlpha, bool fApplyGamm
 			{
 				uint32_t dwClr = GetPixDw(x, y, false, scale);
 				if (fApplyGamma) dwClr = lpDDraw->Gamma.ApplyTo(dwClr);
-				bmp.SetPixel(x, y, dwClr);
+				bmp->SetPixel(x, y, dwClr);
 			}
 	}
 
@@ -452,10 +458,15 @@ bool C4Surface::SavePNG(const char *szFilename, bool fSaveAlpha, bool fApplyGamm
 	// Unlock
 	Unlock();
 
+	return bmp;
+}
+
+bool C4Surface::SavePNG(const StdBitmap &bmp, const char *szFilename)
+{
 	// Save bitmap to PNG file
 	try
 	{
-		CPNGFile(szFilename, realWdt, realHgt, fSaveAlpha).Encode(bmp.GetBytes());
+		CPNGFile(szFilename, bmp.GetWidth(), bmp.GetHeight(), bmp.UsesAlpha()).Encode(bmp.GetBytes());
 	}
 	catch (const std::runtime_error &)
 	{
@@ -898,11 +909,12 @@ bool C4Surface::Load(C4Group &hGroup, const char *szFilename, bool fOwnPal, bool
 	}
 	// determine file type by file extension and load accordingly
 	bool fSuccess;
+	C4GroupMappedBuf FileData;
 	if (SEqualNoCase(GetExtension(szFilename), "png"))
-		fSuccess = !!ReadPNG(hGroup);
+		fSuccess = hGroup.LoadEntryMapped(szFilename, FileData) && ReadPNG(FileData.getData(), FileData.getSize());
 	else if (SEqualNoCase(GetExtension(szFilename), "jpeg")
 		|| SEqualNoCase(GetExtension(szFilename), "jpg"))
-		fSuccess = ReadJPEG(hGroup);
+		fSuccess = hGroup.LoadEntryMapped(szFilename, FileData) && ReadJPEG(FileData.getData(), FileData.getSize());
 	else
 		fSuccess = !!Read(hGroup, fOwnPal);
 	// loading error? log!
@@ -919,12 +931,17 @@ bool C4Surface::ReadPNG(CStdStream &hGroup)
 	std::unique_ptr<uint8_t[]> pData(new uint8_t[iSize]);
 	// load file into mem
 	hGroup.Read(pData.get(), iSize);
+	return ReadPNG(pData.get(), iSize);
+}
+
+bool C4Surface::ReadPNG(const void *pFileData, size_t iFileSize)
+{
 	// load as png file
 	std::unique_ptr<StdBitmap> bmp;
 	std::uint32_t width, height; bool useAlpha;
 	try
 	{
-		CPNGFile png(pData.get(), iSize);
+		CPNGFile png(pFileData, iFileSize);
 		width = png.Width(); height = png.Height(), useAlpha = png.UsesAlpha();
 		bmp.reset(new StdBitmap(width, height, useAlpha));
 		png.Decode(bmp->GetBytes());
@@ -934,8 +951,6 @@ bool C4Surface::ReadPNG(CStdStream &hGroup)
 		LogF("Could not create surface from PNG file: %s", e.what());
 		bmp.reset();
 	}
-	// free file data
-	pData.reset();
 	// abort if loading wasn't successful
 	if (!bmp) return false;
 	// create surface(s) - do not create an 8bit-buffer!
@@ -1030,14 +1045,18 @@ bool C4Surface::ReadJPEG(CStdStream &hGroup)
 {
 	// create mem block
 	size_t size = hGroup.AccessedEntrySize();
-	unsigned char *pData = new unsigned char[size];
+	std::unique_ptr<unsigned char[]> pData(new unsigned char[size]);
 	// load file into mem
-	hGroup.Read(pData, size);
+	hGroup.Read(pData.get(), size);
+	return ReadJPEG(pData.get(), size);
+}
 
+bool C4Surface::ReadJPEG(const void *pFileData, size_t iFileSize)
+{
 	bool locked = false;
 	try
 	{
-		StdJpeg jpeg(pData, size);
+		StdJpeg jpeg(pFileData, iFileSize);
 		const std::uint32_t width = jpeg.Width(), height = jpeg.Height();
 
 		// create surface(s) - do not create an 8bit-buffer!
@@ -1066,8 +1085,6 @@ bool C4Surface::ReadJPEG(CStdStream &hGroup)
 
 	// unlock
 	if (locked) Unlock();
-	// free data
-	delete[] pData;
 	// return if successful
 	return true;
 }
@@ -27,6 +27,7 @@
 #endif
 
 #include <list>
+#include <memory>
 
 // config settings
 #define C4GFXCFG_NO_ALPHA_ADD    1
@@ -65,6 +66,7 @@ extern CStdDDraw *lpDDraw;
 
 class C4Group;
 class C4GroupSet;
+class StdBitmap;
 
 class C4Surface
 {
@@ -105,6 +107,8 @@ public:
 	void NoClip();
 	bool Read(class CStdStream &hGroup, bool fOwnPal = false);
 	bool SavePNG(const char *szFilename, bool fSaveAlpha, bool fApplyGamma, bool fSaveOverlayOnly, float scale = 1.0f);
+	std::unique_ptr<StdBitmap> GetBitmap(bool fSaveAlpha, bool fApplyGamma, bool fSaveOverlayOnly, float scale = 1.0f); // copy contents, e.g. to encode them later
+	static bool SavePNG(const StdBitmap &bmp, const char *szFilename); // may be called by any thread
 	bool Wipe(); // empty to transparent
 	bool GetSurfaceSize(int &irX, int &irY); // get surface size
 	void SetClr(uint32_t toClr) { ClrByOwnerClr = toClr ? toClr : 0xff; }
@@ -117,7 +121,9 @@ public:
 	bool SavePNG(C4Group &hGroup, const char *szFilename, bool fSaveAlpha = true, bool fApplyGamma = false, bool fSaveOverlayOnly = false);
 	bool Copy(C4Surface &fromSfc);
 	bool ReadPNG(CStdStream &hGroup);
+	bool ReadPNG(const void *pFileData, size_t iFileSize);
 	bool ReadJPEG(CStdStream &hGroup);
+	bool ReadJPEG(const void *pFileData, size_t iFileSize);
 
 private:
 	bool CreateTextures(); // create ppTex-array
@@ -0,0 +1,36 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Hashing of synchronized game state for sync checks */
+
+#pragma once
+
+#include <cstdint>
+
+// scrambles a value into a well distributed hash
+// XOR-ing these gives an order-independent hash that can be updated incrementally
+constexpr std::uint32_t SyncHash(std::uint64_t value)
+{
+	value ^= value >> 30; value *= 0xbf58476d1ce4e5b9u;
+	value ^= value >> 27; value *= 0x94d049bb133111ebu;
+	value ^= value >> 31;
+	return static_cast<std::uint32_t>(value);
+}
+
+// adds a value to a hash in an order-dependent way
+constexpr std::uint32_t SyncHashAdd(std::uint32_t hash, std::int64_t value)
+{
+	return SyncHash((static_cast<std::uint64_t>(hash) << 32) ^ static_cast<std::uint64_t>(value));
+}
@@ -14,6 +14,7 @@
  */
 
 #include "C4Thread.h"
+#include "C4Profiler.h"
 
 #ifdef _WIN32
 #include "C4Windows.h"
@@ -26,6 +27,8 @@
 
 void C4Thread::SetCurrentThreadName(const std::string_view name)
 {
+	C4Profiler::SetCurrentThreadName(name);
+
 #ifdef _WIN32
 	static auto *const setThreadDescription = reinterpret_cast<HRESULT(__stdcall *)(HANDLE, PCWSTR)>(GetProcAddress(GetModuleHandle("KernelBase.dll"), "SetThreadDescription"));
 
@@ -182,14 +182,14 @@ public:
 	void SaveEntryCore(C4Group &rByGrp, const char *szEntry)
 	{
 		C4GroupEntryCore *pCore = (static_cast<C4GroupEx &>(rByGrp)).GetEntry(szEntry);
-		// copy core
-		memcpy(&SavedCore.Time, &pCore->Time, reinterpret_cast<char *>(&SavedCore) + sizeof(SavedCore) - reinterpret_cast<char *>(&SavedCore.Time));
+		// copy core (not the data location and format fields, they belong to the group's own data)
+		memcpy(&SavedCore.Time, &pCore->Time, reinterpret_cast<char *>(&SavedCore.Compression) - reinterpret_cast<char *>(&SavedCore.Time));
 	}
 	void SetSavedEntryCore(const char *szEntry)
 	{
 		C4GroupEntryCore *pCore = GetEntry(szEntry);
-		// copy core
-		memcpy(&pCore->Time, &SavedCore.Time, reinterpret_cast<char *>(&SavedCore) + sizeof(SavedCore) - reinterpret_cast<char *>(&SavedCore.Time));
+		// copy core (not the data location and format fields, they belong to the group's own data)
+		memcpy(&pCore->Time, &SavedCore.Time, reinterpret_cast<char *>(&SavedCore.Compression) - reinterpret_cast<char *>(&SavedCore.Time));
 	}
 
 	void SetEntryTime(const char *szEntry, int iEntryTime)
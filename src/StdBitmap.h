@@ -25,6 +25,10 @@ public:
 	// Creates a B8G8R8 bitmap if useAlpha is false or an B8G8R8A8 bitmap otherwise.
 	StdBitmap(std::uint32_t width, std::uint32_t height, bool useAlpha);
 
+	std::uint32_t GetWidth() const { return width; }
+	std::uint32_t GetHeight() const { return height; }
+	bool UsesAlpha() const { return useAlpha; }
+
 	// Returns a pointer to the bitmap bytes.
 	const void *GetBytes() const;
 	void *GetBytes();
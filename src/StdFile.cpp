@@ -28,6 +28,7 @@
 #endif
 #ifndef _WIN32
 #include <unistd.h>
+#include <sys/mman.h>
 #endif
 #include <errno.h>
 #include <stdlib.h>
@@ -883,6 +884,72 @@ int ForEachFile(const char *szDirName, bool(*fnCallback)(const char *))
 	return iFileCount;
 }
 
+// File Mappings
+
+bool StdFileMapping::Open(const char *szFilename)
+{
+	FILE *hFile = fopen(szFilename, "rb");
+	if (!hFile) return false;
+	const bool fSuccess = Open(hFile);
+	fclose(hFile);
+	return fSuccess;
+}
+
+bool StdFileMapping::Open(FILE *hFile)
+{
+	Close();
+#ifdef _WIN32
+	const HANDLE hOSFile = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(hFile)));
+	LARGE_INTEGER liSize;
+	if (hOSFile == INVALID_HANDLE_VALUE || !GetFileSizeEx(hOSFile, &liSize)) return false;
+	// empty files cannot be mapped
+	if (!liSize.QuadPart || static_cast<unsigned long long>(liSize.QuadPart) > SIZE_MAX) return false;
+	if (!(hMapping = CreateFileMapping(hOSFile, nullptr, PAGE_READONLY, 0, 0, nullptr))) return false;
+	if (!(pData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0)))
+	{
+		Close();
+		return false;
+	}
+	iSize = static_cast<size_t>(liSize.QuadPart);
+#else
+	struct stat stStats;
+	const int fd = fileno(hFile);
+	if (fd < 0 || fstat(fd, &stStats) != 0 || !S_ISREG(stStats.st_mode)) return false;
+	// empty files cannot be mapped
+	if (stStats.st_size <= 0) return false;
+	void *pMap = mmap(nullptr, static_cast<size_t>(stStats.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	if (pMap == MAP_FAILED) return false;
+	pData = pMap; iSize = static_cast<size_t>(stStats.st_size);
+#endif
+	return true;
+}
+
+void StdFileMapping::Close()
+{
+#ifdef _WIN32
+	if (pData) UnmapViewOfFile(pData);
+	if (hMapping) CloseHandle(hMapping);
+	hMapping = nullptr;
+#else
+	if (pData) munmap(const_cast<void *>(pData), iSize);
+#endif
+	pData = nullptr; iSize = 0;
+}
+
+bool StdFileMapping::IsZeroAt(size_t iPos) const
+{
+	if (!pData) return false;
+	if (iPos < iSize) return !static_cast<const char *>(pData)[iPos];
+#ifdef _WIN32
+	SYSTEM_INFO SysInfo; GetSystemInfo(&SysInfo);
+	const size_t iPageSize = SysInfo.dwPageSize;
+#else
+	const size_t iPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+	// the rest of the last page is zero-filled
+	return iPos < (iSize + iPageSize - 1) / iPageSize * iPageSize;
+}
+
 // Text Files
 
 bool ReadFileLine(FILE *fhnd, char *tobuf, int maxlen)
@@ -124,5 +124,31 @@ protected:
 #endif
 };
 
+// Read-only memory mapping of a whole file
+class StdFileMapping
+{
+public:
+	StdFileMapping() = default;
+	~StdFileMapping() { Close(); }
+	StdFileMapping(const StdFileMapping &) = delete;
+	StdFileMapping &operator=(const StdFileMapping &) = delete;
+
+	bool Open(const char *szFilename);
+	bool Open(FILE *hFile); // the mapping stays valid after the file is closed
+	void Close();
+
+	const void *getData() const { return pData; }
+	size_t getSize() const { return iSize; }
+	// whether a zero byte can be read at iPos: either file content or the zero fill of the last page
+	bool IsZeroAt(size_t iPos) const;
+
+protected:
+	const void *pData{};
+	size_t iSize{};
+#ifdef _WIN32
+	void *hMapping{};
+#endif
+};
+
 bool ReadFileLine(FILE *fhnd, char *tobuf, int maxlen);
 void AdvanceFileLine(FILE *fhnd);
@@ -37,6 +37,13 @@
 #include <unistd.h>
 #endif
 
+#ifdef USE_EPOLL
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <sys/epoll.h>
+#endif
+
 // *** StdSchedulerProc
 
 #ifndef _WIN32
@@ -51,6 +58,23 @@ static bool FD_INTERSECTS(int n, fd_set *a, fd_set *b)
 
 // *** StdScheduler
 
+#ifdef USE_EPOLL
+
+StdScheduler::StdScheduler()
+	: epollFD{epoll_create1(EPOLL_CLOEXEC)}
+{
+	// without epoll, all procs simply fall back to GetFDs
+	if (epollFD < 0)
+		printf("StdScheduler: epoll_create1 failed %s\n", strerror(errno));
+}
+
+StdScheduler::~StdScheduler()
+{
+	if (epollFD >= 0) close(epollFD);
+}
+
+#endif
+
 std::size_t StdScheduler::getProcCnt() const
 {
 	UnBlock();
@@ -60,6 +84,13 @@ std::size_t StdScheduler::getProcCnt() const
 
 void StdScheduler::Clear()
 {
+#ifdef USE_EPOLL
+	for (auto *const proc : epollProcs)
+	{
+		epoll_ctl(epollFD, EPOLL_CTL_DEL, proc->GetFD(), nullptr);
+	}
+	epollProcs.clear();
+#endif
 	procs.clear();
 #ifdef _WIN32
 	eventHandles.clear();
@@ -72,6 +103,20 @@ void StdScheduler::Add(StdSchedulerProc *const proc)
 	UnBlock();
 	const std::lock_guard lock{procMutex};
 	procs.insert(proc);
+
+#ifdef USE_EPOLL
+	// register descriptor once; procs that can't be registered are handled through GetFDs
+	if (const int fd{proc->GetFD()}; epollFD >= 0 && fd >= 0 && !epollProcs.count(proc))
+	{
+		epoll_event event{};
+		event.events = EPOLLIN | EPOLLET;
+		event.data.ptr = proc;
+		if (epoll_ctl(epollFD, EPOLL_CTL_ADD, fd, &event) == 0)
+		{
+			epollProcs.insert(proc);
+		}
+	}
+#endif
 }
 
 void StdScheduler::Remove(StdSchedulerProc *const proc)
@@ -79,6 +124,13 @@ void StdScheduler::Remove(StdSchedulerProc *const proc)
 	UnBlock();
 	const std::lock_guard lock{procMutex};
 	procs.erase(proc);
+
+#ifdef USE_EPOLL
+	if (epollProcs.erase(proc))
+	{
+		epoll_ctl(epollFD, EPOLL_CTL_DEL, proc->GetFD(), nullptr);
+	}
+#endif
 }
 
 bool StdScheduler::Execute(int iTimeout)
@@ -150,9 +202,21 @@ bool StdScheduler::Execute(int iTimeout)
 	// Add Unblocker
 	FD_SET(unblockerFD, &fds[0]);
 
+#ifdef USE_EPOLL
+	// Add epoll instance
+	if (epollFD >= 0)
+	{
+		FD_SET(epollFD, &fds[0]);
+		maxFDs = std::max(maxFDs, epollFD);
+	}
+#endif
+
 	// Collect file descriptors
 	for (auto *const proc : procs)
 	{
+#ifdef USE_EPOLL
+		if (epollProcs.count(proc)) continue;
+#endif
 		proc->GetFDs(fds, &maxFDs);
 	}
 
@@ -164,6 +228,11 @@ bool StdScheduler::Execute(int iTimeout)
 
 	bool success{true};
 
+#ifdef USE_EPOLL
+	// procs executed for epoll events in this pass
+	std::vector<StdSchedulerProc *> epollExecuted;
+#endif
+
 	if (cnt > 0)
 	{
 		// Unblocker? Flush
@@ -172,10 +241,39 @@ bool StdScheduler::Execute(int iTimeout)
 			unblocker.Reset();
 		}
 
+#ifdef USE_EPOLL
+		// Execute procs with pending events
+		if (epollFD >= 0 && FD_ISSET(epollFD, &fds[0]))
+		{
+			std::array<epoll_event, 32> events;
+			int eventCount;
+			do
+			{
+				eventCount = epoll_wait(epollFD, events.data(), static_cast<int>(events.size()), 0);
+				for (int i{0}; i < eventCount; ++i)
+				{
+					// the proc may have been removed by the execution of an earlier one
+					auto *const proc = static_cast<StdSchedulerProc *>(events[i].data.ptr);
+					if (!epollProcs.count(proc)) continue;
+					epollExecuted.emplace_back(proc);
+					if (!proc->Execute(0))
+					{
+						OnError(proc);
+						success = false;
+					}
+				}
+			}
+			while (eventCount == static_cast<int>(events.size()));
+		}
+#endif
+
 		// Which process?
 		fd_set test_fds[2];
 		for (auto *const proc : procs)
 		{
+#ifdef USE_EPOLL
+			if (epollProcs.count(proc)) continue;
+#endif
 			// Get FDs for this process alone
 			int test_iMaxFDs = 0;
 			FD_ZERO(&test_fds[0]); FD_ZERO(&test_fds[1]);
@@ -202,6 +300,10 @@ bool StdScheduler::Execute(int iTimeout)
 
 	for (auto *const proc : procs)
 	{
+#ifdef USE_EPOLL
+		// already executed for its events
+		if (std::find(epollExecuted.begin(), epollExecuted.end(), proc) != epollExecuted.end()) continue;
+#endif
 		if (proc->GetTimeout() == 0)
 		{
 			if (!proc->Execute())
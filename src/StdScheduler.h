@@ -26,6 +26,11 @@
 	#include <sys/select.h>
 #endif
 
+// Linux: procs that provide a single pollable descriptor are registered with epoll
+#ifdef __linux__
+	#define USE_EPOLL
+#endif
+
 #include <thread>
 #include <unordered_set>
 
@@ -52,6 +57,14 @@ public:
 	virtual void GetFDs(fd_set *pFDs, int *pMaxFD) {}
 #endif
 
+#ifdef USE_EPOLL
+	// Single descriptor that signals pending work (for example an epoll instance owned by the process).
+	// It is registered edge-triggered once when the process is added, so it must stay the same
+	// while the process is scheduled, and Execute() has to handle everything that is pending.
+	// Processes returning -1 are polled through GetFDs() on every pass instead.
+	virtual int GetFD() { return -1; }
+#endif
+
 	// Call Execute() after this time has elapsed (no garantuees regarding accuracy)
 	// -1 means no timeout (infinity).
 	virtual int GetTimeout() { return -1; }
@@ -61,8 +74,13 @@ public:
 class StdScheduler
 {
 public:
+#ifdef USE_EPOLL
+	StdScheduler();
+	virtual ~StdScheduler();
+#else
 	StdScheduler() = default;
 	virtual ~StdScheduler() = default;
+#endif
 
 private:
 	// Process list
@@ -77,6 +95,12 @@ private:
 	std::vector<StdSchedulerProc *> eventProcs;
 #endif
 
+#ifdef USE_EPOLL
+	// epoll instance holding the descriptors of all procs providing GetFD()
+	int epollFD{-1};
+	std::unordered_set<StdSchedulerProc *> epollProcs;
+#endif
+
 	mutable std::mutex procMutex;
 
 public:
@@ -25,6 +25,8 @@
 #include <CStdFile.h>
 #include <Bitmap256.h>
 
+#include <algorithm>
+#include <cstring>
 #include <utility>
 
 #include "limits.h"
@@ -83,7 +85,11 @@ void CSurface8::Clip(int iX, int iY, int iX2, int iY2)
 
 void CSurface8::HLine(int iX, int iX2, int iY, int iCol)
 {
-	for (int cx = iX; cx <= iX2; cx++) SetPix(cx, iY, iCol);
+	// clip once, then fill the span at once
+	if (iY < ClipY || iY > ClipY2 || !Bits) return;
+	iX = std::max(iX, ClipX); iX2 = std::min(iX2, ClipX2);
+	if (iX > iX2) return;
+	std::memset(Bits + iY * Pitch + iX, iCol, iX2 - iX + 1);
 }
 
 bool CSurface8::Create(int iWdt, int iHgt, bool fOwnPal)
@@ -298,12 +304,13 @@ static CPolyEdge *remove_edge(CPolyEdge *list, CPolyEdge *edge)
 	else return edge->next;
 }
 
-// Global polygon quick buffer
+// Polygon quick buffer size
 const int QuickPolyBufSize = 20;
-CPolyEdge QuickPolyBuf[QuickPolyBufSize];
 
 void CSurface8::Polygon(int iNum, int *ipVtx, int iCol)
 {
+	// on the stack, so polygons can be drawn on multiple threads
+	CPolyEdge QuickPolyBuf[QuickPolyBufSize];
 	// Variables for polygon drawer
 	int c, x1, x2, y;
 	int top = INT_MAX;
@@ -367,7 +374,7 @@ void CSurface8::Polygon(int iNum, int *ipVtx, int iCol)
 			// Fix coordinates
 			if (x1 > x2) std::swap(x1, x2);
 			// Set line
-			for (int xcnt = x2 - x1; xcnt >= 0; xcnt--) SetPix(x1 + xcnt, y, iCol);
+			HLine(x1, x2, y, iCol);
 			edge = edge->next->next;
 		}
 
@@ -458,6 +458,12 @@ int main(int argc, char *argv[])
 			case 'p': fPromptAtEnd = true; break;
 			// Execute at end
 			case 'x': SCopy(argv[i] + 3, strExecuteAtEnd, _MAX_PATH); break;
+			// Write indexed groups
+			case 'c':
+				if (SEqual(argv[i] + 2, ":none")) C4Group_SetIndexedCompression(C4GECM_Stored);
+				else if (SEqual(argv[i] + 2, ":zstd")) C4Group_SetIndexedCompression(C4GECM_Zstd);
+				else C4Group_SetIndexedCompression(C4GECM_Deflate);
+				break;
 			// Unknown
 			default: printf("Unknown option %s\n", argv[i]); break;
 			}
@@ -534,6 +540,7 @@ int main(int argc, char *argv[])
 		printf("Options:  /q Quiet /r Recursive /p Prompt at end\n");
 		printf("          /i Register shell /u Unregister shell\n");
 		printf("          /x:<command> Execute shell command when done\n");
+		printf("          /c[:none|:zstd] Write indexed groups (random access)\n");
 		printf("\n");
 		printf("Examples: c4group pack.c4g -a myfile.dat -v *.dat\n");
 		printf("          c4group pack.c4g -as myfile.dat myfile.bin\n");
@@ -0,0 +1,112 @@
+// Loopback throughput benchmark for C4NetIOSimpleUDP
+// Usage: TstC4NetIOUDPThroughput [--size=bytes] [--batch=packets] [--seconds=n] [--gso]
+// --batch=1 sends every packet on its own, like the engine did before batched sending.
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <C4NetIO.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+bool Log(char const *text) { std::cout << text << std::endl; return true; }
+
+class CountingCallback : public C4NetIO::CBClass
+{
+public:
+	std::atomic<unsigned long> iPackets{0};
+
+	virtual void OnPacket(const C4NetIOPacket &rPacket, C4NetIO *pNetIO) override
+	{
+		iPackets.fetch_add(1, std::memory_order_relaxed);
+	}
+};
+
+static int GetArg(const std::string &arg, const char *szName, int iDefault)
+{
+	return arg.rfind(szName, 0) == 0 ? std::atoi(arg.c_str() + std::strlen(szName)) : iDefault;
+}
+
+int main(int argc, char *argv[])
+{
+	int iSize = 1024, iBatch = 64, iSeconds = 3;
+	bool fGSO = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string arg{argv[i]};
+		iSize = GetArg(arg, "--size=", iSize);
+		iBatch = GetArg(arg, "--batch=", iBatch);
+		iSeconds = GetArg(arg, "--seconds=", iSeconds);
+		if (arg == "--gso") fGSO = true;
+	}
+	if (iSize < 1 || iBatch < 1 || iSeconds < 1)
+	{
+		std::cout << "Usage: " << argv[0] << " [--size=bytes] [--batch=packets] [--seconds=n] [--gso]" << std::endl;
+		return 1;
+	}
+
+	constexpr std::uint16_t iPort{11113};
+	C4NetIOSimpleUDP Receiver, Sender;
+	CountingCallback Callback;
+	Receiver.SetCallback(&Callback);
+	Sender.SetCallback(&Callback);
+	Sender.SetSegmentationOffload(fGSO);
+	if (!Receiver.Init(iPort) || !Sender.Init())
+	{
+		std::cout << "Init failed: " << (Receiver.GetError() ? Receiver.GetError() : Sender.GetError()) << std::endl;
+		return 1;
+	}
+
+	std::atomic<bool> fStop{false};
+	std::thread ReceiveThread{[&]
+	{
+		while (!fStop.load(std::memory_order_relaxed))
+			if (!Receiver.Execute(100))
+				std::cout << "receive error: " << Receiver.GetError() << std::endl;
+	}};
+
+	std::vector<char> Data(iSize, 'A');
+	std::vector<C4NetIOPacket> Batch;
+	for (int i = 0; i < iBatch; ++i)
+		Batch.emplace_back(Data.data(), Data.size(), false, C4NetIO::addr_t{C4NetIO::HostAddress::Loopback, iPort});
+
+	unsigned long iSent{0};
+	const std::clock_t CPUStart{std::clock()};
+	const auto Start = std::chrono::steady_clock::now();
+	const auto End = Start + std::chrono::seconds{iSeconds};
+	while (std::chrono::steady_clock::now() < End)
+	{
+		if (!(iBatch == 1 ? Sender.Send(Batch.front()) : Sender.SendBatch(Batch)))
+		{
+			std::cout << "send error: " << Sender.GetError() << std::endl;
+			break;
+		}
+		iSent += iBatch;
+	}
+	const double dTime{std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count()};
+
+	// give the receiver a moment to drain the socket
+	std::this_thread::sleep_for(std::chrono::milliseconds{200});
+	fStop = true;
+	Receiver.UnBlock();
+	ReceiveThread.join();
+	const double dCPUTime{static_cast<double>(std::clock() - CPUStart) / CLOCKS_PER_SEC};
+
+	const unsigned long iReceived{Callback.iPackets.load()};
+	std::cout << iSent << " packets of " << iSize << " bytes sent, " << iReceived << " received in " << dTime << " s" << std::endl;
+	std::cout << static_cast<unsigned long>(iSent / dTime) << " packets/s sent, " << static_cast<unsigned long>(iReceived / dTime) << " packets/s received" << std::endl;
+	std::cout << (iSent + iReceived ? dCPUTime * 1e9 / (iSent + iReceived) : 0) << " ns CPU per packet sent or received" << std::endl;
+
+	Sender.Close();
+	Receiver.Close();
+	return 0;
+}